@@ -1443,7 +1443,7 @@ def _run():
         "--debug-opts",
         nargs="+",
         default=[],
-        choices=("gl", "vk", "mem", "scene", "gpu_capture"),
+        choices=("gl", "vk", "mem", "mem_prof", "scene", "gpu_capture"),
         help="Debug options",
     )
     parser.add_argument("--build-backend", choices=("ninja", "vs"), default="ninja", help="Build backend to use")
@@ -211,6 +211,7 @@ cmds = [
     "glFenceSync",
     "glWaitSync",
     "glClientWaitSync",
+    "glDeleteSync",
     # Read/Draw Buffer
     "glReadBuffer",
     "glDrawBuffers",
@@ -95,6 +95,26 @@ void ngl_log_set_min_level(int level)
     ngli_log_set_min_level(level);
 }
 
+int ngl_log_set_async(int async)
+{
+    return ngli_log_set_async(async);
+}
+
+uint64_t ngl_log_get_nb_dropped(void)
+{
+    return ngli_log_get_nb_dropped();
+}
+
+int ngl_mem_prof_get_sites(void *arg, ngl_mem_prof_callback_type callback)
+{
+#if DEBUG_MEM_PROF
+    return ngli_mem_prof_get_sites(arg, callback);
+#else
+    LOG(ERROR, "the memory profiler requires the mem_prof debug option");
+    return NGL_ERROR_UNSUPPORTED;
+#endif
+}
+
 static int get_default_platform(void)
 {
 #if defined(TARGET_LINUX)
@@ -259,6 +279,7 @@ int ngli_ctx_set_scene(struct ngl_ctx *s, struct ngl_scene *scene)
 
     ngli_gpu_ctx_wait_idle(s->gpu_ctx);
     reset_scene(s, NGLI_ACTION_UNREF_SCENE);
+    ngli_mem_prof_reset_frames();
 
     ngli_rnode_init(&s->rnode);
     s->rnode_pos = &s->rnode;
@@ -325,9 +346,14 @@ void ngli_ctx_reset(struct ngl_ctx *s, int action)
 #endif
     ngli_hmap_freep(&s->text_builtin_atlasses);
 #if HAVE_TEXT_LIBRARIES
+    /* The faces reference the font files */
+    ngli_hmap_freep(&s->text_font_faces);
+    ngli_hmap_freep(&s->text_font_files);
     FT_Done_FreeType(s->ft_library);
 #endif
     ngli_pgcache_reset(&s->pgcache);
+    ngli_rtt_pool_reset(s);
+    ngli_copy_pool_freep(&s->copy_pool);
     ngli_gpu_ctx_freep(&s->gpu_ctx);
     ngli_config_reset(&s->config);
     backend_reset(&s->backend);
@@ -454,9 +480,15 @@ int ngli_ctx_set_capture_buffer(struct ngl_ctx *s, void *capture_buffer)
     return 0;
 }
 
+static int measure_timings(const struct ngl_ctx *s)
+{
+    return s->hud || s->config.stats;
+}
+
 int ngli_ctx_prepare_draw(struct ngl_ctx *s, double t)
 {
-    const int64_t start_time = s->hud ? ngli_gettime_relative() : 0;
+    const int measure = measure_timings(s);
+    const int64_t start_time = measure ? ngli_gettime_relative() : 0;
 
     int ret = ngli_gpu_ctx_begin_update(s->gpu_ctx, t);
     if (ret < 0)
@@ -470,11 +502,16 @@ int ngli_ctx_prepare_draw(struct ngl_ctx *s, double t)
     struct ngl_node *root = scene->params.root;
     LOG(DEBUG, "prepare scene %s @ t=%f", root->label, t);
 
+    ngli_mem_prof_set_phase(NGLI_MEM_PHASE_PREPARE);
+    s->nb_prefetches = 0;
     ret = ngli_node_honor_release_prefetch(root, t);
+    ngli_mem_prof_set_phase(NGLI_MEM_PHASE_NONE);
     if (ret < 0)
         return ret;
 
+    ngli_mem_prof_set_phase(NGLI_MEM_PHASE_UPDATE);
     ret = ngli_node_update(root, t);
+    ngli_mem_prof_set_phase(NGLI_MEM_PHASE_NONE);
     if (ret < 0)
         return ret;
 
@@ -482,7 +519,7 @@ int ngli_ctx_prepare_draw(struct ngl_ctx *s, double t)
     if (ret < 0)
         return ret;
 
-    s->cpu_update_time = s->hud ? ngli_gettime_relative() - start_time : 0;
+    s->cpu_update_time = measure ? ngli_gettime_relative() - start_time : 0;
 
     return 0;
 }
@@ -497,7 +534,8 @@ int ngli_ctx_draw(struct ngl_ctx *s, double t)
     if (ret < 0)
         return ret;
 
-    const int64_t cpu_start_time = s->hud ? ngli_gettime_relative() : 0;
+    const int measure = measure_timings(s);
+    const int64_t cpu_start_time = measure ? ngli_gettime_relative() : 0;
 
     struct rendertarget *rt = ngli_gpu_ctx_get_default_rendertarget(s->gpu_ctx, NGLI_LOAD_OP_CLEAR);
     struct rendertarget *rt_resume = ngli_gpu_ctx_get_default_rendertarget(s->gpu_ctx, NGLI_LOAD_OP_LOAD);
@@ -505,11 +543,14 @@ int ngli_ctx_draw(struct ngl_ctx *s, double t)
     s->available_rendertargets[1] = rt_resume;
     s->current_rendertarget = rt;
     s->render_pass_started = 0;
+    s->draw_ret = 0;
 
     struct ngl_scene *scene = s->scene;
     if (scene) {
         LOG(DEBUG, "draw scene %s @ t=%f", scene->params.root->label, t);
+        ngli_mem_prof_set_phase(NGLI_MEM_PHASE_DRAW);
         ngli_node_draw(scene->params.root);
+        ngli_mem_prof_set_phase(NGLI_MEM_PHASE_NONE);
     }
 
     if (!s->render_pass_started) {
@@ -517,7 +558,7 @@ int ngli_ctx_draw(struct ngl_ctx *s, double t)
         s->render_pass_started = 1;
     }
 
-    if (s->hud) {
+    if (measure) {
         s->cpu_draw_time = ngli_gettime_relative() - cpu_start_time;
 
         if (s->render_pass_started) {
@@ -526,16 +567,37 @@ int ngli_ctx_draw(struct ngl_ctx *s, double t)
             s->render_pass_started = 0;
         }
         ngli_gpu_ctx_query_draw_time(s->gpu_ctx, &s->gpu_draw_time);
+    }
 
+    const struct gpu_ctx *gpu_ctx = s->gpu_ctx;
+    s->stats = (struct ngl_stats){
+        .cpu_update_time   = s->cpu_update_time,
+        .cpu_draw_time     = s->cpu_draw_time,
+        .gpu_draw_time     = s->gpu_draw_time,
+        .nb_draws          = gpu_ctx->nb_draws,
+        .nb_dispatches     = gpu_ctx->nb_dispatches,
+        .nb_pipeline_binds = gpu_ctx->nb_pipeline_binds,
+        .nb_render_passes  = gpu_ctx->nb_render_passes,
+        .upload_size       = gpu_ctx->upload_size,
+        .nb_prefetches     = s->nb_prefetches,
+    };
+
+    if (s->hud)
         ngli_hud_draw(s->hud);
-    }
 
     if (s->render_pass_started) {
         ngli_gpu_ctx_end_render_pass(s->gpu_ctx);
         s->render_pass_started = 0;
     }
 
-    return ngli_gpu_ctx_end_draw(s->gpu_ctx, t);
+    ngli_rtt_pool_trim(s);
+    ngli_mem_prof_end_frame();
+
+    ret = ngli_gpu_ctx_end_draw(s->gpu_ctx, t);
+    if (ret < 0)
+        return ret;
+
+    return s->draw_ret;
 }
 
 int ngli_ctx_dispatch_cmd(struct ngl_ctx *s, cmd_func_type cmd_func, void *arg)
@@ -678,6 +740,8 @@ void ngl_backends_freep(struct ngl_backend **backendsp)
 
 struct ngl_ctx *ngl_create(void)
 {
+    ngli_math_init();
+
     struct ngl_ctx *s = ngli_calloc(1, sizeof(*s));
     if (!s)
         return NULL;
@@ -696,6 +760,9 @@ struct ngl_ctx *ngl_create(void)
     ngli_darray_init(&s->modelview_matrix_stack, 4 * 4 * sizeof(float), NGLI_DARRAY_FLAG_ALIGNED);
     ngli_darray_init(&s->projection_matrix_stack, 4 * 4 * sizeof(float), NGLI_DARRAY_FLAG_ALIGNED);
     ngli_darray_init(&s->activitycheck_nodes, sizeof(struct ngl_node *), 0);
+    ngli_darray_init(&s->resident_nodes, sizeof(struct ngl_node *), 0);
+    ngli_darray_init(&s->rtt_pool, sizeof(struct rtt_ctx *), 0);
+    ngli_darray_init(&s->rtt_attachments, sizeof(struct texture *), 0);
 
     static const NGLI_ALIGNED_MAT(id_matrix) = NGLI_MAT4_IDENTITY;
     memcpy(s->default_modelview_matrix, id_matrix, sizeof(id_matrix));
@@ -807,6 +874,75 @@ int ngl_get_viewport(struct ngl_ctx *s, int32_t *viewport)
     return s->api_impl->get_viewport(s, viewport);
 }
 
+static int cmd_get_memory_usage(struct ngl_ctx *s, void *arg)
+{
+    struct ngl_memory_usage *usage = arg;
+    *usage = (struct ngl_memory_usage){
+        .gpu_memory          = s->gpu_ctx->memory_usage,
+        .gpu_memory_resident = ngli_node_get_resident_memory(s),
+        .gpu_memory_budget   = s->config.gpu_memory_budget,
+    };
+    return 0;
+}
+
+int ngl_get_memory_usage(struct ngl_ctx *s, struct ngl_memory_usage *usage)
+{
+    if (!s->configured) {
+        LOG(ERROR, "context must be configured to get the memory usage");
+        return NGL_ERROR_INVALID_USAGE;
+    }
+
+    return ngli_ctx_dispatch_cmd(s, cmd_get_memory_usage, usage);
+}
+
+static int cmd_get_stats(struct ngl_ctx *s, void *arg)
+{
+    struct ngl_stats *stats = arg;
+    *stats = s->stats;
+    stats->texture_memory = s->gpu_ctx->texture_memory;
+    stats->buffer_memory  = s->gpu_ctx->buffer_memory;
+    if (s->scene)
+        ngli_node_get_stats(s->scene, stats);
+    return 0;
+}
+
+int ngl_get_stats(struct ngl_ctx *s, struct ngl_stats *stats)
+{
+    if (!s->configured) {
+        LOG(ERROR, "context must be configured to get the stats");
+        return NGL_ERROR_INVALID_USAGE;
+    }
+
+    return ngli_ctx_dispatch_cmd(s, cmd_get_stats, stats);
+}
+
+struct node_memory_usage_params {
+    const struct ngl_node *node;
+    uint64_t *gpu_memory;
+};
+
+static int cmd_get_node_memory_usage(struct ngl_ctx *s, void *arg)
+{
+    const struct node_memory_usage_params *params = arg;
+    if (params->node->ctx != s) {
+        LOG(ERROR, "node %s is not associated with this context", params->node->label);
+        return NGL_ERROR_INVALID_USAGE;
+    }
+    *params->gpu_memory = (uint64_t)params->node->gpu_memory;
+    return 0;
+}
+
+int ngl_get_node_memory_usage(struct ngl_ctx *s, const struct ngl_node *node, uint64_t *gpu_memory)
+{
+    if (!s->configured) {
+        LOG(ERROR, "context must be configured to get the memory usage");
+        return NGL_ERROR_INVALID_USAGE;
+    }
+
+    struct node_memory_usage_params params = {.node = node, .gpu_memory = gpu_memory};
+    return ngli_ctx_dispatch_cmd(s, cmd_get_node_memory_usage, &params);
+}
+
 int ngl_set_capture_buffer(struct ngl_ctx *s, void *capture_buffer)
 {
     if (!s->configured) {
@@ -892,7 +1028,12 @@ void ngl_freep(struct ngl_ctx **ss)
     ngli_darray_reset(&s->modelview_matrix_stack);
     ngli_darray_reset(&s->projection_matrix_stack);
     ngli_darray_reset(&s->activitycheck_nodes);
+    ngli_darray_reset(&s->resident_nodes);
+    ngli_darray_reset(&s->rtt_pool);
+    ngli_darray_reset(&s->rtt_attachments);
     ngli_freep(ss);
+
+    ngli_mem_prof_report();
 }
 
 #if defined(TARGET_ANDROID)
@@ -300,7 +300,7 @@ void ngli_bindgroup_gl_bind(struct bindgroup *s)
         const struct buffer_gl *buffer_gl = (const struct buffer_gl *)buffer;
         const struct bindgroup_layout_entry *layout_entry = &buffer_binding->layout_entry;
         const GLenum target = get_gl_target(layout_entry->type);
-        size_t offset = buffer_binding->offset;
+        size_t offset = buffer_gl->offset + buffer_binding->offset;
         if (layout_entry->type == NGLI_TYPE_STORAGE_BUFFER_DYNAMIC ||
             layout_entry->type == NGLI_TYPE_UNIFORM_BUFFER_DYNAMIC) {
             offset += s->gpu_ctx->dynamic_offsets[current_dynamic_offset++];
@@ -28,6 +28,7 @@
 #include "glcontext.h"
 #include "glincludes.h"
 #include "memory.h"
+#include "utils.h"
 
 static GLbitfield get_gl_barriers(int usage)
 {
@@ -77,6 +78,52 @@ struct buffer *ngli_buffer_gl_create(struct gpu_ctx *gpu_ctx)
     return (struct buffer *)s;
 }
 
+static int is_streaming(const struct buffer *s)
+{
+    /* Buffers mapped by the user must keep a fixed storage */
+    return (s->usage & NGLI_BUFFER_USAGE_DYNAMIC_BIT) &&
+          !(s->usage & (NGLI_BUFFER_USAGE_MAP_READ | NGLI_BUFFER_USAGE_MAP_WRITE));
+}
+
+static int init_streaming(struct buffer *s)
+{
+    struct gpu_ctx_gl *gpu_ctx_gl = (struct gpu_ctx_gl *)s->gpu_ctx;
+    struct glcontext *gl = gpu_ctx_gl->glcontext;
+    const struct gpu_limits *limits = &s->gpu_ctx->limits;
+    struct buffer_gl *s_priv = (struct buffer_gl *)s;
+
+    s_priv->streaming = 1;
+
+    /*
+     * Without immutable storage, the regions are emulated by orphaning the
+     * buffer storage on every full update
+     */
+    if (!(gl->features & NGLI_FEATURE_GL_BUFFER_STORAGE)) {
+        s_priv->nb_regions = 1;
+        s_priv->region_size = s->size;
+        ngli_glBufferData(gl, GL_ARRAY_BUFFER, s->size, NULL, get_gl_usage(s->usage));
+        return 0;
+    }
+
+    /* Every region must be bindable as a uniform or storage block range */
+    size_t alignment = NGLI_MAX(limits->min_uniform_block_offset_alignment,
+                                limits->min_storage_block_offset_alignment);
+    alignment = NGLI_MAX(alignment, NGLI_ALIGN_VAL);
+
+    s_priv->nb_regions = NGLI_BUFFER_GL_NB_REGIONS;
+    s_priv->region_size = NGLI_ALIGN(s->size, alignment);
+
+    const size_t storage_size = s_priv->nb_regions * s_priv->region_size;
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    ngli_glBufferStorage(gl, GL_ARRAY_BUFFER, storage_size, NULL, GL_DYNAMIC_STORAGE_BIT | flags);
+    s_priv->mapped_data = ngli_glMapBufferRange(gl, GL_ARRAY_BUFFER, 0, storage_size, flags);
+    if (!s_priv->mapped_data)
+        return NGL_ERROR_GRAPHICS_GENERIC;
+    s->memory_size = storage_size;
+
+    return 0;
+}
+
 int ngli_buffer_gl_init(struct buffer *s)
 {
     struct gpu_ctx_gl *gpu_ctx_gl = (struct gpu_ctx_gl *)s->gpu_ctx;
@@ -88,6 +135,9 @@ int ngli_buffer_gl_init(struct buffer *s)
 
     ngli_glGenBuffers(gl, 1, &s_priv->id);
     ngli_glBindBuffer(gl, GL_ARRAY_BUFFER, s_priv->id);
+    if (is_streaming(s))
+        return init_streaming(s);
+
     if (gl->features & NGLI_FEATURE_GL_BUFFER_STORAGE) {
         const GLbitfield storage_flags = GL_DYNAMIC_STORAGE_BIT;
         ngli_glBufferStorage(gl, GL_ARRAY_BUFFER, s->size, NULL, storage_flags | s_priv->map_flags);
@@ -98,13 +148,65 @@ int ngli_buffer_gl_init(struct buffer *s)
     return 0;
 }
 
+static int upload_streaming(struct buffer *s, const void *data, size_t size)
+{
+    struct gpu_ctx_gl *gpu_ctx_gl = (struct gpu_ctx_gl *)s->gpu_ctx;
+    struct glcontext *gl = gpu_ctx_gl->glcontext;
+    struct buffer_gl *s_priv = (struct buffer_gl *)s;
+
+    ngli_glBindBuffer(gl, GL_ARRAY_BUFFER, s_priv->id);
+
+    if (!s_priv->mapped_data) {
+        ngli_glBufferData(gl, GL_ARRAY_BUFFER, s->size, NULL, get_gl_usage(s->usage));
+        ngli_glBufferSubData(gl, GL_ARRAY_BUFFER, 0, size, data);
+        return 0;
+    }
+
+    /*
+     * The current region may already be used by the commands of the frame
+     * being built: further updates within the same frame go through the
+     * implicit synchronization of glBufferSubData() instead of waiting for
+     * the frame itself
+     */
+    const uint64_t frame_index = gpu_ctx_gl->frame_index;
+    if (s_priv->upload_frame == frame_index) {
+        ngli_glBufferSubData(gl, GL_ARRAY_BUFFER, s_priv->offset, size, data);
+        return 0;
+    }
+
+    /*
+     * Release the current region to the frames already recorded and move to
+     * the next one, which can only be overwritten once the last frame using
+     * it is done
+     */
+    const size_t index = s_priv->region_index;
+    s_priv->region_frames[index] = frame_index;
+
+    const size_t next_index = (index + 1) % s_priv->nb_regions;
+    int ret = ngli_gpu_ctx_gl_wait_frame(s->gpu_ctx, s_priv->region_frames[next_index]);
+    if (ret < 0)
+        return ret;
+
+    s_priv->region_index = next_index;
+    s_priv->offset = next_index * s_priv->region_size;
+    s_priv->upload_frame = frame_index;
+    memcpy(s_priv->mapped_data + s_priv->offset, data, size);
+
+    return 0;
+}
+
 int ngli_buffer_gl_upload(struct buffer *s, const void *data, size_t offset, size_t size)
 {
     struct gpu_ctx_gl *gpu_ctx_gl = (struct gpu_ctx_gl *)s->gpu_ctx;
     struct glcontext *gl = gpu_ctx_gl->glcontext;
     const struct buffer_gl *s_priv = (struct buffer_gl *)s;
+
+    /* Partial updates must preserve the rest of the content in place */
+    if (s_priv->streaming && offset == 0 && size == s->size)
+        return upload_streaming(s, data, size);
+
     ngli_glBindBuffer(gl, GL_ARRAY_BUFFER, s_priv->id);
-    ngli_glBufferSubData(gl, GL_ARRAY_BUFFER, offset, size, data);
+    ngli_glBufferSubData(gl, GL_ARRAY_BUFFER, s_priv->offset + offset, size, data);
     return 0;
 }
 
@@ -23,14 +23,33 @@
 #ifndef BUFFER_GL_H
 #define BUFFER_GL_H
 
+#include <stdint.h>
+
 #include "buffer.h"
 #include "glincludes.h"
 
+/*
+ * Number of regions dynamic buffers rotate through on full updates, so that
+ * the CPU can write the next content while the GPU still reads the previous
+ * ones
+ */
+#define NGLI_BUFFER_GL_NB_REGIONS 3
+
 struct buffer_gl {
     struct buffer parent;
     GLuint id;
     GLbitfield map_flags;
     GLbitfield barriers;
+
+    /* Streaming state of the dynamic buffers */
+    int streaming;
+    size_t nb_regions;
+    size_t region_size;
+    size_t region_index;
+    size_t offset; // offset of the current region, to apply on every binding
+    uint64_t region_frames[NGLI_BUFFER_GL_NB_REGIONS]; // last frame using each region
+    uint64_t upload_frame; // frame of the last move to another region
+    uint8_t *mapped_data; // persistent mapping of all the regions
 };
 
 struct gpu_ctx;
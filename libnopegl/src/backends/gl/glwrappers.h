@@ -260,6 +260,12 @@ static inline void ngli_glDeleteShader(const struct glcontext *gl, GLuint shader
     check_error_code(gl, "glDeleteShader");
 }
 
+static inline void ngli_glDeleteSync(const struct glcontext *gl, GLsync sync)
+{
+    gl->funcs.DeleteSync(sync);
+    check_error_code(gl, "glDeleteSync");
+}
+
 static inline void ngli_glDeleteTextures(const struct glcontext *gl, GLsizei n, const GLuint * textures)
 {
     gl->funcs.DeleteTextures(n, textures);
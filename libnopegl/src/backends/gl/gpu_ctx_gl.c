@@ -385,6 +385,7 @@ static struct gpu_ctx *gl_create(const struct ngl_config *config)
     struct gpu_ctx_gl *s = ngli_calloc(1, sizeof(*s));
     if (!s)
         return NULL;
+    s->frame_index = 1;
     return (struct gpu_ctx *)s;
 }
 
@@ -758,6 +759,72 @@ int ngli_gpu_ctx_gl_wrap_framebuffer(struct gpu_ctx *s, GLuint fbo)
     return 0;
 }
 
+int ngli_gpu_ctx_gl_wait_frame(struct gpu_ctx *s, uint64_t frame_index)
+{
+    struct gpu_ctx_gl *s_priv = (struct gpu_ctx_gl *)s;
+    struct glcontext *gl = s_priv->glcontext;
+
+    if (frame_index <= s_priv->completed_frame)
+        return 0;
+
+    /* Only the fences of the last frames are kept, older ones are done */
+    ngli_assert(frame_index < s_priv->frame_index);
+    GLsync fence = s_priv->frame_fences[frame_index % NGLI_ARRAY_NB(s_priv->frame_fences)];
+    if (fence) {
+        GLenum status;
+        do {
+            status = ngli_glClientWaitSync(gl, fence, GL_SYNC_FLUSH_COMMANDS_BIT, UINT64_MAX);
+        } while (status == GL_TIMEOUT_EXPIRED);
+        if (status == GL_WAIT_FAILED)
+            return NGL_ERROR_GRAPHICS_GENERIC;
+    }
+
+    s_priv->completed_frame = frame_index;
+    return 0;
+}
+
+/*
+ * Insert the fence of the frame being ended, in place of the one of the
+ * oldest frame which is waited for first: this bounds the number of frames in
+ * flight to the number of regions of the dynamic buffers.
+ */
+static int end_frame(struct gpu_ctx *s)
+{
+    struct gpu_ctx_gl *s_priv = (struct gpu_ctx_gl *)s;
+    struct glcontext *gl = s_priv->glcontext;
+
+    if (!(gl->features & NGLI_FEATURE_GL_BUFFER_STORAGE))
+        return 0;
+
+    const size_t nb_fences = NGLI_ARRAY_NB(s_priv->frame_fences);
+    const uint64_t frame_index = s_priv->frame_index;
+    GLsync *fencep = &s_priv->frame_fences[frame_index % nb_fences];
+    if (*fencep) {
+        int ret = ngli_gpu_ctx_gl_wait_frame(s, frame_index - nb_fences);
+        if (ret < 0)
+            return ret;
+        ngli_glDeleteSync(gl, *fencep);
+    }
+
+    *fencep = ngli_glFenceSync(gl, GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    if (!*fencep)
+        return NGL_ERROR_GRAPHICS_GENERIC;
+    s_priv->frame_index++;
+    return 0;
+}
+
+static void reset_frame_fences(struct gpu_ctx *s)
+{
+    struct gpu_ctx_gl *s_priv = (struct gpu_ctx_gl *)s;
+    struct glcontext *gl = s_priv->glcontext;
+
+    for (size_t i = 0; i < NGLI_ARRAY_NB(s_priv->frame_fences); i++) {
+        if (s_priv->frame_fences[i])
+            ngli_glDeleteSync(gl, s_priv->frame_fences[i]);
+        s_priv->frame_fences[i] = NULL;
+    }
+}
+
 static int gl_begin_update(struct gpu_ctx *s, double t)
 {
     return 0;
@@ -774,7 +841,7 @@ static int gl_begin_draw(struct gpu_ctx *s, double t)
     struct glcontext *gl = s_priv->glcontext;
     const struct ngl_config *config = &s->config;
 
-    if (config->hud)
+    if (config->hud || config->stats)
 #if defined(TARGET_DARWIN)
         s_priv->glBeginQuery(gl, GL_TIME_ELAPSED, s_priv->queries[0]);
 #else
@@ -816,7 +883,11 @@ static int gl_end_draw(struct gpu_ctx *s, double t)
         s_priv->capture_func(s);
     }
 
-    int ret = ngli_glcontext_check_gl_error(gl, __func__);
+    int ret = end_frame(s);
+    if (ret < 0)
+        return ret;
+
+    ret = ngli_glcontext_check_gl_error(gl, __func__);
 
     const int external = config_gl ? config_gl->external : 0;
     if (!external && !config->offscreen) {
@@ -835,7 +906,7 @@ static int gl_query_draw_time(struct gpu_ctx *s, int64_t *time)
     struct glcontext *gl = s_priv->glcontext;
 
     const struct ngl_config *config = &s->config;
-    if (!config->hud)
+    if (!config->hud && !config->stats)
         return NGL_ERROR_INVALID_USAGE;
 
 #if defined(TARGET_DARWIN)
@@ -862,6 +933,7 @@ static void gl_wait_idle(struct gpu_ctx *s)
     struct gpu_ctx_gl *s_priv = (struct gpu_ctx_gl *)s;
     struct glcontext *gl = s_priv->glcontext;
     ngli_glFinish(gl);
+    s_priv->completed_frame = s_priv->frame_index - 1;
 }
 
 static void gl_destroy(struct gpu_ctx *s)
@@ -869,6 +941,7 @@ static void gl_destroy(struct gpu_ctx *s)
     struct gpu_ctx_gl *s_priv = (struct gpu_ctx_gl *)s;
     timer_reset(s);
     rendertarget_reset(s);
+    reset_frame_fences(s);
 #if DEBUG_GPU_CAPTURE
     if (s->gpu_capture)
         ngli_gpu_capture_end(s->gpu_capture_ctx);
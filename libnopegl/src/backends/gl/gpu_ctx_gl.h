@@ -30,6 +30,7 @@
 #include <CoreVideo/CoreVideo.h>
 #endif
 
+#include "buffer_gl.h"
 #include "glstate.h"
 #include "rendertarget.h"
 #include "gpu_ctx.h"
@@ -69,11 +70,20 @@ struct gpu_ctx_gl {
     void (*glEndQuery)(const struct glcontext *gl, GLenum target);
     void (*glQueryCounter)(const struct glcontext *gl, GLuint id, GLenum target);
     void (*glGetQueryObjectui64v)(const struct glcontext *gl, GLuint id, GLenum pname, GLuint64 *params);
+    /*
+     * Frame fences used to recycle the regions of the dynamic buffers: the
+     * frames are numbered from 1, and every frame up to completed_frame is
+     * known to be done by the GPU
+     */
+    uint64_t frame_index;
+    uint64_t completed_frame;
+    GLsync frame_fences[NGLI_BUFFER_GL_NB_REGIONS];
 };
 
 int ngli_gpu_ctx_gl_make_current(struct gpu_ctx *s);
 int ngli_gpu_ctx_gl_release_current(struct gpu_ctx *s);
 void ngli_gpu_ctx_gl_reset_state(struct gpu_ctx *s);
 int ngli_gpu_ctx_gl_wrap_framebuffer(struct gpu_ctx *s, GLuint fbo);
+int ngli_gpu_ctx_gl_wait_frame(struct gpu_ctx *s, uint64_t frame_index);
 
 #endif
@@ -116,8 +116,8 @@ static void bind_vertex_attribs(const struct pipeline *s, struct glcontext *gl)
         const GLuint location = attribute_binding->location;
         const GLuint size = ngli_format_get_nb_comp(attribute_binding->format);
         const GLsizei stride = (GLsizei)attribute_binding->stride;
-        const void *offset = (void *)(uintptr_t)attribute_binding->offset;
         const struct buffer_gl *buffer_gl = (const struct buffer_gl *)vertex_buffers[binding];
+        const void *offset = (void *)(uintptr_t)(buffer_gl->offset + attribute_binding->offset);
         ngli_glBindBuffer(gl, GL_ARRAY_BUFFER, buffer_gl->id);
         ngli_glVertexAttribPointer(gl, location, size, GL_FLOAT, GL_FALSE, stride, offset);
     }
@@ -236,10 +236,11 @@ void ngli_pipeline_gl_draw_indexed(struct pipeline *s, int nb_indices, int nb_in
         ngli_glMemoryBarrier(gl, barriers);
 
     const GLenum gl_topology = get_gl_topology(graphics->topology);
+    const void *indices_offset = (void *)(uintptr_t)indices_gl->offset;
     if (nb_instances > 1)
-        ngli_glDrawElementsInstanced(gl, gl_topology, nb_indices, gl_indices_type, 0, nb_instances);
+        ngli_glDrawElementsInstanced(gl, gl_topology, nb_indices, gl_indices_type, indices_offset, nb_instances);
     else
-        ngli_glDrawElements(gl, gl_topology, nb_indices, gl_indices_type, 0);
+        ngli_glDrawElements(gl, gl_topology, nb_indices, gl_indices_type, indices_offset);
 
     if (barriers)
         ngli_glMemoryBarrier(gl, barriers);
@@ -156,43 +156,69 @@ static VkResult buffer_vk_upload(struct buffer *s, const void *data, size_t offs
         return VK_SUCCESS;
     }
 
-    const VkBufferUsageFlags usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-    const VkMemoryPropertyFlags mem_props = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-                                            VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
-    VkResult res = create_vk_buffer(vk, s->size, usage, mem_props,
-                                    &s_priv->staging_buffer, &s_priv->staging_memory);
-    if (res != VK_SUCCESS)
-        return res;
+    /*
+     * The staging buffer is released right away but the copy keeps a
+     * reference on it until the transfer batch it is recorded in completes
+     */
+    struct buffer *staging = ngli_buffer_create(s->gpu_ctx);
+    if (!staging)
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+
+    VkResult res = VK_SUCCESS;
+    int ret = ngli_buffer_init(staging, size, NGLI_BUFFER_USAGE_MAP_WRITE | NGLI_BUFFER_USAGE_TRANSFER_SRC_BIT);
+    if (ret < 0) {
+        res = VK_ERROR_OUT_OF_DEVICE_MEMORY;
+        goto end;
+    }
 
-    uint8_t *mapped_data;
-    res = vkMapMemory(vk->device, s_priv->staging_memory, 0, s->size, 0, (void *)&mapped_data);
+    struct buffer_vk *staging_vk = (struct buffer_vk *)staging;
+    void *mapped_data;
+    res = vkMapMemory(vk->device, staging_vk->memory, 0, size, 0, &mapped_data);
     if (res != VK_SUCCESS)
-        return res;
-    memcpy(mapped_data + offset, data, size);
-    vkUnmapMemory(vk->device, s_priv->staging_memory);
+        goto end;
+    memcpy(mapped_data, data, size);
+    vkUnmapMemory(vk->device, staging_vk->memory);
 
     struct cmd_vk *cmd_vk;
-    res = ngli_cmd_vk_begin_transient(s->gpu_ctx, 0, &cmd_vk);
+    res = ngli_cmd_vk_begin_transfer(s->gpu_ctx, &cmd_vk);
+    if (res != VK_SUCCESS)
+        goto end;
+
+    res = NGLI_CMD_VK_REF(cmd_vk, staging);
+    if (res != VK_SUCCESS)
+        goto end;
+
+    res = NGLI_CMD_VK_REF(cmd_vk, s);
     if (res != VK_SUCCESS)
-        return res;
+        goto end;
+
+    /*
+     * The batch may already hold copies to the same buffer: the writes must
+     * land in the order of the uploads
+     */
+    const VkMemoryBarrier barrier = {
+        .sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+        .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+        .dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+    };
+    vkCmdPipelineBarrier(cmd_vk->cmd_buf,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         0,
+                         1, &barrier,
+                         0, NULL,
+                         0, NULL);
 
     const VkBufferCopy region = {
         .srcOffset = 0,
         .dstOffset = offset,
         .size      = size,
     };
-    vkCmdCopyBuffer(cmd_vk->cmd_buf, s_priv->staging_buffer, s_priv->buffer, 1, &region);
-
-    res = ngli_cmd_vk_execute_transient(&cmd_vk);
-    if (res != VK_SUCCESS)
-        return res;
+    vkCmdCopyBuffer(cmd_vk->cmd_buf, staging_vk->buffer, s_priv->buffer, 1, &region);
 
-    vkDestroyBuffer(vk->device, s_priv->staging_buffer, NULL);
-    s_priv->staging_buffer = VK_NULL_HANDLE;
-    vkFreeMemory(vk->device, s_priv->staging_memory, NULL);
-    s_priv->staging_memory = VK_NULL_HANDLE;
-
-    return VK_SUCCESS;
+end:
+    ngli_buffer_freep(&staging);
+    return res;
 }
 
 int ngli_buffer_vk_upload(struct buffer *s, const void *data, size_t offset, size_t size)
@@ -241,7 +267,5 @@ void ngli_buffer_vk_freep(struct buffer **sp)
 
     vkDestroyBuffer(vk->device, s_priv->buffer, NULL);
     vkFreeMemory(vk->device, s_priv->memory, NULL);
-    vkDestroyBuffer(vk->device, s_priv->staging_buffer, NULL);
-    vkFreeMemory(vk->device, s_priv->staging_memory, NULL);
     ngli_freep(sp);
 }
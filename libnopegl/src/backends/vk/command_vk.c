@@ -133,7 +133,13 @@ VkResult ngli_cmd_vk_begin(struct cmd_vk *s)
         .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
         .flags = VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT,
     };
-    return vkBeginCommandBuffer(s->cmd_buf, &cmd_buf_begin_info);
+    VkResult res = vkBeginCommandBuffer(s->cmd_buf, &cmd_buf_begin_info);
+    if (res != VK_SUCCESS)
+        return res;
+
+    s->recording = 1;
+
+    return VK_SUCCESS;
 }
 
 VkResult ngli_cmd_vk_submit(struct cmd_vk *s)
@@ -141,7 +147,14 @@ VkResult ngli_cmd_vk_submit(struct cmd_vk *s)
     struct gpu_ctx_vk *gpu_ctx_vk = (struct gpu_ctx_vk *)s->gpu_ctx;
     struct vkcontext *vk = gpu_ctx_vk->vkcontext;
 
-    VkResult res = vkEndCommandBuffer(s->cmd_buf);
+    /* Pending transfers must execute before any work submitted after them */
+    VkResult res = ngli_cmd_vk_flush_transfers(s->gpu_ctx);
+    if (res != VK_SUCCESS)
+        return res;
+
+    s->recording = 0;
+
+    res = vkEndCommandBuffer(s->cmd_buf);
     if (res != VK_SUCCESS)
         return res;
 
@@ -198,19 +211,48 @@ VkResult ngli_cmd_vk_wait(struct cmd_vk *s)
     return VK_SUCCESS;
 }
 
-VkResult ngli_cmd_vk_begin_transient(struct gpu_ctx *gpu_ctx, int type, struct cmd_vk **sp)
+static VkResult get_transient_cmd(struct gpu_ctx *gpu_ctx, struct cmd_vk **sp)
 {
+    struct gpu_ctx_vk *gpu_ctx_vk = (struct gpu_ctx_vk *)gpu_ctx;
+    struct vkcontext *vk = gpu_ctx_vk->vkcontext;
+
+    /*
+     * Recycle the first command buffer that is neither being recorded nor
+     * still in flight; checking its fence here rather than right after its
+     * submission is what makes transient submissions non-blocking.
+     */
+    struct cmd_vk **cmds = ngli_darray_data(&gpu_ctx_vk->transient_cmds);
+    for (size_t i = 0; i < ngli_darray_count(&gpu_ctx_vk->transient_cmds); i++) {
+        struct cmd_vk *s = cmds[i];
+        if (s->recording)
+            continue;
+
+        VkResult res = vkGetFenceStatus(vk->device, s->fence);
+        if (res == VK_NOT_READY)
+            continue;
+        if (res != VK_SUCCESS)
+            return res;
+
+        res = ngli_cmd_vk_wait(s);
+        if (res != VK_SUCCESS)
+            return res;
+
+        *sp = s;
+        return VK_SUCCESS;
+    }
+
     struct cmd_vk *s = ngli_cmd_vk_create(gpu_ctx);
     if (!s)
         return VK_ERROR_OUT_OF_HOST_MEMORY;
 
-    VkResult res = ngli_cmd_vk_init(s, type);
+    VkResult res = ngli_cmd_vk_init(s, 0);
     if (res != VK_SUCCESS)
         goto fail;
 
-    res = ngli_cmd_vk_begin(s);
-    if (res != VK_SUCCESS)
+    if (!ngli_darray_push(&gpu_ctx_vk->transient_cmds, &s)) {
+        res = VK_ERROR_OUT_OF_HOST_MEMORY;
         goto fail;
+    }
 
     *sp = s;
     return VK_SUCCESS;
@@ -220,19 +262,92 @@ fail:
     return res;
 }
 
+VkResult ngli_cmd_vk_begin_transient(struct gpu_ctx *gpu_ctx, int type, struct cmd_vk **sp)
+{
+    struct cmd_vk *s;
+    VkResult res = get_transient_cmd(gpu_ctx, &s);
+    if (res != VK_SUCCESS)
+        return res;
+
+    s->type = type;
+
+    res = ngli_cmd_vk_begin(s);
+    if (res != VK_SUCCESS)
+        return res;
+
+    *sp = s;
+    return VK_SUCCESS;
+}
+
 VkResult ngli_cmd_vk_execute_transient(struct cmd_vk **sp)
 {
     struct cmd_vk *s = *sp;
     if (!s)
         return VK_SUCCESS;
 
+    /* The command buffer is owned by the transient pool */
+    *sp = NULL;
+
     VkResult res = ngli_cmd_vk_submit(s);
     if (res != VK_SUCCESS)
-        goto done;
+        return res;
 
-    res = ngli_cmd_vk_wait(s);
+    return ngli_cmd_vk_wait(s);
+}
 
-done:
-    ngli_cmd_vk_freep(sp);
-    return res;
+VkResult ngli_cmd_vk_begin_transfer(struct gpu_ctx *gpu_ctx, struct cmd_vk **sp)
+{
+    struct gpu_ctx_vk *gpu_ctx_vk = (struct gpu_ctx_vk *)gpu_ctx;
+
+    if (!gpu_ctx_vk->transfer_cmd) {
+        struct cmd_vk *s;
+        VkResult res = ngli_cmd_vk_begin_transient(gpu_ctx, 0, &s);
+        if (res != VK_SUCCESS)
+            return res;
+
+        /* Order the batch after the work already submitted to the queue */
+        const VkMemoryBarrier barrier = {
+            .sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+            .srcAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT,
+            .dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT,
+        };
+        vkCmdPipelineBarrier(s->cmd_buf,
+                             VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             0,
+                             1, &barrier,
+                             0, NULL,
+                             0, NULL);
+
+        gpu_ctx_vk->transfer_cmd = s;
+    }
+
+    *sp = gpu_ctx_vk->transfer_cmd;
+    return VK_SUCCESS;
+}
+
+VkResult ngli_cmd_vk_flush_transfers(struct gpu_ctx *gpu_ctx)
+{
+    struct gpu_ctx_vk *gpu_ctx_vk = (struct gpu_ctx_vk *)gpu_ctx;
+
+    struct cmd_vk *s = gpu_ctx_vk->transfer_cmd;
+    if (!s)
+        return VK_SUCCESS;
+    gpu_ctx_vk->transfer_cmd = NULL;
+
+    /* Make the transfers visible to the work submitted after the batch */
+    const VkMemoryBarrier barrier = {
+        .sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+        .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+        .dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT,
+    };
+    vkCmdPipelineBarrier(s->cmd_buf,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                         0,
+                         1, &barrier,
+                         0, NULL,
+                         0, NULL);
+
+    return ngli_cmd_vk_submit(s);
 }
@@ -34,6 +34,7 @@ struct cmd_vk {
     VkCommandPool pool;
     VkCommandBuffer cmd_buf;
     VkFence fence;
+    int recording;
     struct darray wait_sems;
     struct darray wait_stages;
     struct darray signal_sems;
@@ -56,4 +57,13 @@ VkResult ngli_cmd_vk_wait(struct cmd_vk *s);
 VkResult ngli_cmd_vk_begin_transient(struct gpu_ctx *gpu_ctx, int type, struct cmd_vk **sp);
 VkResult ngli_cmd_vk_execute_transient(struct cmd_vk **sp);
 
+/*
+ * Return the shared transfer command buffer, beginning it if needed. The
+ * commands recorded in it are not executed immediately: they are submitted
+ * as a single batch right before the next queue submission (or an explicit
+ * flush), and its fence is only checked when the command buffer is recycled.
+ */
+VkResult ngli_cmd_vk_begin_transfer(struct gpu_ctx *gpu_ctx, struct cmd_vk **sp);
+VkResult ngli_cmd_vk_flush_transfers(struct gpu_ctx *gpu_ctx);
+
 #endif
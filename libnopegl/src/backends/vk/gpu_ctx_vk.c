@@ -317,6 +317,12 @@ static void destroy_query_pool(struct gpu_ctx *s)
     vkDestroyQueryPool(vk->device, s_priv->query_pool, NULL);
 }
 
+static void free_cmd(void *user_arg, void *data)
+{
+    struct cmd_vk **cmdp = data;
+    ngli_cmd_vk_freep(cmdp);
+}
+
 static VkResult create_command_pool_and_buffers(struct gpu_ctx *s)
 {
     struct gpu_ctx_vk *s_priv = (struct gpu_ctx_vk *)s;
@@ -355,6 +361,9 @@ static VkResult create_command_pool_and_buffers(struct gpu_ctx *s)
 
     ngli_darray_init(&s_priv->pending_cmds, sizeof(struct vmd_vk *), 0);
 
+    ngli_darray_init(&s_priv->transient_cmds, sizeof(struct cmd_vk *), 0);
+    ngli_darray_set_free_func(&s_priv->transient_cmds, free_cmd, NULL);
+
     return VK_SUCCESS;
 }
 
@@ -375,6 +384,9 @@ static void destroy_command_pool_and_buffers(struct gpu_ctx *s)
         ngli_freep(&s_priv->update_cmds);
     }
 
+    s_priv->transfer_cmd = NULL;
+    ngli_darray_reset(&s_priv->transient_cmds);
+
     vkDestroyCommandPool(vk->device, s_priv->cmd_pool, NULL);
 
     ngli_darray_reset(&s_priv->pending_cmds);
@@ -896,6 +908,7 @@ static int vk_init(struct gpu_ctx *s)
     s->limits.max_storage_block_size             = limits->maxStorageBufferRange;
     s->limits.min_uniform_block_offset_alignment = limits->minUniformBufferOffsetAlignment;
     s->limits.min_storage_block_offset_alignment = limits->minStorageBufferOffsetAlignment;
+    s->limits.max_push_constants_size            = NGLI_MIN(limits->maxPushConstantsSize, NGLI_MAX_PUSH_CONSTANTS_SIZE);
 
     if (config->set_surface_pts &&
         !ngli_vkcontext_has_extension(vk, VK_GOOGLE_DISPLAY_TIMING_EXTENSION_NAME, 1)) {
@@ -1019,13 +1032,13 @@ static int vk_begin_update(struct gpu_ctx *s, double t)
 {
     struct gpu_ctx_vk *s_priv = (struct gpu_ctx_vk *)s;
 
-    struct cmd_vk **cmds = ngli_darray_data(&s_priv->pending_cmds);
-    for (size_t i = 0; i < ngli_darray_count(&s_priv->pending_cmds); i++) {
-        VkResult res = ngli_cmd_vk_wait(cmds[i]);
+    /* Waiting on a command removes it from the pending list */
+    while (ngli_darray_count(&s_priv->pending_cmds)) {
+        struct cmd_vk **cmds = ngli_darray_data(&s_priv->pending_cmds);
+        VkResult res = ngli_cmd_vk_wait(cmds[0]);
         if (res != VK_SUCCESS)
             return ngli_vk_res2ret(res);
     }
-    ngli_darray_clear(&s_priv->pending_cmds);
 
     struct cmd_vk *cmd_vk = s_priv->cmds[s_priv->cur_frame_index];
     VkResult res = ngli_cmd_vk_wait(cmd_vk);
@@ -1103,7 +1116,7 @@ static int vk_begin_draw(struct gpu_ctx *s, double t)
         s_priv->default_rt_load->height = s_priv->height;
     }
 
-    if (config->hud) {
+    if (config->hud || config->stats) {
         vkCmdResetQueryPool(s_priv->cur_cmd->cmd_buf, s_priv->query_pool, 0, 2);
         vkCmdWriteTimestamp(s_priv->cur_cmd->cmd_buf, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, s_priv->query_pool, 0);
     }
@@ -1117,7 +1130,7 @@ static int vk_query_draw_time(struct gpu_ctx *s, int64_t *time)
     struct vkcontext *vk = s_priv->vkcontext;
     const struct ngl_config *config = &s->config;
 
-    if (!config->hud)
+    if (!config->hud && !config->stats)
         return NGL_ERROR_INVALID_USAGE;
 
     ngli_assert(s_priv->cur_cmd->cmd_buf);
@@ -1221,6 +1234,9 @@ static void vk_wait_idle(struct gpu_ctx *s)
 {
     struct gpu_ctx_vk *s_priv = (struct gpu_ctx_vk *)s;
     struct vkcontext *vk = s_priv->vkcontext;
+    VkResult res = ngli_cmd_vk_flush_transfers(s);
+    if (res != VK_SUCCESS)
+        LOG(ERROR, "unable to flush pending transfers: %s", ngli_vk_res2str(res));
     vkDeviceWaitIdle(vk->device);
 }
 
@@ -1522,6 +1538,8 @@ const struct gpu_ctx_class ngli_gpu_ctx_vk = {
     .texture_create                     = ngli_texture_vk_create,
     .texture_init                       = ngli_texture_vk_init,
     .texture_upload                     = ngli_texture_vk_upload,
+    .texture_map_staging                = ngli_texture_vk_map_staging,
+    .texture_upload_staging             = ngli_texture_vk_upload_staging,
     .texture_generate_mipmap            = ngli_texture_vk_generate_mipmap,
     .texture_freep                      = ngli_texture_vk_freep,
 };
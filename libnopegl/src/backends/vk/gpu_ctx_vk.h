@@ -42,6 +42,8 @@ struct gpu_ctx_vk {
     struct darray pending_cmds;
     struct cmd_vk *cur_cmd;
     int cur_cmd_is_transient;
+    struct darray transient_cmds; // recycled transient cmd_vk pointers
+    struct cmd_vk *transfer_cmd;  // pending transfer batch, if any
 
     VkQueryPool query_pool;
 
@@ -348,6 +348,14 @@ static VkResult pipeline_compute_init(struct pipeline *s)
     return vkCreateComputePipelines(vk->device, VK_NULL_HANDLE, 1, &pipeline_create_info, NULL, &s_priv->pipeline);
 }
 
+static VkShaderStageFlags get_push_constants_stage_flags(const struct pipeline *s)
+{
+    /* The push constant block is declared in every stage of the program */
+    if (s->type == NGLI_PIPELINE_TYPE_COMPUTE)
+        return VK_SHADER_STAGE_COMPUTE_BIT;
+    return VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+}
+
 static VkResult create_pipeline_layout(struct pipeline *s)
 {
     struct gpu_ctx_vk *gpu_ctx_vk = (struct gpu_ctx_vk *)s->gpu_ctx;
@@ -356,10 +364,18 @@ static VkResult create_pipeline_layout(struct pipeline *s)
 
     struct bindgroup_layout_vk *layout = (struct bindgroup_layout_vk *)s->layout.bindgroup_layout;
 
+    const VkPushConstantRange push_constant_range = {
+        .stageFlags = get_push_constants_stage_flags(s),
+        .offset     = 0,
+        .size       = (uint32_t)s->layout.push_constants_size,
+    };
+
     const VkPipelineLayoutCreateInfo pipeline_layout_create_info = {
-        .sType          = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
-        .setLayoutCount = layout->desc_set_layout  ? 1 : 0,
-        .pSetLayouts    = &layout->desc_set_layout,
+        .sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+        .setLayoutCount         = layout->desc_set_layout  ? 1 : 0,
+        .pSetLayouts            = &layout->desc_set_layout,
+        .pushConstantRangeCount = s->layout.push_constants_size ? 1 : 0,
+        .pPushConstantRanges    = &push_constant_range,
     };
 
     return vkCreatePipelineLayout(vk->device, &pipeline_layout_create_info, NULL, &s_priv->pipeline_layout);
@@ -431,6 +447,20 @@ static int prepare_and_bind_descriptor_set(struct pipeline *s, VkCommandBuffer c
     return 0;
 }
 
+static void push_constants(struct pipeline *s, VkCommandBuffer cmd_buf)
+{
+    const struct gpu_ctx *gpu_ctx = s->gpu_ctx;
+    const struct pipeline_vk *s_priv = (const struct pipeline_vk *)s;
+
+    const size_t size = s->layout.push_constants_size;
+    if (!size)
+        return;
+
+    ngli_assert(gpu_ctx->push_constants_size == size);
+    vkCmdPushConstants(cmd_buf, s_priv->pipeline_layout, get_push_constants_stage_flags(s),
+                       0, (uint32_t)size, gpu_ctx->push_constants);
+}
+
 static int prepare_and_bind_graphics_pipeline(struct pipeline *s, VkCommandBuffer cmd_buf)
 {
     struct gpu_ctx *gpu_ctx = s->gpu_ctx;
@@ -465,6 +495,8 @@ static int prepare_and_bind_graphics_pipeline(struct pipeline *s, VkCommandBuffe
     }
     vkCmdSetScissor(cmd_buf, 0, 1, &scissor);
 
+    push_constants(s, cmd_buf);
+
     return 0;
 }
 
@@ -525,6 +557,7 @@ void ngli_pipeline_vk_dispatch(struct pipeline *s, uint32_t nb_group_x, uint32_t
         return;
 
     vkCmdBindPipeline(cmd_buf, s_priv->pipeline_bind_point, s_priv->pipeline);
+    push_constants(s, cmd_buf);
     vkCmdDispatch(cmd_buf, nb_group_x, nb_group_y, nb_group_z);
 
     const VkMemoryBarrier barrier = {
@@ -330,6 +330,7 @@ struct texture *ngli_texture_vk_create(struct gpu_ctx *gpu_ctx)
     if (!s)
         return NULL;
     s->parent.gpu_ctx = gpu_ctx;
+    ngli_darray_init(&s->staging_spares, sizeof(struct buffer *), 0);
     return (struct texture *)s;
 }
 
@@ -423,7 +424,11 @@ static VkResult texture_vk_init(struct texture *s, const struct texture_params *
         return res;
 
     struct cmd_vk *cmd_vk;
-    res = ngli_cmd_vk_begin_transient(s->gpu_ctx, 0, &cmd_vk);
+    res = ngli_cmd_vk_begin_transfer(s->gpu_ctx, &cmd_vk);
+    if (res != VK_SUCCESS)
+        return res;
+
+    res = NGLI_CMD_VK_REF(cmd_vk, s);
     if (res != VK_SUCCESS)
         return res;
 
@@ -441,10 +446,6 @@ static VkResult texture_vk_init(struct texture *s, const struct texture_params *
                             s_priv->default_image_layout,
                             &subres_range);
 
-    res = ngli_cmd_vk_execute_transient(&cmd_vk);
-    if (res != VK_SUCCESS)
-        return res;
-
     s_priv->image_layout = s_priv->default_image_layout;
 
     res = create_image_view(s);
@@ -555,9 +556,44 @@ void ngli_texture_vk_copy_to_buffer(struct texture *s, struct buffer *buffer)
                            buffer_vk->buffer, 1, &region);
 }
 
-static VkResult texture_vk_upload(struct texture *s, const uint8_t *data, int linesize)
+static int is_staging_buffer_busy(const struct buffer *buffer)
+{
+    /* The command buffers holding a copy from it keep a reference until it completes */
+    return buffer->rc.count > 1;
+}
+
+static void free_staging_spares(struct texture_vk *s_priv)
+{
+    struct buffer **spares = ngli_darray_data(&s_priv->staging_spares);
+    for (size_t i = 0; i < ngli_darray_count(&s_priv->staging_spares); i++)
+        ngli_buffer_freep(&spares[i]);
+    ngli_darray_clear(&s_priv->staging_spares);
+}
+
+/*
+ * Swap the current staging buffer, still read by a pending copy, with a spare
+ * one that is not used anymore. Returns NULL if there is none available.
+ */
+static struct buffer *swap_staging_buffer(struct texture_vk *s_priv)
+{
+    struct buffer *busy = s_priv->staging_buffer;
+    s_priv->staging_buffer = NULL;
+    if (!ngli_darray_push(&s_priv->staging_spares, &busy))
+        ngli_buffer_freep(&busy);
+
+    struct buffer **spares = ngli_darray_data(&s_priv->staging_spares);
+    for (size_t i = 0; i < ngli_darray_count(&s_priv->staging_spares); i++) {
+        struct buffer *spare = spares[i];
+        if (!is_staging_buffer_busy(spare)) {
+            ngli_darray_remove(&s_priv->staging_spares, i);
+            return spare;
+        }
+    }
+    return NULL;
+}
+
+static VkResult prepare_staging_buffer(struct texture *s, int linesize)
 {
-    struct gpu_ctx_vk *gpu_ctx_vk = (struct gpu_ctx_vk *)s->gpu_ctx;
     const struct texture_params *params = &s->params;
     struct texture_vk *s_priv = (struct texture_vk *)s;
 
@@ -565,21 +601,31 @@ static VkResult texture_vk_upload(struct texture *s, const uint8_t *data, int li
     ngli_assert(!s_priv->wrapped_image);
     ngli_assert(params->usage & NGLI_TEXTURE_USAGE_TRANSFER_DST_BIT);
 
-    if (!data)
+    if (s_priv->staging_buffer && s_priv->staging_buffer_row_length == linesize &&
+        !is_staging_buffer_busy(s_priv->staging_buffer))
         return VK_SUCCESS;
 
-    if (!s_priv->staging_buffer || s_priv->staging_buffer_row_length != linesize) {
-        const int32_t width = linesize ? linesize : s->params.width;
-        const int32_t staging_buffer_size = width * s->params.height * s->params.depth * s_priv->bytes_per_pixel * s_priv->array_layers;
+    if (s_priv->staging_buffer_ptr) {
+        ngli_buffer_unmap(s_priv->staging_buffer);
+        s_priv->staging_buffer_ptr = NULL;
+    }
 
-        if (s_priv->staging_buffer) {
-            if (s_priv->staging_buffer_ptr) {
-                ngli_buffer_unmap(s_priv->staging_buffer);
-                s_priv->staging_buffer_ptr = NULL;
-            }
-            ngli_buffer_freep(&s_priv->staging_buffer);
-        }
+    /*
+     * The pending copies hold their own reference on the staging buffer they
+     * read from, so the buffers dropped here are only released once these
+     * copies complete
+     */
+    if (s_priv->staging_buffer && s_priv->staging_buffer_row_length == linesize) {
+        s_priv->staging_buffer = swap_staging_buffer(s_priv);
+    } else {
+        ngli_buffer_freep(&s_priv->staging_buffer);
+        free_staging_spares(s_priv);
+    }
 
+    const int32_t width = linesize ? linesize : s->params.width;
+    const int32_t staging_buffer_size = width * s->params.height * s->params.depth * s_priv->bytes_per_pixel * s_priv->array_layers;
+
+    if (!s_priv->staging_buffer) {
         s_priv->staging_buffer = ngli_buffer_create(s->gpu_ctx);
         if (!s_priv->staging_buffer)
             return VK_ERROR_OUT_OF_HOST_MEMORY;
@@ -592,36 +638,22 @@ static VkResult texture_vk_upload(struct texture *s, const uint8_t *data, int li
             return VK_ERROR_UNKNOWN;
 
         s_priv->staging_buffer_row_length = linesize;
-
-        ret = ngli_buffer_map(s_priv->staging_buffer, 0, staging_buffer_size, &s_priv->staging_buffer_ptr);
-        if (ret < 0)
-            return VK_ERROR_UNKNOWN;
     }
 
-    memcpy(s_priv->staging_buffer_ptr, data, s_priv->staging_buffer->size);
+    int ret = ngli_buffer_map(s_priv->staging_buffer, 0, staging_buffer_size, &s_priv->staging_buffer_ptr);
+    if (ret < 0)
+        return VK_ERROR_UNKNOWN;
 
-    struct cmd_vk *cmd_vk = gpu_ctx_vk->cur_cmd;
-    const int cmd_is_transient = cmd_vk ? 0 : 1;
-    if (cmd_is_transient) {
-        VkResult res = ngli_cmd_vk_begin_transient(s->gpu_ctx, 0, &cmd_vk);
-        if (res != VK_SUCCESS)
-            return res;
-    }
-    VkCommandBuffer cmd_buf = cmd_vk->cmd_buf;
-    NGLI_CMD_VK_REF(cmd_vk, s);
+    return VK_SUCCESS;
+}
 
-    const VkImageSubresourceRange subres_range = {
-        .aspectMask     = get_vk_image_aspect_flags(s_priv->format),
-        .baseMipLevel   = 0,
-        .levelCount     = 1,
-        .baseArrayLayer = 0,
-        .layerCount     = VK_REMAINING_ARRAY_LAYERS,
-    };
-    transition_image_layout(cmd_buf,
-                            s_priv->image,
-                            s_priv->image_layout,
-                            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                            &subres_range);
+static VkResult upload_staging_buffer(struct texture *s)
+{
+    struct gpu_ctx_vk *gpu_ctx_vk = (struct gpu_ctx_vk *)s->gpu_ctx;
+    const struct texture_params *params = &s->params;
+    struct texture_vk *s_priv = (struct texture_vk *)s;
+
+    ngli_assert(s_priv->staging_buffer);
 
     struct darray copy_regions;
     ngli_darray_init(&copy_regions, sizeof(VkBufferImageCopy), 0);
@@ -631,7 +663,7 @@ static VkResult texture_vk_upload(struct texture *s, const uint8_t *data, int li
         const VkDeviceSize offset = i * layer_size;
         const VkBufferImageCopy region = {
             .bufferOffset      = offset,
-            .bufferRowLength   = linesize,
+            .bufferRowLength   = (uint32_t)s_priv->staging_buffer_row_length,
             .bufferImageHeight = 0,
             .imageSubresource = {
                 .aspectMask     = get_vk_image_aspect_flags(s_priv->format),
@@ -648,13 +680,41 @@ static VkResult texture_vk_upload(struct texture *s, const uint8_t *data, int li
 
         if (!ngli_darray_push(&copy_regions, &region)) {
             ngli_darray_reset(&copy_regions);
-            if (cmd_is_transient) {
-                ngli_cmd_vk_freep(&cmd_vk);
-            }
             return VK_ERROR_OUT_OF_HOST_MEMORY;
         }
     }
 
+    VkResult res;
+    struct cmd_vk *cmd_vk = gpu_ctx_vk->cur_cmd;
+    if (!cmd_vk) {
+        res = ngli_cmd_vk_begin_transfer(s->gpu_ctx, &cmd_vk);
+        if (res != VK_SUCCESS) {
+            ngli_darray_reset(&copy_regions);
+            return res;
+        }
+    }
+    VkCommandBuffer cmd_buf = cmd_vk->cmd_buf;
+    res = NGLI_CMD_VK_REF(cmd_vk, s);
+    if (res == VK_SUCCESS)
+        res = NGLI_CMD_VK_REF(cmd_vk, s_priv->staging_buffer);
+    if (res != VK_SUCCESS) {
+        ngli_darray_reset(&copy_regions);
+        return res;
+    }
+
+    const VkImageSubresourceRange subres_range = {
+        .aspectMask     = get_vk_image_aspect_flags(s_priv->format),
+        .baseMipLevel   = 0,
+        .levelCount     = 1,
+        .baseArrayLayer = 0,
+        .layerCount     = VK_REMAINING_ARRAY_LAYERS,
+    };
+    transition_image_layout(cmd_buf,
+                            s_priv->image,
+                            s_priv->image_layout,
+                            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                            &subres_range);
+
     struct buffer_vk *staging_buffer_vk = (struct buffer_vk *)s_priv->staging_buffer;
     vkCmdCopyBufferToImage(cmd_buf,
                            staging_buffer_vk->buffer,
@@ -671,18 +731,51 @@ static VkResult texture_vk_upload(struct texture *s, const uint8_t *data, int li
                             s_priv->image_layout,
                             &subres_range);
 
-    if (cmd_is_transient) {
-        VkResult res = ngli_cmd_vk_execute_transient(&cmd_vk);
-        if (res != VK_SUCCESS)
-            return res;
-    }
-
     if (params->mipmap_filter != NGLI_MIPMAP_FILTER_NONE)
         ngli_texture_generate_mipmap(s);
 
     return VK_SUCCESS;
 }
 
+static VkResult texture_vk_upload(struct texture *s, const uint8_t *data, int linesize)
+{
+    struct texture_vk *s_priv = (struct texture_vk *)s;
+
+    if (!data)
+        return VK_SUCCESS;
+
+    VkResult res = prepare_staging_buffer(s, linesize);
+    if (res != VK_SUCCESS)
+        return res;
+
+    memcpy(s_priv->staging_buffer_ptr, data, s_priv->staging_buffer->size);
+
+    return upload_staging_buffer(s);
+}
+
+int ngli_texture_vk_map_staging(struct texture *s, int linesize, uint8_t **datap, size_t *sizep)
+{
+    struct texture_vk *s_priv = (struct texture_vk *)s;
+
+    VkResult res = prepare_staging_buffer(s, linesize);
+    if (res != VK_SUCCESS) {
+        LOG(ERROR, "unable to map texture staging buffer: %s", ngli_vk_res2str(res));
+        return ngli_vk_res2ret(res);
+    }
+
+    *datap = s_priv->staging_buffer_ptr;
+    *sizep = s_priv->staging_buffer->size;
+    return 0;
+}
+
+int ngli_texture_vk_upload_staging(struct texture *s)
+{
+    VkResult res = upload_staging_buffer(s);
+    if (res != VK_SUCCESS)
+        LOG(ERROR, "unable to upload texture: %s", ngli_vk_res2str(res));
+    return ngli_vk_res2ret(res);
+}
+
 int ngli_texture_vk_upload(struct texture *s, const uint8_t *data, int linesize)
 {
     VkResult res = texture_vk_upload(s, data, linesize);
@@ -700,15 +793,17 @@ static VkResult texture_vk_generate_mipmap(struct texture *s)
     ngli_assert(params->usage & NGLI_TEXTURE_USAGE_TRANSFER_SRC_BIT);
     ngli_assert(params->usage & NGLI_TEXTURE_USAGE_TRANSFER_DST_BIT);
 
+    VkResult res;
     struct cmd_vk *cmd_vk = gpu_ctx_vk->cur_cmd;
-    const int cmd_is_transient = cmd_vk ? 0 : 1;
-    if (cmd_is_transient) {
-        VkResult res = ngli_cmd_vk_begin_transient(s->gpu_ctx, 0, &cmd_vk);
+    if (!cmd_vk) {
+        res = ngli_cmd_vk_begin_transfer(s->gpu_ctx, &cmd_vk);
         if (res != VK_SUCCESS)
             return res;
     }
     VkCommandBuffer cmd_buf = cmd_vk->cmd_buf;
-    NGLI_CMD_VK_REF(cmd_vk, s);
+    res = NGLI_CMD_VK_REF(cmd_vk, s);
+    if (res != VK_SUCCESS)
+        return res;
 
     const VkImageSubresourceRange subres_range = {
         .aspectMask     = get_vk_image_aspect_flags(s_priv->format),
@@ -813,12 +908,6 @@ static VkResult texture_vk_generate_mipmap(struct texture *s)
                          0, NULL,
                          1, &barrier);
 
-    if (cmd_is_transient) {
-        VkResult res = ngli_cmd_vk_execute_transient(&cmd_vk);
-        if (res != VK_SUCCESS)
-            return res;
-    }
-
     return VK_SUCCESS;
 }
 
@@ -852,6 +941,8 @@ void ngli_texture_vk_freep(struct texture **sp)
     if (s_priv->staging_buffer_ptr)
         ngli_buffer_unmap(s_priv->staging_buffer);
     ngli_buffer_freep(&s_priv->staging_buffer);
+    free_staging_spares(s_priv);
+    ngli_darray_reset(&s_priv->staging_spares);
 
     ngli_freep(sp);
 }
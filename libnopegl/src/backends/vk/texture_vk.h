@@ -25,6 +25,7 @@
 #include <vulkan/vulkan.h>
 
 #include "buffer.h"
+#include "darray.h"
 #include "texture.h"
 #include "vkcontext.h"
 #include "ycbcr_sampler_vk.h"
@@ -58,12 +59,15 @@ struct texture_vk {
     struct buffer *staging_buffer;
     VkDeviceSize staging_buffer_row_length;
     void *staging_buffer_ptr;
+    struct darray staging_spares; // struct buffer *, previous staging buffers still used by pending copies
 };
 
 struct texture *ngli_texture_vk_create(struct gpu_ctx *gpu_ctx);
 int ngli_texture_vk_init(struct texture *s, const struct texture_params *params);
 VkResult ngli_texture_vk_wrap(struct texture *s, const struct texture_vk_wrap_params *wrap_params);
 int ngli_texture_vk_upload(struct texture *s, const uint8_t *data, int linesize);
+int ngli_texture_vk_map_staging(struct texture *s, int linesize, uint8_t **datap, size_t *sizep);
+int ngli_texture_vk_upload_staging(struct texture *s);
 int ngli_texture_vk_generate_mipmap(struct texture *s);
 void ngli_texture_vk_transition_layout(struct texture *s, VkImageLayout layout);
 void ngli_texture_vk_transition_to_default_layout(struct texture *s);
@@ -250,6 +250,27 @@ void ngli_block_field_copy_count(const struct block_field *fi, uint8_t * restric
     }
 }
 
+int ngli_block_field_update_count(const struct block_field *fi, uint8_t * restrict dst, const uint8_t * restrict src, size_t count)
+{
+    const int is_mat3 = fi->type == NGLI_TYPE_MAT3;
+    const size_t dst_stride = is_mat3 ? fi->stride / 3 : fi->stride;
+    const size_t src_stride = sizes_map[is_mat3 ? NGLI_TYPE_VEC3 : fi->type];
+    const size_t n = (is_mat3 ? 3 : 1) * NGLI_MAX(count ? count : fi->count, 1);
+
+    int updated = 0;
+    uint8_t *dstp = dst;
+    const uint8_t *srcp = src;
+    for (size_t i = 0; i < n; i++) {
+        if (memcmp(dstp, srcp, src_stride)) {
+            memcpy(dstp, srcp, src_stride);
+            updated = 1;
+        }
+        dstp += dst_stride;
+        srcp += src_stride;
+    }
+    return updated;
+}
+
 void ngli_block_field_copy(const struct block_field *fi, uint8_t *dst, const uint8_t *src)
 {
     ngli_block_field_copy_count(fi, dst, src, 0);
@@ -49,6 +49,12 @@ struct block_field {
 void ngli_block_field_copy(const struct block_field *fi, uint8_t *dst, const uint8_t *src);
 void ngli_block_field_copy_count(const struct block_field *fi, uint8_t *dst, const uint8_t *src, size_t count);
 
+/*
+ * Same as ngli_block_field_copy_count() but only write the elements of dst
+ * that differ from src. Return 1 if dst has been modified, 0 otherwise.
+ */
+int ngli_block_field_update_count(const struct block_field *fi, uint8_t *dst, const uint8_t *src, size_t count);
+
 struct block {
     struct gpu_ctx *gpu_ctx;
     enum block_layout layout;
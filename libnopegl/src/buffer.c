@@ -30,7 +30,10 @@ static void buffer_freep(struct buffer **sp)
     if (!*sp)
         return;
 
-    (*sp)->gpu_ctx->cls->buffer_freep(sp);
+    struct gpu_ctx *gpu_ctx = (*sp)->gpu_ctx;
+    gpu_ctx->memory_usage -= (*sp)->memory_size;
+    gpu_ctx->buffer_memory -= (*sp)->memory_size;
+    gpu_ctx->cls->buffer_freep(sp);
 }
 
 struct buffer *ngli_buffer_create(struct gpu_ctx *gpu_ctx)
@@ -45,11 +48,21 @@ int ngli_buffer_init(struct buffer *s, size_t size, int usage)
     s->size = size;
     s->usage = usage;
 
-    return s->gpu_ctx->cls->buffer_init(s);
+    int ret = s->gpu_ctx->cls->buffer_init(s);
+    if (ret < 0)
+        return ret;
+
+    /* The backend may reserve more than the requested size */
+    if (!s->memory_size)
+        s->memory_size = size;
+    s->gpu_ctx->memory_usage += s->memory_size;
+    s->gpu_ctx->buffer_memory += s->memory_size;
+    return 0;
 }
 
 int ngli_buffer_upload(struct buffer *s, const void *data, size_t offset, size_t size)
 {
+    s->gpu_ctx->upload_size += size;
     return s->gpu_ctx->cls->buffer_upload(s, data, offset, size);
 }
 
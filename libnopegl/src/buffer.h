@@ -46,6 +46,7 @@ struct buffer {
     struct gpu_ctx *gpu_ctx;
     size_t size;
     int usage;
+    uint64_t memory_size; /* accounted in gpu_ctx.memory_usage */
 };
 
 NGLI_RC_CHECK_STRUCT(buffer);
@@ -0,0 +1,205 @@
+/*
+ * Copyright 2024 Nope Forge
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <string.h>
+
+#include "copy_pool.h"
+#include "cpu.h"
+#include "memory.h"
+#include "pthread_compat.h"
+#include "utils.h"
+
+/*
+ * Handing the copies to the sleeping workers and waiting for them costs in the
+ * order of 10µs, which is what a single memcpy() takes to copy about 100kB:
+ * below half a megabyte (smaller than a 480p NV12 frame), the gain does not
+ * outweigh this fixed cost.
+ */
+#define MIN_THREADED_COPY_SIZE (512 << 10)
+#define MAX_COPY_JOBS 4
+
+/*
+ * Each copy job works on a contiguous range of the planes laid out one after
+ * the other.
+ */
+struct copy_job {
+    const struct plane_copy *copies;
+    size_t nb_copies;
+    size_t start;
+    size_t end;
+};
+
+struct worker {
+    struct copy_pool *pool;
+    int index;
+    pthread_t tid;
+};
+
+struct copy_pool {
+    int started;
+    int nb_workers;
+    struct worker workers[MAX_COPY_JOBS - 1];
+    pthread_mutex_t lock;
+    pthread_cond_t work_cond;
+    pthread_cond_t done_cond;
+    uint64_t generation;
+    int nb_jobs;
+    int nb_pending;
+    int quit;
+    struct copy_job jobs[MAX_COPY_JOBS];
+};
+
+static void copy_planes(const struct copy_job *job)
+{
+    size_t offset = 0;
+    for (size_t i = 0; i < job->nb_copies; i++) {
+        const struct plane_copy *copy = &job->copies[i];
+        const size_t start = NGLI_MAX(job->start, offset);
+        const size_t end = NGLI_MIN(job->end, offset + copy->size);
+        if (start < end)
+            memcpy(copy->dst + start - offset, copy->src + start - offset, end - start);
+        offset += copy->size;
+    }
+}
+
+static void *worker_thread(void *arg)
+{
+    struct worker *worker = arg;
+    struct copy_pool *s = worker->pool;
+
+    /* Job 0 is always run by the calling thread */
+    const int job_index = worker->index + 1;
+    uint64_t generation = 0;
+
+    pthread_mutex_lock(&s->lock);
+    for (;;) {
+        while (!s->quit && s->generation == generation)
+            pthread_cond_wait(&s->work_cond, &s->lock);
+        if (s->quit)
+            break;
+        generation = s->generation;
+        if (job_index >= s->nb_jobs)
+            continue;
+
+        pthread_mutex_unlock(&s->lock);
+        copy_planes(&s->jobs[job_index]);
+        pthread_mutex_lock(&s->lock);
+
+        if (--s->nb_pending == 0)
+            pthread_cond_signal(&s->done_cond);
+    }
+    pthread_mutex_unlock(&s->lock);
+
+    return NULL;
+}
+
+static void start_workers(struct copy_pool *s)
+{
+    s->started = 1;
+
+    const int nb_workers = NGLI_MIN(ngli_cpu_count(), MAX_COPY_JOBS) - 1;
+    if (nb_workers <= 0)
+        return;
+
+    for (int i = 0; i < nb_workers; i++) {
+        struct worker *worker = &s->workers[i];
+        worker->pool = s;
+        worker->index = i;
+        if (pthread_create(&worker->tid, NULL, worker_thread, worker))
+            break;
+        s->nb_workers++;
+    }
+}
+
+struct copy_pool *ngli_copy_pool_create(void)
+{
+    struct copy_pool *s = ngli_calloc(1, sizeof(*s));
+    if (!s)
+        return NULL;
+    pthread_mutex_init(&s->lock, NULL);
+    pthread_cond_init(&s->work_cond, NULL);
+    pthread_cond_init(&s->done_cond, NULL);
+    return s;
+}
+
+void ngli_copy_pool_run(struct copy_pool *s, const struct plane_copy *copies, size_t nb_copies)
+{
+    size_t total_size = 0;
+    for (size_t i = 0; i < nb_copies; i++)
+        total_size += copies[i].size;
+
+    if (total_size >= MIN_THREADED_COPY_SIZE && !s->started)
+        start_workers(s);
+
+    int nb_jobs = 1;
+    if (total_size >= MIN_THREADED_COPY_SIZE)
+        nb_jobs = s->nb_workers + 1;
+
+    struct copy_job jobs[MAX_COPY_JOBS];
+    for (int i = 0; i < nb_jobs; i++) {
+        jobs[i] = (struct copy_job){
+            .copies    = copies,
+            .nb_copies = nb_copies,
+            .start     = total_size * i / nb_jobs,
+            .end       = total_size * (i + 1) / nb_jobs,
+        };
+    }
+
+    if (nb_jobs == 1) {
+        copy_planes(&jobs[0]);
+        return;
+    }
+
+    pthread_mutex_lock(&s->lock);
+    memcpy(s->jobs, jobs, nb_jobs * sizeof(*jobs));
+    s->nb_jobs = nb_jobs;
+    s->nb_pending = nb_jobs - 1;
+    s->generation++;
+    pthread_cond_broadcast(&s->work_cond);
+    pthread_mutex_unlock(&s->lock);
+
+    copy_planes(&jobs[0]);
+
+    pthread_mutex_lock(&s->lock);
+    while (s->nb_pending)
+        pthread_cond_wait(&s->done_cond, &s->lock);
+    pthread_mutex_unlock(&s->lock);
+}
+
+void ngli_copy_pool_freep(struct copy_pool **sp)
+{
+    struct copy_pool *s = *sp;
+    if (!s)
+        return;
+
+    pthread_mutex_lock(&s->lock);
+    s->quit = 1;
+    pthread_cond_broadcast(&s->work_cond);
+    pthread_mutex_unlock(&s->lock);
+    for (int i = 0; i < s->nb_workers; i++)
+        pthread_join(s->workers[i].tid, NULL);
+
+    pthread_cond_destroy(&s->done_cond);
+    pthread_cond_destroy(&s->work_cond);
+    pthread_mutex_destroy(&s->lock);
+
+    ngli_freep(sp);
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright 2024 Nope Forge
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef COPY_POOL_H
+#define COPY_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct plane_copy {
+    uint8_t *dst;
+    const uint8_t *src;
+    size_t size;
+};
+
+/*
+ * Pool of persistent worker threads splitting large plane copies into
+ * contiguous ranges. The workers are spawned the first time a copy is large
+ * enough to be threaded and are joined when the pool is freed.
+ */
+struct copy_pool;
+
+struct copy_pool *ngli_copy_pool_create(void);
+void ngli_copy_pool_run(struct copy_pool *s, const struct plane_copy *copies, size_t nb_copies);
+void ngli_copy_pool_freep(struct copy_pool **sp);
+
+#endif
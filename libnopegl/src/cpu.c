@@ -0,0 +1,122 @@
+/*
+ * Copyright 2024 Nope Forge
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "config.h"
+
+#if defined(TARGET_WINDOWS)
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#if defined(HAVE_X86_INTR)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+#include "cpu.h"
+
+#if defined(HAVE_X86_INTR)
+static void get_cpuid(uint32_t leaf, uint32_t subleaf, uint32_t *regs)
+{
+#if defined(_MSC_VER)
+    int r[4];
+    __cpuidex(r, (int)leaf, (int)subleaf);
+    for (int i = 0; i < 4; i++)
+        regs[i] = (uint32_t)r[i];
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+static uint64_t get_xcr0(void)
+{
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    uint32_t eax, edx;
+    __asm__ volatile ("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (uint64_t)edx << 32 | eax;
+#endif
+}
+
+static uint32_t get_x86_flags(void)
+{
+    uint32_t flags = 0;
+    uint32_t regs[4]; // eax, ebx, ecx, edx
+
+    get_cpuid(0, 0, regs);
+    const uint32_t max_leaf = regs[0];
+    if (max_leaf < 1)
+        return 0;
+
+    get_cpuid(1, 0, regs);
+    if (regs[3] & (1U << 25))
+        flags |= NGLI_CPU_FLAG_SSE;
+
+    /*
+     * The AVX registers are only usable if the OS saves them across context
+     * switches (OSXSAVE set and XMM/YMM state enabled in XCR0)
+     */
+    const int has_osxsave = regs[2] & (1U << 27);
+    const int has_avx     = regs[2] & (1U << 28);
+    if (!has_osxsave || !has_avx || (get_xcr0() & 0x6) != 0x6)
+        return flags;
+
+    if (max_leaf >= 7) {
+        get_cpuid(7, 0, regs);
+        if (regs[1] & (1U << 5))
+            flags |= NGLI_CPU_FLAG_AVX2;
+    }
+
+    return flags;
+}
+#endif
+
+uint32_t ngli_cpu_get_flags(void)
+{
+#if defined(HAVE_X86_INTR)
+    return get_x86_flags();
+#elif defined(ARCH_AARCH64)
+    /* Advanced SIMD is mandatory on AArch64 */
+    return NGLI_CPU_FLAG_NEON;
+#else
+    return 0;
+#endif
+}
+
+int ngli_cpu_count(void)
+{
+#if defined(TARGET_WINDOWS)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    const long n = (long)info.dwNumberOfProcessors;
+#elif defined(_SC_NPROCESSORS_ONLN)
+    const long n = sysconf(_SC_NPROCESSORS_ONLN);
+#else
+    const long n = 1;
+#endif
+    return n > 0 ? (int)n : 1;
+}
@@ -0,0 +1,37 @@
+/*
+ * Copyright 2024 Nope Forge
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef CPU_H
+#define CPU_H
+
+#include <stdint.h>
+
+#define NGLI_CPU_FLAG_SSE  (1 << 0)
+#define NGLI_CPU_FLAG_AVX2 (1 << 1)
+#define NGLI_CPU_FLAG_NEON (1 << 2)
+
+/* Detect the SIMD features available on the running CPU (any of NGLI_CPU_FLAG_*) */
+uint32_t ngli_cpu_get_flags(void);
+
+/* Number of logical CPUs available to the process (at least 1) */
+int ngli_cpu_count(void);
+
+#endif
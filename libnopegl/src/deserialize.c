@@ -24,12 +24,29 @@
 #include <stdio.h>
 #include <string.h>
 
+#include "cpu.h"
 #include "darray.h"
 #include "log.h"
 #include "memory.h"
 #include "nopegl.h"
 #include "internal.h"
 #include "params.h"
+#include "pthread_compat.h"
+#include "utils.h"
+
+/*
+ * The scene is deserialized in 3 passes:
+ * - the lines are split and all the nodes are created sequentially
+ * - the parameters of each node are parsed and set in parallel, except the
+ *   node references which are only validated and recorded
+ * - the node references are set sequentially in the scene order (node
+ *   reference counting is not thread safe)
+ */
+struct parse_ctx {
+    struct ngl_node **nodes; // all the nodes of the scene
+    size_t index;            // index of the node being parsed
+    int link;                // whether the node references must be set
+};
 
 static int parse_i32(const char *s, int32_t *valp)
 {
@@ -191,13 +208,11 @@ static int parse_kvs(const char *s, size_t *nb_kvsp, char ***keysp, size_t **val
     return consumed;
 }
 
-static struct ngl_node **get_abs_node(struct darray *nodes_array, size_t id)
+static struct ngl_node **get_abs_node(const struct parse_ctx *ctx, size_t id)
 {
-    const size_t index = ngli_darray_count(nodes_array) - id - 1;
-    if (index >= ngli_darray_count(nodes_array))
+    if (id > ctx->index)
         return NULL;
-    struct ngl_node **nodes = ngli_darray_data(nodes_array);
-    return &nodes[index];
+    return &ctx->nodes[ctx->index - id];
 }
 
 static const uint8_t hexm[256] = {
@@ -210,7 +225,7 @@ static const uint8_t hexm[256] = {
 #define CHR_FROM_HEX(s) ((uint8_t)(hexm[(uint8_t)(s)[0]]<<4 | hexm[(uint8_t)(s)[1]]))
 
 #define DEFINE_LITERAL_PARSE_FUNC(parse_func, type, set_type)                       \
-static int parse_param_##set_type(struct darray *nodes_array, uint8_t *dstp,        \
+static int parse_param_##set_type(const struct parse_ctx *ctx, uint8_t *dstp,        \
                                   const struct node_param *par, const char *str)    \
 {                                                                                   \
     type v;                                                                         \
@@ -230,7 +245,7 @@ DEFINE_LITERAL_PARSE_FUNC(parse_f32,    float,    f32)
 DEFINE_LITERAL_PARSE_FUNC(parse_f64,    double,   f64)
 
 #define DEFINE_VEC_PARSE_FUNC(parse_func, type, set_type, expected_nb_vals)         \
-static int parse_param_##set_type(struct darray *nodes_array, uint8_t *dstp,        \
+static int parse_param_##set_type(const struct parse_ctx *ctx, uint8_t *dstp,        \
                                   const struct node_param *par, const char *str)    \
 {                                                                                   \
     size_t nb_vals;                                                                 \
@@ -258,7 +273,7 @@ DEFINE_VEC_PARSE_FUNC(parse_f32s,   float,    vec3,  3)
 DEFINE_VEC_PARSE_FUNC(parse_f32s,   float,    vec4,  4)
 DEFINE_VEC_PARSE_FUNC(parse_f32s,   float,    mat4, 16)
 
-static int parse_param_rational(struct darray *nodes_array, uint8_t *dstp,
+static int parse_param_rational(const struct parse_ctx *ctx, uint8_t *dstp,
                                 const struct node_param *par, const char *str)
 {
     int32_t r[2] = {0};
@@ -272,7 +287,7 @@ static int parse_param_rational(struct darray *nodes_array, uint8_t *dstp,
     return len;
 }
 
-static int parse_param_flags(struct darray *nodes_array, uint8_t *dstp,
+static int parse_param_flags(const struct parse_ctx *ctx, uint8_t *dstp,
                              const struct node_param *par, const char *str)
 {
     const size_t len = strcspn(str, " \n");
@@ -290,7 +305,7 @@ static int parse_param_flags(struct darray *nodes_array, uint8_t *dstp,
     return (int)len;
 }
 
-static int parse_param_select(struct darray *nodes_array, uint8_t *dstp,
+static int parse_param_select(const struct parse_ctx *ctx, uint8_t *dstp,
                               const struct node_param *par, const char *str)
 {
     const size_t len = strcspn(str, " \n");
@@ -308,7 +323,7 @@ static int parse_param_select(struct darray *nodes_array, uint8_t *dstp,
     return (int)len;
 }
 
-static int parse_param_str(struct darray *nodes_array, uint8_t *dstp,
+static int parse_param_str(const struct parse_ctx *ctx, uint8_t *dstp,
                            const struct node_param *par, const char *str)
 {
     const size_t len = strcspn(str, " \n");
@@ -334,7 +349,7 @@ static int parse_param_str(struct darray *nodes_array, uint8_t *dstp,
     return (int)len;
 }
 
-static int parse_param_data(struct darray *nodes_array, uint8_t *dstp,
+static int parse_param_data(const struct parse_ctx *ctx, uint8_t *dstp,
                             const struct node_param *par, const char *str)
 {
     size_t size = 0;
@@ -363,23 +378,25 @@ static int parse_param_data(struct darray *nodes_array, uint8_t *dstp,
     return (int)(cur - str);
 }
 
-static int parse_param_node(struct darray *nodes_array, uint8_t *dstp,
+static int parse_param_node(const struct parse_ctx *ctx, uint8_t *dstp,
                             const struct node_param *par, const char *str)
 {
     size_t node_id;
     const int len = parse_hexsize(str, &node_id);
     if (len < 0)
         return NGL_ERROR_INVALID_DATA;
-    struct ngl_node **nodep = get_abs_node(nodes_array, node_id);
+    struct ngl_node **nodep = get_abs_node(ctx, node_id);
     if (!nodep)
         return NGL_ERROR_INVALID_DATA;
+    if (!ctx->link)
+        return len;
     int ret = ngli_params_set_node(dstp, par, *nodep);
     if (ret < 0)
         return ret;
     return len;
 }
 
-static int parse_param_nodelist(struct darray *nodes_array, uint8_t *dstp,
+static int parse_param_nodelist(const struct parse_ctx *ctx, uint8_t *dstp,
                                 const struct node_param *par, const char *str)
 {
     size_t *node_ids;
@@ -388,11 +405,13 @@ static int parse_param_nodelist(struct darray *nodes_array, uint8_t *dstp,
     if (len < 0)
         return len;
     for (size_t i = 0; i < nb_node_ids; i++) {
-        struct ngl_node **nodep = get_abs_node(nodes_array, node_ids[i]);
+        struct ngl_node **nodep = get_abs_node(ctx, node_ids[i]);
         if (!nodep) {
             ngli_free(node_ids);
             return NGL_ERROR_INVALID_DATA;
         }
+        if (!ctx->link)
+            continue;
         int ret = ngli_params_add_nodes(dstp, par, 1, nodep);
         if (ret < 0) {
             ngli_free(node_ids);
@@ -403,7 +422,7 @@ static int parse_param_nodelist(struct darray *nodes_array, uint8_t *dstp,
     return len;
 }
 
-static int parse_param_f64list(struct darray *nodes_array, uint8_t *dstp,
+static int parse_param_f64list(const struct parse_ctx *ctx, uint8_t *dstp,
                                const struct node_param *par, const char *str)
 {
     double *dbls;
@@ -418,7 +437,7 @@ static int parse_param_f64list(struct darray *nodes_array, uint8_t *dstp,
     return len;
 }
 
-static int parse_param_nodedict(struct darray *nodes_array, uint8_t *dstp,
+static int parse_param_nodedict(const struct parse_ctx *ctx, uint8_t *dstp,
                                 const struct node_param *par, const char *str)
 {
     char **node_keys;
@@ -428,11 +447,13 @@ static int parse_param_nodedict(struct darray *nodes_array, uint8_t *dstp,
         return len;
     for (size_t i = 0; i < nb_nodes; i++) {
         const char *key = node_keys[i];
-        struct ngl_node **nodep = get_abs_node(nodes_array, node_ids[i]);
+        struct ngl_node **nodep = get_abs_node(ctx, node_ids[i]);
         if (!nodep) {
             FREE_KVS(nb_nodes, node_keys, node_ids);
             return NGL_ERROR_INVALID_DATA;
         }
+        if (!ctx->link)
+            continue;
         int ret = ngli_params_set_dict(dstp, par, key, *nodep);
         if (ret < 0) {
             FREE_KVS(nb_nodes, node_keys, node_ids);
@@ -443,7 +464,7 @@ static int parse_param_nodedict(struct darray *nodes_array, uint8_t *dstp,
     return len;
 }
 
-static int parse_param(struct darray *nodes_array, uint8_t *base_ptr,
+static int parse_param(const struct parse_ctx *ctx, uint8_t *base_ptr,
                        const struct node_param *par, const char *str)
 {
     int len = -1;
@@ -451,48 +472,74 @@ static int parse_param(struct darray *nodes_array, uint8_t *base_ptr,
     uint8_t *dstp = base_ptr + par->offset;
 
     if ((par->flags & NGLI_PARAM_FLAG_ALLOW_NODE) && str[0] == '!') {
-        len = parse_param_node(nodes_array, dstp, par, str + 1);
+        len = parse_param_node(ctx, dstp, par, str + 1);
         if (len < 0)
             return len;
         return len + 1;
     }
 
     switch (par->type) {
-    case NGLI_PARAM_TYPE_I32:      len = parse_param_i32(nodes_array, dstp, par, str);      break;
-    case NGLI_PARAM_TYPE_U32:      len = parse_param_u32(nodes_array, dstp, par, str);      break;
-    case NGLI_PARAM_TYPE_BOOL:     len = parse_param_bool(nodes_array, dstp, par, str);     break;
-    case NGLI_PARAM_TYPE_F32:      len = parse_param_f32(nodes_array, dstp, par, str);      break;
-    case NGLI_PARAM_TYPE_F64:      len = parse_param_f64(nodes_array, dstp, par, str);      break;
-    case NGLI_PARAM_TYPE_RATIONAL: len = parse_param_rational(nodes_array, dstp, par, str); break;
-    case NGLI_PARAM_TYPE_FLAGS:    len = parse_param_flags(nodes_array, dstp, par, str);    break;
-    case NGLI_PARAM_TYPE_SELECT:   len = parse_param_select(nodes_array, dstp, par, str);   break;
-    case NGLI_PARAM_TYPE_STR:      len = parse_param_str(nodes_array, dstp, par, str);      break;
-    case NGLI_PARAM_TYPE_DATA:     len = parse_param_data(nodes_array, dstp, par, str);     break;
-    case NGLI_PARAM_TYPE_IVEC2:    len = parse_param_ivec2(nodes_array, dstp, par, str);    break;
-    case NGLI_PARAM_TYPE_IVEC3:    len = parse_param_ivec3(nodes_array, dstp, par, str);    break;
-    case NGLI_PARAM_TYPE_IVEC4:    len = parse_param_ivec4(nodes_array, dstp, par, str);    break;
-    case NGLI_PARAM_TYPE_UVEC2:    len = parse_param_uvec2(nodes_array, dstp, par, str);    break;
-    case NGLI_PARAM_TYPE_UVEC3:    len = parse_param_uvec3(nodes_array, dstp, par, str);    break;
-    case NGLI_PARAM_TYPE_UVEC4:    len = parse_param_uvec4(nodes_array, dstp, par, str);    break;
-    case NGLI_PARAM_TYPE_VEC2:     len = parse_param_vec2(nodes_array, dstp, par, str);     break;
-    case NGLI_PARAM_TYPE_VEC3:     len = parse_param_vec3(nodes_array, dstp, par, str);     break;
-    case NGLI_PARAM_TYPE_VEC4:     len = parse_param_vec4(nodes_array, dstp, par, str);     break;
-    case NGLI_PARAM_TYPE_MAT4:     len = parse_param_mat4(nodes_array, dstp, par, str);     break;
-    case NGLI_PARAM_TYPE_NODE:     len = parse_param_node(nodes_array, dstp, par, str);     break;
-    case NGLI_PARAM_TYPE_NODELIST: len = parse_param_nodelist(nodes_array, dstp, par, str); break;
-    case NGLI_PARAM_TYPE_F64LIST:  len = parse_param_f64list(nodes_array, dstp, par, str);  break;
-    case NGLI_PARAM_TYPE_NODEDICT: len = parse_param_nodedict(nodes_array, dstp, par, str); break;
+    case NGLI_PARAM_TYPE_I32:      len = parse_param_i32(ctx, dstp, par, str);      break;
+    case NGLI_PARAM_TYPE_U32:      len = parse_param_u32(ctx, dstp, par, str);      break;
+    case NGLI_PARAM_TYPE_BOOL:     len = parse_param_bool(ctx, dstp, par, str);     break;
+    case NGLI_PARAM_TYPE_F32:      len = parse_param_f32(ctx, dstp, par, str);      break;
+    case NGLI_PARAM_TYPE_F64:      len = parse_param_f64(ctx, dstp, par, str);      break;
+    case NGLI_PARAM_TYPE_RATIONAL: len = parse_param_rational(ctx, dstp, par, str); break;
+    case NGLI_PARAM_TYPE_FLAGS:    len = parse_param_flags(ctx, dstp, par, str);    break;
+    case NGLI_PARAM_TYPE_SELECT:   len = parse_param_select(ctx, dstp, par, str);   break;
+    case NGLI_PARAM_TYPE_STR:      len = parse_param_str(ctx, dstp, par, str);      break;
+    case NGLI_PARAM_TYPE_DATA:     len = parse_param_data(ctx, dstp, par, str);     break;
+    case NGLI_PARAM_TYPE_IVEC2:    len = parse_param_ivec2(ctx, dstp, par, str);    break;
+    case NGLI_PARAM_TYPE_IVEC3:    len = parse_param_ivec3(ctx, dstp, par, str);    break;
+    case NGLI_PARAM_TYPE_IVEC4:    len = parse_param_ivec4(ctx, dstp, par, str);    break;
+    case NGLI_PARAM_TYPE_UVEC2:    len = parse_param_uvec2(ctx, dstp, par, str);    break;
+    case NGLI_PARAM_TYPE_UVEC3:    len = parse_param_uvec3(ctx, dstp, par, str);    break;
+    case NGLI_PARAM_TYPE_UVEC4:    len = parse_param_uvec4(ctx, dstp, par, str);    break;
+    case NGLI_PARAM_TYPE_VEC2:     len = parse_param_vec2(ctx, dstp, par, str);     break;
+    case NGLI_PARAM_TYPE_VEC3:     len = parse_param_vec3(ctx, dstp, par, str);     break;
+    case NGLI_PARAM_TYPE_VEC4:     len = parse_param_vec4(ctx, dstp, par, str);     break;
+    case NGLI_PARAM_TYPE_MAT4:     len = parse_param_mat4(ctx, dstp, par, str);     break;
+    case NGLI_PARAM_TYPE_NODE:     len = parse_param_node(ctx, dstp, par, str);     break;
+    case NGLI_PARAM_TYPE_NODELIST: len = parse_param_nodelist(ctx, dstp, par, str); break;
+    case NGLI_PARAM_TYPE_F64LIST:  len = parse_param_f64list(ctx, dstp, par, str);  break;
+    case NGLI_PARAM_TYPE_NODEDICT: len = parse_param_nodedict(ctx, dstp, par, str); break;
     default:
-        LOG(ERROR, "cannot deserialize %s: unsupported parameter type", par->key);
+        len = NGL_ERROR_UNSUPPORTED;
     }
     return len;
 }
 
-static int set_node_params(struct darray *nodes_array, char *str,
-                           const struct ngl_node *node)
+static int is_node_ref(const struct node_param *par, const char *str)
 {
+    if ((par->flags & NGLI_PARAM_FLAG_ALLOW_NODE) && str[0] == '!')
+        return 1;
+    return par->type == NGLI_PARAM_TYPE_NODE ||
+           par->type == NGLI_PARAM_TYPE_NODELIST ||
+           par->type == NGLI_PARAM_TYPE_NODEDICT;
+}
+
+struct node_ref {
+    const struct node_param *par;
+    uint8_t *base_ptr;
+    const char *str;
+};
+
+struct node_record {
+    char *str;          // serialized parameters (nul-terminated line)
+    struct darray refs; // node references to set in the link pass (struct node_ref)
+};
+
+/*
+ * The parameters may be set from the parsing workers, so the errors are
+ * written in the err buffer instead of being logged
+ */
+static int set_node_params(const struct parse_ctx *ctx, struct node_record *rec,
+                           char *err, size_t err_size)
+{
+    const struct ngl_node *node = ctx->nodes[ctx->index];
     uint8_t *base_ptr = node->opts;
     const struct node_param *params = node->cls->params;
+    char *str = rec->str;
 
     if (!params)
         return 0;
@@ -505,19 +552,28 @@ static int set_node_params(struct darray *nodes_array, char *str,
 
         const struct node_param *par = ngli_node_param_find(node, str, &base_ptr);
         if (!par) {
-            LOG(ERROR, "unable to find parameter %s.%s",
-                node->cls->name, str);
+            snprintf(err, err_size, "unable to find parameter %s.%s",
+                     node->cls->name, str);
             return NGL_ERROR_INVALID_DATA;
         }
 
         str = eok + 1;
-        int ret = parse_param(nodes_array, base_ptr, par, str);
+        int ret = parse_param(ctx, base_ptr, par, str);
         if (ret < 0) {
-            LOG(ERROR, "unable to set node param %s.%s: %s",
-                node->cls->name, par->key, NGLI_RET_STR(ret));
+            snprintf(err, err_size, "unable to set node param %s.%s: %s",
+                     node->cls->name, par->key, NGLI_RET_STR(ret));
             return ret;
         }
 
+        if (is_node_ref(par, str)) {
+            const struct node_ref ref = {.par = par, .base_ptr = base_ptr, .str = str};
+            if (!ngli_darray_push(&rec->refs, &ref)) {
+                snprintf(err, err_size, "unable to record node param %s.%s",
+                         node->cls->name, par->key);
+                return NGL_ERROR_MEMORY;
+            }
+        }
+
         str += ret;
         if (*str != ' ')
             break;
@@ -527,14 +583,147 @@ static int set_node_params(struct darray *nodes_array, char *str,
     return 0;
 }
 
+static int link_node_params(const struct parse_ctx *ctx, struct node_record *rec)
+{
+    const struct ngl_node *node = ctx->nodes[ctx->index];
+    const struct node_ref *refs = ngli_darray_data(&rec->refs);
+    for (size_t i = 0; i < ngli_darray_count(&rec->refs); i++) {
+        const struct node_ref *ref = &refs[i];
+        int ret = parse_param(ctx, ref->base_ptr, ref->par, ref->str);
+        if (ret < 0) {
+            LOG(ERROR, "unable to set node param %s.%s: %s",
+                node->cls->name, ref->par->key, NGLI_RET_STR(ret));
+            return ret;
+        }
+    }
+    return 0;
+}
+
+/*
+ * The parsing threads are created for each scene: spawning and joining up to
+ * MAX_THREADS of them costs in the order of a millisecond, which is about the
+ * time needed to parse a few hundred kilobytes of parameters (numbers and
+ * hex encoded data are parsed at a few hundred MB/s). Below a megabyte, most
+ * of the gain would be lost in the thread management.
+ */
+#define MIN_THREADED_PARSE_SIZE (1 << 20)
+#define MAX_THREADS 16
+#define MAX_ERROR_SIZE 256
+
+struct parse_pool {
+    struct ngl_node **nodes;
+    struct node_record *records;
+    size_t nb_records;
+    size_t next;
+    int failed; // stop the remaining workers on the first error
+    /* First error in the scene order among the parsed nodes, logged by the
+     * calling thread */
+    int ret;
+    size_t error_index;
+    char error[MAX_ERROR_SIZE];
+    pthread_mutex_t lock;
+};
+
+static void *parse_worker(void *arg)
+{
+    struct parse_pool *pool = arg;
+    for (;;) {
+        pthread_mutex_lock(&pool->lock);
+        const size_t index = pool->failed ? pool->nb_records : pool->next++;
+        pthread_mutex_unlock(&pool->lock);
+        if (index >= pool->nb_records)
+            break;
+
+        const struct parse_ctx ctx = {.nodes = pool->nodes, .index = index};
+        char error[MAX_ERROR_SIZE];
+        int ret = set_node_params(&ctx, &pool->records[index], error, sizeof(error));
+        if (ret < 0) {
+            pthread_mutex_lock(&pool->lock);
+            pool->failed = 1;
+            if (!pool->ret || index < pool->error_index) {
+                pool->ret = ret;
+                pool->error_index = index;
+                snprintf(pool->error, sizeof(pool->error), "%s", error);
+            }
+            pthread_mutex_unlock(&pool->lock);
+        }
+    }
+    return NULL;
+}
+
+static int parse_records_threaded(struct ngl_node **nodes, struct node_record *records, size_t nb_records)
+{
+    struct parse_pool pool = {
+        .nodes      = nodes,
+        .records    = records,
+        .nb_records = nb_records,
+    };
+
+    const int nb_threads = (int)NGLI_MIN(NGLI_MIN(ngli_cpu_count(), MAX_THREADS), nb_records);
+
+    if (pthread_mutex_init(&pool.lock, NULL))
+        return NGL_ERROR_EXTERNAL;
+
+    /* The calling thread is one of the workers */
+    pthread_t tids[MAX_THREADS - 1];
+    int nb_started = 0;
+    for (int i = 0; i < nb_threads - 1; i++) {
+        if (pthread_create(&tids[i], NULL, parse_worker, &pool))
+            break;
+        nb_started++;
+    }
+    parse_worker(&pool);
+    for (int i = 0; i < nb_started; i++)
+        pthread_join(tids[i], NULL);
+
+    pthread_mutex_destroy(&pool.lock);
+
+    if (pool.ret < 0) {
+        LOG(ERROR, "%s", pool.error);
+        return pool.ret;
+    }
+
+    return 0;
+}
+
+static int parse_records(struct ngl_node **nodes, struct node_record *records,
+                         size_t nb_records, size_t data_size)
+{
+    if (data_size >= MIN_THREADED_PARSE_SIZE && nb_records > 1 && ngli_cpu_count() > 1) {
+        int ret = parse_records_threaded(nodes, records, nb_records);
+        if (ret < 0)
+            return ret;
+    } else {
+        for (size_t i = 0; i < nb_records; i++) {
+            const struct parse_ctx ctx = {.nodes = nodes, .index = i};
+            char error[MAX_ERROR_SIZE];
+            int ret = set_node_params(&ctx, &records[i], error, sizeof(error));
+            if (ret < 0) {
+                LOG(ERROR, "%s", error);
+                return ret;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < nb_records; i++) {
+        const struct parse_ctx ctx = {.nodes = nodes, .index = i, .link = 1};
+        int ret = link_node_params(&ctx, &records[i]);
+        if (ret < 0)
+            return ret;
+    }
+
+    return 0;
+}
+
 int ngli_scene_deserialize(struct ngl_scene *s, const char *str)
 {
     int ret = 0;
-    struct ngl_node *node = NULL;
     struct darray nodes_array;
+    struct darray records_array;
     struct ngl_scene_params params = ngl_scene_default_params(NULL);
 
     ngli_darray_init(&nodes_array, sizeof(struct ngl_node *), 0);
+    ngli_darray_init(&records_array, sizeof(struct node_record), 0);
 
     char *dupstr = ngli_strdup(str);
     if (!dupstr)
@@ -542,7 +731,6 @@ int ngli_scene_deserialize(struct ngl_scene *s, const char *str)
 
     char *sstart = dupstr;
     char *send = dupstr + strlen(dupstr);
-
     /* Parse header */
     int major, minor, micro;
     int n = sscanf(dupstr, "# Nope.GL v%d.%d.%d", &major, &minor, &micro);
@@ -601,14 +789,15 @@ int ngli_scene_deserialize(struct ngl_scene *s, const char *str)
             dupstr++;
     }
 
-    /* Parse nodes (1 line = 1 node) */
+    /* Split the nodes (1 line = 1 node) and create them */
+    size_t data_size = 0;
     while (dupstr < send - 4) {
         const int type = NGLI_FOURCC(dupstr[0], dupstr[1], dupstr[2], dupstr[3]);
         dupstr += 4;
         if (*dupstr == ' ')
             dupstr++;
 
-        node = ngl_node_create(type);
+        struct ngl_node *node = ngl_node_create(type);
         if (!node) {
             // Could be a memory error as well but it's more likely the node
             // type is wrong
@@ -622,28 +811,40 @@ int ngli_scene_deserialize(struct ngl_scene *s, const char *str)
             break;
         }
 
-        size_t eol = strcspn(dupstr, "\n");
-        dupstr[eol] = 0;
-
-        int ret = set_node_params(&nodes_array, dupstr, node);
-        if (ret < 0) {
-            node = NULL;
+        struct node_record *rec = ngli_darray_push(&records_array, NULL);
+        if (!rec) {
+            ret = NGL_ERROR_MEMORY;
             break;
         }
+        *rec = (struct node_record){.str = dupstr};
+        ngli_darray_init(&rec->refs, sizeof(struct node_ref), 0);
+
+        size_t eol = strcspn(dupstr, "\n");
+        dupstr[eol] = 0;
+        data_size += eol;
 
         dupstr += eol + 1;
     }
 
-    if (node) {
-        params.root = node;
+    /* Parse the nodes parameters */
+    struct ngl_node **nodes = ngli_darray_data(&nodes_array);
+    struct node_record *records = ngli_darray_data(&records_array);
+    const size_t nb_records = ngli_darray_count(&records_array);
+    if (ret >= 0)
+        ret = parse_records(nodes, records, nb_records, data_size);
+
+    if (ret >= 0 && nb_records) {
+        params.root = nodes[nb_records - 1];
         ret = ngl_scene_init(s, &params);
     }
 
-    struct ngl_node **nodes = ngli_darray_data(&nodes_array);
     for (size_t i = 0; i < ngli_darray_count(&nodes_array); i++)
         ngl_node_unrefp(&nodes[i]);
+    for (size_t i = 0; i < nb_records; i++)
+        ngli_darray_reset(&records[i].refs);
 
 end:
+    ngli_darray_reset(&records_array);
     ngli_darray_reset(&nodes_array);
     ngli_free(sstart);
     return ret;
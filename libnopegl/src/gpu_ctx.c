@@ -20,6 +20,7 @@
  * under the License.
  */
 
+#include <stdlib.h>
 #include <string.h>
 
 #include "gpu_ctx.h"
@@ -97,6 +98,16 @@ int ngli_gpu_ctx_init(struct gpu_ctx *s)
     if (ret < 0)
         return ret;
 
+    /* Allow to lower the push constants limit to exercise the uniform blocks fallback */
+    const char *max_push_constants_size = getenv("NGL_MAX_PUSH_CONSTANTS_SIZE");
+    if (max_push_constants_size) {
+        const long size = strtol(max_push_constants_size, NULL, 0);
+        if (size >= 0 && size < s->limits.max_push_constants_size) {
+            LOG(DEBUG, "lower push constants size limit to %ld", size);
+            s->limits.max_push_constants_size = (uint32_t)size;
+        }
+    }
+
     const struct gpu_limits *limits = &s->limits;
     s->vertex_buffers = ngli_calloc(limits->max_vertex_attributes, sizeof(struct buffer *));
     if (!s->vertex_buffers)
@@ -119,6 +130,11 @@ int ngli_gpu_ctx_set_capture_buffer(struct gpu_ctx *s, void *capture_buffer)
 
 int ngli_gpu_ctx_begin_update(struct gpu_ctx *s, double t)
 {
+    s->nb_draws = 0;
+    s->nb_dispatches = 0;
+    s->nb_pipeline_binds = 0;
+    s->nb_render_passes = 0;
+    s->upload_size = 0;
     return s->cls->begin_update(s, t);
 }
 
@@ -179,6 +195,7 @@ void ngli_gpu_ctx_begin_render_pass(struct gpu_ctx *s, struct rendertarget *rt)
     ngli_assert(!s->rendertarget);
 
     s->rendertarget = rt;
+    s->nb_render_passes++;
     s->cls->begin_render_pass(s, rt);
 }
 
@@ -246,6 +263,7 @@ uint32_t ngli_gpu_ctx_get_format_features(struct gpu_ctx *s, int format)
 void ngli_gpu_ctx_set_pipeline(struct gpu_ctx *s, struct pipeline *pipeline)
 {
     s->pipeline = pipeline;
+    s->nb_pipeline_binds++;
     s->cls->set_pipeline(s, pipeline);
 }
 
@@ -260,6 +278,14 @@ void ngli_gpu_ctx_set_bindgroup(struct gpu_ctx *s, struct bindgroup *bindgroup,
     s->cls->set_bindgroup(s, bindgroup, offsets, nb_offsets);
 }
 
+void ngli_gpu_ctx_set_push_constants(struct gpu_ctx *s, const void *data, size_t size)
+{
+    ngli_assert(size <= s->limits.max_push_constants_size);
+    if (size)
+        memcpy(s->push_constants, data, size);
+    s->push_constants_size = size;
+}
+
 static void validate_vertex_buffers(struct gpu_ctx *s)
 {
     const struct pipeline *pipeline = s->pipeline;
@@ -279,6 +305,7 @@ void ngli_gpu_ctx_draw(struct gpu_ctx *s, int nb_vertices, int nb_instances)
     const struct bindgroup_layout *b_layout = s->bindgroup->layout;
     ngli_assert(ngli_bindgroup_layout_is_compatible(p_layout, b_layout));
 
+    s->nb_draws++;
     s->cls->draw(s, nb_vertices, nb_instances);
 }
 
@@ -291,6 +318,7 @@ void ngli_gpu_ctx_draw_indexed(struct gpu_ctx *s, int nb_indices, int nb_instanc
     const struct bindgroup_layout *b_layout = s->bindgroup->layout;
     ngli_assert(ngli_bindgroup_layout_is_compatible(p_layout, b_layout));
 
+    s->nb_draws++;
     s->cls->draw_indexed(s, nb_indices, nb_instances);
 }
 
@@ -302,6 +330,7 @@ void ngli_gpu_ctx_dispatch(struct gpu_ctx *s, uint32_t nb_group_x, uint32_t nb_g
     const struct bindgroup_layout *b_layout = s->bindgroup->layout;
     ngli_assert(ngli_bindgroup_layout_is_compatible(p_layout, b_layout));
 
+    s->nb_dispatches++;
     s->cls->dispatch(s, nb_group_x, nb_group_y, nb_group_z);
 }
 
@@ -123,6 +123,8 @@ struct gpu_ctx_class {
     struct texture *(*texture_create)(struct gpu_ctx *ctx);
     int (*texture_init)(struct texture *s, const struct texture_params *params);
     int (*texture_upload)(struct texture *s, const uint8_t *data, int linesize);
+    int (*texture_map_staging)(struct texture *s, int linesize, uint8_t **datap, size_t *sizep);
+    int (*texture_upload_staging)(struct texture *s);
     int (*texture_generate_mipmap)(struct texture *s);
     void (*texture_freep)(struct texture **sp);
 };
@@ -137,6 +139,19 @@ struct gpu_ctx {
     uint64_t features;
     struct gpu_limits limits;
 
+    /* Estimated memory of the GPU objects allocated by the context */
+    uint64_t memory_usage;
+    uint64_t texture_memory;
+    uint64_t buffer_memory;
+    uint64_t program_memory;
+
+    /* Commands recorded since the start of the frame (see ngl_stats) */
+    uint64_t nb_draws;
+    uint64_t nb_dispatches;
+    uint64_t nb_pipeline_binds;
+    uint64_t nb_render_passes;
+    uint64_t upload_size;
+
 #if DEBUG_GPU_CAPTURE
     struct gpu_capture_ctx *gpu_capture_ctx;
     int gpu_capture;
@@ -148,6 +163,8 @@ struct gpu_ctx {
     struct bindgroup *bindgroup;
     uint32_t dynamic_offsets[NGLI_MAX_DYNAMIC_OFFSETS];
     size_t nb_dynamic_offsets;
+    uint8_t push_constants[NGLI_MAX_PUSH_CONSTANTS_SIZE];
+    size_t push_constants_size;
     const struct buffer **vertex_buffers;
     const struct buffer *index_buffer;
     int index_format;
@@ -189,6 +206,7 @@ uint32_t ngli_gpu_ctx_get_format_features(struct gpu_ctx *s, int format);
 
 void ngli_gpu_ctx_set_pipeline(struct gpu_ctx *s, struct pipeline *pipeline);
 void ngli_gpu_ctx_set_bindgroup(struct gpu_ctx *s, struct bindgroup *bindgroup, const uint32_t *offsets, size_t nb_offsets);
+void ngli_gpu_ctx_set_push_constants(struct gpu_ctx *s, const void *data, size_t size);
 void ngli_gpu_ctx_draw(struct gpu_ctx *s, int nb_vertices, int nb_instances);
 void ngli_gpu_ctx_draw_indexed(struct gpu_ctx *s, int nb_indices, int nb_instances);
 void ngli_gpu_ctx_dispatch(struct gpu_ctx *s, uint32_t nb_group_x, uint32_t nb_group_y, uint32_t nb_group_z);
@@ -33,6 +33,8 @@
 
 #define NGLI_MAX_COLOR_ATTACHMENTS 8
 
+#define NGLI_MAX_PUSH_CONSTANTS_SIZE 256
+
 struct gpu_limits {
     uint32_t max_vertex_attributes;
     uint32_t max_texture_image_units;
@@ -53,6 +55,7 @@ struct gpu_limits {
     uint32_t max_texture_array_layers;
     uint32_t max_color_attachments;
     uint32_t max_draw_buffers;
+    uint32_t max_push_constants_size; // 0 if push constants are not supported
 };
 
 #endif
@@ -103,6 +103,7 @@ enum {
     MEMORY_BLOCKS_CPU,
     MEMORY_BLOCKS_GPU,
     MEMORY_TEXTURES,
+    MEMORY_RESIDENT,
     NB_MEMORY
 };
 
@@ -198,6 +199,11 @@ static const struct {
         .node_types=(const uint32_t[]){NGL_NODE_TEXTURE2D, NGL_NODE_TEXTURE3D, NGLI_NODE_NONE},
         .color=0xFF3232FF,
     },
+    [MEMORY_RESIDENT] = {
+        .label="Resident GPU",
+        .node_types=(const uint32_t[]){NGLI_NODE_NONE},
+        .color=0x32FFFFFF,
+    },
 };
 
 static const struct activity_spec {
@@ -461,6 +467,9 @@ static void widget_memory_make_stats(struct hud *s, struct widget *widget)
         priv->sizes[MEMORY_TEXTURES] += ngli_image_get_memory_size(&texture->image)
                                       * tex_node->is_active;
     }
+
+    /* GPU memory held by the inactive nodes kept resident (see gpu_memory_budget) */
+    priv->sizes[MEMORY_RESIDENT] = ngli_node_get_resident_memory(s->ctx);
 }
 
 static void widget_activity_make_stats(struct hud *s, struct widget *widget)
@@ -24,6 +24,7 @@
 #include <string.h>
 #include <nopemd.h>
 
+#include "copy_pool.h"
 #include "format.h"
 #include "hwmap.h"
 #include "image.h"
@@ -37,6 +38,7 @@ struct hwmap_common {
     int32_t height;
     size_t nb_planes;
     struct texture *planes[4];
+    int use_staging;
 };
 
 static const struct format_desc {
@@ -237,6 +239,7 @@ static int common_init(struct hwmap *hwmap, struct nmd_frame *frame)
     ngli_image_init(&hwmap->mapped_image, &image_params, common->planes);
 
     hwmap->require_hwconv = !support_direct_rendering(hwmap, desc);
+    common->use_staging = 1;
 
     return 0;
 }
@@ -249,10 +252,57 @@ static void common_uninit(struct hwmap *hwmap)
         ngli_texture_freep(&common->planes[i]);
 }
 
+static int map_frame_staging(struct hwmap *hwmap, struct nmd_frame *frame)
+{
+    struct ngl_ctx *ctx = hwmap->ctx;
+    struct hwmap_common *common = hwmap->hwmap_priv_data;
+
+    struct plane_copy copies[4] = {0};
+    for (size_t i = 0; i < common->nb_planes; i++) {
+        struct texture *plane = common->planes[i];
+        struct texture_params *params = &plane->params;
+        const int linesize = frame->linesizep[i] / ngli_format_get_bytes_per_pixel(params->format);
+        int ret = ngli_texture_map_staging(plane, linesize, &copies[i].dst, &copies[i].size);
+        if (ret < 0)
+            return ret;
+        copies[i].src = frame->datap[i];
+    }
+
+    /* The pool is shared by all the media of the context */
+    if (!ctx->copy_pool) {
+        ctx->copy_pool = ngli_copy_pool_create();
+        if (!ctx->copy_pool)
+            return NGL_ERROR_MEMORY;
+    }
+
+    ngli_copy_pool_run(ctx->copy_pool, copies, common->nb_planes);
+
+    for (size_t i = 0; i < common->nb_planes; i++) {
+        int ret = ngli_texture_upload_staging(common->planes[i]);
+        if (ret < 0)
+            return ret;
+    }
+
+    return 0;
+}
+
 static int common_map_frame(struct hwmap *hwmap, struct nmd_frame *frame)
 {
     struct hwmap_common *common = hwmap->hwmap_priv_data;
 
+    /*
+     * When the backend supports it, the planes are copied to the staging
+     * memory on worker threads so the render thread only has to record the
+     * transfers. Otherwise (OpenGL), the planes are directly uploaded from the
+     * frame memory.
+     */
+    if (common->use_staging) {
+        int ret = map_frame_staging(hwmap, frame);
+        if (ret != NGL_ERROR_UNSUPPORTED)
+            return ret;
+        common->use_staging = 0;
+    }
+
     for (size_t i = 0; i < common->nb_planes; i++) {
         struct texture *plane = common->planes[i];
         struct texture_params *params = &plane->params;
@@ -45,6 +45,7 @@
 
 #include "animation.h"
 #include "block.h"
+#include "copy_pool.h"
 #include "drawutils.h"
 #include "graphics_state.h"
 #include "hmap.h"
@@ -107,6 +108,7 @@ struct ngl_ctx {
     struct rendertarget *available_rendertargets[2];
     struct rendertarget *current_rendertarget;
     int render_pass_started;
+    int draw_ret; // first error raised by the nodes during the draw phase
     float default_modelview_matrix[16];
     float default_projection_matrix[16];
     struct darray modelview_matrix_stack;
@@ -119,9 +121,26 @@ struct ngl_ctx {
      */
     struct darray activitycheck_nodes;
 
+    /*
+     * Inactive nodes whose GPU resources are kept alive while the memory
+     * budget allows it, from the least to the most recently deactivated.
+     */
+    struct darray resident_nodes;
+    int64_t memory_nested;
+    int64_t memory_nested_program;
+
+    /* Intermediate render targets and shared transient attachments (see rtt.h) */
+    struct darray rtt_pool;        // struct rtt_ctx *
+    struct darray rtt_attachments; // struct texture *
+
+    /* Worker threads copying the media planes to the staging memory, created on first use */
+    struct copy_pool *copy_pool;
+
     struct hmap *text_builtin_atlasses; // struct text_builtin_atlas
 #if HAVE_TEXT_LIBRARIES
     FT_Library ft_library;
+    struct hmap *text_font_files; // struct text_font_file (see text_external.c)
+    struct hmap *text_font_faces; // struct text_font_face (see text_external.c)
 #endif
 
     struct pgcache pgcache;
@@ -135,6 +154,8 @@ struct ngl_ctx {
     int64_t cpu_update_time;
     int64_t cpu_draw_time;
     int64_t gpu_draw_time;
+    uint64_t nb_prefetches;
+    struct ngl_stats stats; // counters of the last frame drawn
 
     /* Shared fields */
     pthread_mutex_t lock;
@@ -169,6 +190,9 @@ struct ngl_node {
 
     int state;
     int is_active;
+    int is_resident;
+    int64_t gpu_memory; // GPU memory allocated on behalf of the node
+    int64_t ready_memory; // part of gpu_memory acquired since init, given back on release
 
     double visit_time;
     double last_update_time;
@@ -178,6 +202,11 @@ struct ngl_node {
     int refcount;
     int ctx_refcount;
 
+    uint64_t invalidation_id; // last invalidation pass which went through the node
+
+    int deferred; // children not attached to the context yet (lazy_init)
+    struct darray deferred_rnodes; // render paths to prepare the children into
+
     struct darray children;
     struct darray parents;
 
@@ -192,6 +221,19 @@ struct ngl_scene {
     struct darray nodes; // set of all the nodes in the graph
     struct darray files; // files path strings (array of char *)
     struct darray files_par; // file based parameters pointers (array of uint8_t *)
+    uint64_t invalidation_id; // incremented for every invalidation pass
+    int changes_started; // within ngl_scene_begin_changes() and ngl_scene_commit_changes()
+    struct darray changes; // pending parameter changes (array of struct param_change *)
+    struct hmap *changes_map; // pending parameter changes lookup, keyed by parameter storage address
+};
+
+/* parameter live changed within a batch of changes (see ngl_scene_begin_changes()) */
+struct param_change {
+    struct ngl_node *node;
+    const struct node_param *par;
+    uint8_t *dst;   // parameter storage in the node
+    uint8_t *value; // staged value, moved to dst at commit
+    size_t size;
 };
 
 /* helper structure to specify the content (or a slice) of a buffer */
@@ -256,6 +298,7 @@ struct variable_info {
 };
 
 int ngli_velocity_evaluate(struct ngl_node *node, void *dst, double t);
+int ngli_noise_evaluate_batch(struct ngl_node *node, float *dst, const double *times, size_t nb_times);
 
 struct block_info {
     struct block block;
@@ -340,6 +383,17 @@ struct media_priv {
 struct transform {
     struct ngl_node *child;
     NGLI_ALIGNED_MAT(matrix);
+
+    /*
+     * Static transforms (no animated parameter) directly following this node
+     * are collapsed into a single matrix at init and only recomputed when a
+     * member of the chain changes. folded_child is the first node after the
+     * collapsed chain.
+     */
+    int is_static;
+    int folded_dirty;
+    NGLI_ALIGNED_MAT(folded_matrix);
+    struct ngl_node *folded_child;
 };
 
 struct io_opts {
@@ -545,6 +599,15 @@ enum {
  */
 #define NGLI_NODE_FLAG_LIVECTL (1 << 0)
 
+/*
+ * The node gates the activity of its children in time: when
+ * ngl_config.lazy_init is set, the attachment of its children to the
+ * rendering context (init and prepare) is deferred until the node calls
+ * ngli_node_attach_deferred() from its visit callback, which it must do as
+ * soon as the children are about to become active.
+ */
+#define NGLI_NODE_FLAG_DEFER_CHILDREN (1 << 1)
+
 /*
  * Specifications of a node.
  *
@@ -713,6 +776,7 @@ struct node_class {
 /* Internal scene API */
 int ngli_scene_deserialize(struct ngl_scene *s, const char *str);
 char *ngli_scene_serialize(const struct ngl_scene *s);
+int ngli_scene_serialize_fd(const struct ngl_scene *s, int fd);
 char *ngli_scene_dot(const struct ngl_scene *s);
 void ngli_scene_update_filepath_ref(struct ngl_node *node, const struct node_param *par);
 
@@ -720,13 +784,19 @@ void ngli_node_print_specs(void);
 
 int ngli_node_prepare(struct ngl_node *node);
 int ngli_node_prepare_children(struct ngl_node *node);
+int ngli_node_attach_deferred(struct ngl_node *node);
+int ngli_node_commit_changes(struct ngl_scene *scene, struct param_change **changes, size_t nb_changes);
+void ngli_node_param_change_freep(struct param_change **changep);
 int ngli_node_visit(struct ngl_node *node, int is_active, double t);
 int ngli_node_honor_release_prefetch(struct ngl_node *scene, double t);
+uint64_t ngli_node_get_resident_memory(const struct ngl_ctx *ctx);
+void ngli_node_get_stats(const struct ngl_scene *scene, struct ngl_stats *stats);
 int ngli_node_update(struct ngl_node *node, double t);
 int ngli_node_update_children(struct ngl_node *node, double t);
 void *ngli_node_get_data_ptr(const struct ngl_node *var_node, void *data_fallback);
 int ngli_prepare_draw(struct ngl_ctx *s, double t);
 void ngli_node_draw(struct ngl_node *node);
+void ngli_node_set_draw_error(struct ngl_node *node, int ret);
 
 int ngli_node_attach_ctx(struct ngl_node *node, struct ngl_ctx *ctx);
 void ngli_node_detach_ctx(struct ngl_node *node, struct ngl_ctx *ctx);
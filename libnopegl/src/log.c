@@ -19,9 +19,13 @@
  * under the License.
  */
 
+#include <inttypes.h>
 #include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "config.h"
 #if !defined(TARGET_IPHONE) && !defined(TARGET_ANDROID) && !defined(TARGET_WINDOWS)
 #include <unistd.h>
@@ -29,6 +33,7 @@
 
 #include "log.h"
 #include "memory.h"
+#include "pthread_compat.h"
 
 ngli_printf_format(6, 0)
 static void default_callback(void *arg, int level, const char *filename, int ln,
@@ -90,15 +95,58 @@ static struct {
     void *user_arg;
     ngl_log_callback_type callback;
     int min_level;
+    int async; /* read without locking by every message, like the fields above */
 } log_ctx = {
     .callback  = default_callback,
     .min_level = NGL_LOG_WARNING,
 };
 
+/*
+ * Asynchronous mode: the messages are formatted by the logging threads, then
+ * copied into a bounded ring, and a background thread calls the user callback.
+ * The lock is only held for the copy in and out of the ring, never while
+ * formatting or calling the callback.
+ *
+ * The consumer marks the mode as stopped when it exits, so that the producers
+ * racing with the disabling of the mode log their message synchronously
+ * instead of pushing it into a ring nobody drains anymore.
+ */
+#define ASYNC_NB_SLOTS 1024 /* must be a power of 2 */
+#define ASYNC_MSG_SIZE 256
+
+struct log_msg {
+    int level;
+    const char *filename;
+    int ln;
+    const char *fn;
+    char *long_msg; /* heap copy of the messages not fitting in msg */
+    char msg[ASYNC_MSG_SIZE];
+};
+
+static struct {
+    pthread_mutex_t ctl_lock; /* serializes the enabling/disabling of the async mode */
+    pthread_t tid;
+    pthread_mutex_t lock; /* protects the fields below and the user callback */
+    pthread_cond_t cond;
+    int started;
+    int stop;
+    struct log_msg *msgs;
+    size_t head;
+    size_t count;
+    uint64_t nb_dropped;
+    uint64_t nb_dropped_reported;
+} log_async = {
+    .ctl_lock = PTHREAD_MUTEX_INITIALIZER,
+    .lock     = PTHREAD_MUTEX_INITIALIZER,
+    .cond     = PTHREAD_COND_INITIALIZER,
+};
+
 void ngli_log_set_callback(void *arg, ngl_log_callback_type callback)
 {
+    pthread_mutex_lock(&log_async.lock);
     log_ctx.user_arg = arg;
     log_ctx.callback = callback;
+    pthread_mutex_unlock(&log_async.lock);
 }
 
 void ngli_log_set_min_level(int level)
@@ -106,6 +154,151 @@ void ngli_log_set_min_level(int level)
     log_ctx.min_level = level;
 }
 
+ngli_printf_format(7, 8)
+static void call_callback(ngl_log_callback_type callback, void *user_arg, int log_level,
+                          const char *filename, int ln, const char *fn, const char *fmt, ...)
+{
+    va_list arg_list;
+    va_start(arg_list, fmt);
+    callback(user_arg, log_level, filename, ln, fn, fmt, arg_list);
+    va_end(arg_list);
+}
+
+static void async_push(int log_level, const char *filename,
+                       int ln, const char *fn, const char *fmt, va_list vl)
+{
+    struct log_msg msg = {.level = log_level, .filename = filename, .ln = ln, .fn = fn};
+
+    va_list vl_copy;
+    va_copy(vl_copy, vl);
+    const int len = vsnprintf(msg.msg, sizeof(msg.msg), fmt, vl);
+    if (len < 0) {
+        msg.msg[0] = 0;
+    } else if (len >= (int)sizeof(msg.msg)) {
+        /* Keep the truncated message if the heap copy fails */
+        msg.long_msg = ngli_malloc(len + 1);
+        if (msg.long_msg)
+            vsnprintf(msg.long_msg, len + 1, fmt, vl_copy);
+    }
+    va_end(vl_copy);
+
+    pthread_mutex_lock(&log_async.lock);
+    if (!log_async.started) {
+        ngl_log_callback_type callback = log_ctx.callback;
+        void *user_arg = log_ctx.user_arg;
+        pthread_mutex_unlock(&log_async.lock);
+        call_callback(callback, user_arg, log_level, filename, ln, fn, "%s",
+                      msg.long_msg ? msg.long_msg : msg.msg);
+        ngli_free(msg.long_msg);
+        return;
+    }
+    if (log_async.count == ASYNC_NB_SLOTS) {
+        log_async.nb_dropped++;
+        pthread_mutex_unlock(&log_async.lock);
+        ngli_free(msg.long_msg);
+        return;
+    }
+
+    /* Only copy the used part of the message */
+    struct log_msg *slot = &log_async.msgs[(log_async.head + log_async.count) & (ASYNC_NB_SLOTS - 1)];
+    memcpy(slot, &msg, offsetof(struct log_msg, msg));
+    memcpy(slot->msg, msg.msg, strlen(msg.msg) + 1);
+    if (!log_async.count++)
+        pthread_cond_signal(&log_async.cond);
+    pthread_mutex_unlock(&log_async.lock);
+}
+
+static void *async_consumer(void *arg)
+{
+    pthread_mutex_lock(&log_async.lock);
+    for (;;) {
+        while (!log_async.count && !log_async.stop)
+            pthread_cond_wait(&log_async.cond, &log_async.lock);
+        if (!log_async.count) {
+            log_async.started = 0;
+            break;
+        }
+
+        struct log_msg *slot = &log_async.msgs[log_async.head];
+        struct log_msg msg;
+        memcpy(&msg, slot, offsetof(struct log_msg, msg));
+        snprintf(msg.msg, sizeof(msg.msg), "%s", slot->msg);
+        log_async.head = (log_async.head + 1) & (ASYNC_NB_SLOTS - 1);
+        log_async.count--;
+
+        const uint64_t nb_dropped = log_async.nb_dropped - log_async.nb_dropped_reported;
+        log_async.nb_dropped_reported = log_async.nb_dropped;
+
+        ngl_log_callback_type callback = log_ctx.callback;
+        void *user_arg = log_ctx.user_arg;
+        pthread_mutex_unlock(&log_async.lock);
+
+        call_callback(callback, user_arg, msg.level, msg.filename, msg.ln, msg.fn, "%s",
+                      msg.long_msg ? msg.long_msg : msg.msg);
+        ngli_free(msg.long_msg);
+        if (nb_dropped)
+            call_callback(callback, user_arg, NGL_LOG_WARNING, __FILE__, __LINE__, __func__,
+                          "%" PRIu64 " log messages dropped (asynchronous queue full)", nb_dropped);
+
+        pthread_mutex_lock(&log_async.lock);
+    }
+    pthread_mutex_unlock(&log_async.lock);
+    return NULL;
+}
+
+int ngli_log_set_async(int async)
+{
+    int ret = 0;
+
+    pthread_mutex_lock(&log_async.ctl_lock);
+
+    if (async && !log_ctx.async) {
+        if (!log_async.msgs) {
+            log_async.msgs = ngli_calloc(ASYNC_NB_SLOTS, sizeof(*log_async.msgs));
+            if (!log_async.msgs) {
+                ret = NGL_ERROR_MEMORY;
+                goto end;
+            }
+        }
+
+        pthread_mutex_lock(&log_async.lock);
+        log_async.head = 0;
+        log_async.count = 0;
+        log_async.stop = 0;
+        log_async.started = 1;
+        pthread_mutex_unlock(&log_async.lock);
+
+        if (pthread_create(&log_async.tid, NULL, async_consumer, NULL)) {
+            pthread_mutex_lock(&log_async.lock);
+            log_async.started = 0;
+            pthread_mutex_unlock(&log_async.lock);
+            ret = NGL_ERROR_EXTERNAL;
+            goto end;
+        }
+        log_ctx.async = 1;
+    } else if (!async && log_ctx.async) {
+        /* The new messages are logged synchronously, the pending ones are flushed */
+        log_ctx.async = 0;
+        pthread_mutex_lock(&log_async.lock);
+        log_async.stop = 1;
+        pthread_cond_signal(&log_async.cond);
+        pthread_mutex_unlock(&log_async.lock);
+        pthread_join(log_async.tid, NULL);
+    }
+
+end:
+    pthread_mutex_unlock(&log_async.ctl_lock);
+    return ret;
+}
+
+uint64_t ngli_log_get_nb_dropped(void)
+{
+    pthread_mutex_lock(&log_async.lock);
+    const uint64_t nb_dropped = log_async.nb_dropped;
+    pthread_mutex_unlock(&log_async.lock);
+    return nb_dropped;
+}
+
 void ngli_log_print(int log_level, const char *filename,
                     int ln, const char *fn, const char *fmt, ...)
 {
@@ -115,7 +308,10 @@ void ngli_log_print(int log_level, const char *filename,
         return;
 
     va_start(arg_list, fmt);
-    log_ctx.callback(log_ctx.user_arg, log_level, filename, ln, fn, fmt, arg_list);
+    if (log_ctx.async)
+        async_push(log_level, filename, ln, fn, fmt, arg_list);
+    else
+        log_ctx.callback(log_ctx.user_arg, log_level, filename, ln, fn, fmt, arg_list);
     va_end(arg_list);
 }
 
@@ -39,6 +39,8 @@
 
 void ngli_log_set_callback(void *arg, ngl_log_callback_type callback);
 void ngli_log_set_min_level(int level);
+int ngli_log_set_async(int async);
+uint64_t ngli_log_get_nb_dropped(void);
 
 void ngli_log_print(int log_level, const char *filename,
                     int ln, const char *fn, const char *fmt, ...) ngli_printf_format(5, 6);
@@ -22,7 +22,9 @@
 #include <string.h>
 #include <math.h>
 
+#include "cpu.h"
 #include "math_utils.h"
+#include "pthread_compat.h"
 #include "utils.h"
 
 static const float zvec[4];
@@ -284,6 +286,68 @@ void ngli_mat4_mul_vec4_c(float *dst, const float *m, const float *v)
     memcpy(dst, tmp, sizeof(tmp));
 }
 
+void ngli_mat4_mul_vec4_array_c(float *dst, const float *m, const float *v, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+        ngli_mat4_mul_vec4_c(dst + i * 4, m, v + i * 4);
+}
+
+struct math_funcs ngli_math_funcs = {
+#if defined(ARCH_AARCH64)
+    .mat4_mul            = ngli_mat4_mul_aarch64,
+    .mat4_mul_vec4       = ngli_mat4_mul_vec4_aarch64,
+    .mat4_mul_vec4_array = ngli_mat4_mul_vec4_array_aarch64,
+#elif defined(HAVE_X86_INTR)
+    .mat4_mul            = ngli_mat4_mul_sse,
+    .mat4_mul_vec4       = ngli_mat4_mul_vec4_sse,
+    .mat4_mul_vec4_array = ngli_mat4_mul_vec4_array_sse,
+#else
+    .mat4_mul            = ngli_mat4_mul_c,
+    .mat4_mul_vec4       = ngli_mat4_mul_vec4_c,
+    .mat4_mul_vec4_array = ngli_mat4_mul_vec4_array_c,
+#endif
+};
+
+void ngli_math_funcs_init(struct math_funcs *funcs, uint32_t cpu_flags)
+{
+    funcs->mat4_mul            = ngli_mat4_mul_c;
+    funcs->mat4_mul_vec4       = ngli_mat4_mul_vec4_c;
+    funcs->mat4_mul_vec4_array = ngli_mat4_mul_vec4_array_c;
+
+#if defined(ARCH_AARCH64)
+    if (cpu_flags & NGLI_CPU_FLAG_NEON) {
+        funcs->mat4_mul            = ngli_mat4_mul_aarch64;
+        funcs->mat4_mul_vec4       = ngli_mat4_mul_vec4_aarch64;
+        funcs->mat4_mul_vec4_array = ngli_mat4_mul_vec4_array_aarch64;
+    }
+#elif defined(HAVE_X86_INTR)
+    if (cpu_flags & NGLI_CPU_FLAG_SSE) {
+        funcs->mat4_mul            = ngli_mat4_mul_sse;
+        funcs->mat4_mul_vec4       = ngli_mat4_mul_vec4_sse;
+        funcs->mat4_mul_vec4_array = ngli_mat4_mul_vec4_array_sse;
+    }
+    if (cpu_flags & NGLI_CPU_FLAG_AVX2) {
+        funcs->mat4_mul            = ngli_mat4_mul_avx2;
+        funcs->mat4_mul_vec4       = ngli_mat4_mul_vec4_avx2;
+        funcs->mat4_mul_vec4_array = ngli_mat4_mul_vec4_array_avx2;
+    }
+#endif
+}
+
+static pthread_once_t math_init_once = PTHREAD_ONCE_INIT;
+
+static void math_init(void)
+{
+    struct math_funcs funcs;
+    ngli_math_funcs_init(&funcs, ngli_cpu_get_flags());
+    ngli_math_funcs = funcs;
+}
+
+void ngli_math_init(void)
+{
+    pthread_once(&math_init_once, math_init);
+}
+
 void ngli_mat4_look_at(float * restrict dst, float *eye, float *center, float *up)
 {
     float f[3] = NGLI_VEC3_SUB(center, eye);
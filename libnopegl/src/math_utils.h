@@ -22,6 +22,9 @@
 #ifndef MATH_UTILS_H
 #define MATH_UTILS_H
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include "config.h"
 
 #define PI_F32 3.14159265358979323846f
@@ -111,23 +114,40 @@ void ngli_mat4_translate(float * restrict dst, float x, float y, float z);
 void ngli_mat4_scale(float * restrict dst, float x, float y, float z, const float *anchor);
 void ngli_mat4_skew(float * restrict dst, float x, float y, float z, const float *axis, const float *anchor);
 
-/* Arch specific versions */
-
-#ifdef ARCH_AARCH64
-# define ngli_mat4_mul          ngli_mat4_mul_aarch64
-# define ngli_mat4_mul_vec4     ngli_mat4_mul_vec4_aarch64
-#elif defined(HAVE_X86_INTR)
-# define ngli_mat4_mul          ngli_mat4_mul_sse
-# define ngli_mat4_mul_vec4     ngli_mat4_mul_vec4_sse
-#else
-# define ngli_mat4_mul          ngli_mat4_mul_c
-# define ngli_mat4_mul_vec4     ngli_mat4_mul_vec4_c
-#endif
+void ngli_mat4_mul_vec4_array_c(float *dst, const float *m, const float *v, size_t count);
+
+/*
+ * Arch specific versions, selected at runtime according to the CPU features.
+ *
+ * Until ngli_math_init() is called, the table points to the best version
+ * available at compile time.
+ */
+
+struct math_funcs {
+    void (*mat4_mul)(float *dst, const float *m1, const float *m2);
+    void (*mat4_mul_vec4)(float *dst, const float *m, const float *v);
+    /* Transform count vec4 stored contiguously in v; dst may alias v */
+    void (*mat4_mul_vec4_array)(float *dst, const float *m, const float *v, size_t count);
+};
+
+extern struct math_funcs ngli_math_funcs;
+
+void ngli_math_funcs_init(struct math_funcs *funcs, uint32_t cpu_flags);
+void ngli_math_init(void);
+
+#define ngli_mat4_mul(dst, m1, m2)                 ngli_math_funcs.mat4_mul(dst, m1, m2)
+#define ngli_mat4_mul_vec4(dst, m, v)              ngli_math_funcs.mat4_mul_vec4(dst, m, v)
+#define ngli_mat4_mul_vec4_array(dst, m, v, count) ngli_math_funcs.mat4_mul_vec4_array(dst, m, v, count)
 
 void ngli_mat4_mul_aarch64(float *dst, const float *m1, const float *m2);
 void ngli_mat4_mul_vec4_aarch64(float *dst, const float *m, const float *v);
+void ngli_mat4_mul_vec4_array_aarch64(float *dst, const float *m, const float *v, size_t count);
 void ngli_mat4_mul_sse(float *dst, const float *m1, const float *m2);
 void ngli_mat4_mul_vec4_sse(float *dst, const float *m, const float *v);
+void ngli_mat4_mul_vec4_array_sse(float *dst, const float *m, const float *v, size_t count);
+void ngli_mat4_mul_avx2(float *dst, const float *m1, const float *m2);
+void ngli_mat4_mul_vec4_avx2(float *dst, const float *m, const float *v);
+void ngli_mat4_mul_vec4_array_avx2(float *dst, const float *m, const float *v, size_t count);
 
 #define NGLI_QUAT_IDENTITY {0.0f, 0.0f, 0.0f, 1.0f}
 
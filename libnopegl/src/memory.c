@@ -27,6 +27,14 @@
 #include "memory.h"
 #include "utils.h"
 
+#if DEBUG_MEM_PROF
+#undef ngli_malloc
+#undef ngli_calloc
+#undef ngli_malloc_aligned
+#undef ngli_realloc
+#undef ngli_memdup
+#endif
+
 #if DEBUG_MEM
 static int failure_requested(void)
 {
@@ -61,6 +69,388 @@ static inline int failure_requested(void)
 }
 #endif
 
+#if DEBUG_MEM_PROF
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "nopegl.h"
+#include "pthread_compat.h"
+
+#define MAX_SITES 4096 /* must be a power of 2 */
+#define DEFAULT_WARMUP_FRAMES 3
+
+struct mem_site {
+    const char *file;
+    const char *func;
+    uint64_t nb_allocs[NGLI_MEM_PHASE_NB];
+    uint64_t alloc_size[NGLI_MEM_PHASE_NB];
+    uint64_t live_size;
+    uint64_t peak_size;
+    int flagged;
+};
+
+struct mem_block {
+    void *ptr;
+    size_t size;
+    struct mem_site *site;
+};
+
+static struct {
+    pthread_mutex_t lock;
+    int mode_parsed;
+    int report;
+    int64_t warmup_frames; /* flag the frame allocations after this many frames, -1 to disable */
+    struct mem_site sites[MAX_SITES];
+    struct mem_site overflow_site;
+    struct mem_block *blocks; /* open addressing table indexed by pointer */
+    size_t blocks_cap;        /* 0 or a power of 2 */
+    size_t nb_blocks;
+    uint64_t live_size;
+    uint64_t peak_size;
+} prof = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .overflow_site = {.file = "?", .func = "(too many sites)"},
+};
+
+/*
+ * The frame phase and the number of frames drawn are tracked per thread (the
+ * thread of the context drawing), directly stored as the thread values.
+ */
+static pthread_once_t keys_once = PTHREAD_ONCE_INIT;
+static pthread_key_t phase_key;
+static pthread_key_t frames_key;
+
+static void create_keys(void)
+{
+    pthread_key_create(&phase_key, NULL);
+    pthread_key_create(&frames_key, NULL);
+}
+
+static intptr_t get_thread_value(pthread_key_t *key)
+{
+    pthread_once(&keys_once, create_keys);
+    return (intptr_t)pthread_getspecific(*key);
+}
+
+static void set_thread_value(pthread_key_t *key, intptr_t value)
+{
+    pthread_once(&keys_once, create_keys);
+    pthread_setspecific(*key, (const void *)value);
+}
+
+static const char * const phase_names[NGLI_MEM_PHASE_NB] = {
+    [NGLI_MEM_PHASE_NONE]    = "none",
+    [NGLI_MEM_PHASE_PREPARE] = "prepare",
+    [NGLI_MEM_PHASE_UPDATE]  = "update",
+    [NGLI_MEM_PHASE_DRAW]    = "draw",
+};
+
+/*
+ * NGL_MEM_PROF=report prints the allocations per call site when a context is
+ * destroyed. NGL_MEM_PROF=flag[:N] additionally warns about the call sites
+ * allocating within a frame once the first N frames of a scene are drawn.
+ */
+static void parse_mode(void)
+{
+    prof.mode_parsed = 1;
+    prof.warmup_frames = -1;
+
+    const char *mode = getenv("NGL_MEM_PROF");
+    if (!mode)
+        return;
+    prof.report = 1;
+    if (!strncmp(mode, "flag", 4)) {
+        prof.warmup_frames = DEFAULT_WARMUP_FRAMES;
+        if (mode[4] == ':')
+            prof.warmup_frames = strtol(mode + 5, NULL, 0);
+    }
+}
+
+static size_t hash_ptr(const void *ptr, size_t cap)
+{
+    return (size_t)(((uint64_t)(uintptr_t)ptr >> 4) * 0x9E3779B97F4A7C15ULL) & (cap - 1);
+}
+
+static struct mem_site *get_site(const char *file, const char *func)
+{
+    size_t i = hash_ptr(func, MAX_SITES) ^ hash_ptr(file, MAX_SITES);
+    for (size_t n = 0; n < MAX_SITES; n++) {
+        struct mem_site *site = &prof.sites[i];
+        if (!site->func) {
+            site->file = file;
+            site->func = func;
+            return site;
+        }
+        if (site->func == func && site->file == file)
+            return site;
+        i = (i + 1) & (MAX_SITES - 1);
+    }
+    return &prof.overflow_site;
+}
+
+static int grow_blocks(void)
+{
+    const size_t cap = prof.blocks_cap ? prof.blocks_cap * 2 : 1024;
+    struct mem_block *blocks = calloc(cap, sizeof(*blocks));
+    if (!blocks)
+        return -1;
+    for (size_t i = 0; i < prof.blocks_cap; i++) {
+        const struct mem_block *block = &prof.blocks[i];
+        if (!block->ptr)
+            continue;
+        size_t j = hash_ptr(block->ptr, cap);
+        while (blocks[j].ptr)
+            j = (j + 1) & (cap - 1);
+        blocks[j] = *block;
+    }
+    free(prof.blocks);
+    prof.blocks = blocks;
+    prof.blocks_cap = cap;
+    return 0;
+}
+
+static void prof_register_locked(void *ptr, size_t size, const char *file, const char *func)
+{
+    if (!ptr)
+        return;
+
+    if (!prof.mode_parsed)
+        parse_mode();
+
+    if (prof.nb_blocks * 2 >= prof.blocks_cap && grow_blocks() < 0)
+        return;
+
+    const int cur_phase = (int)get_thread_value(&phase_key);
+    const int64_t nb_frames = get_thread_value(&frames_key);
+
+    struct mem_site *site = get_site(file, func);
+    site->nb_allocs[cur_phase]++;
+    site->alloc_size[cur_phase] += size;
+    site->live_size += size;
+    site->peak_size = NGLI_MAX(site->peak_size, site->live_size);
+    prof.live_size += size;
+    prof.peak_size = NGLI_MAX(prof.peak_size, prof.live_size);
+
+    size_t i = hash_ptr(ptr, prof.blocks_cap);
+    while (prof.blocks[i].ptr)
+        i = (i + 1) & (prof.blocks_cap - 1);
+    prof.blocks[i] = (struct mem_block){.ptr = ptr, .size = size, .site = site};
+    prof.nb_blocks++;
+
+    if (cur_phase != NGLI_MEM_PHASE_NONE && prof.warmup_frames >= 0 &&
+        nb_frames >= prof.warmup_frames && !site->flagged) {
+        fprintf(stderr, "MEMPROF: %s:%s() allocates %zu bytes during the %s phase of frame %" PRId64 "\n",
+                file, func, size, phase_names[cur_phase], nb_frames);
+        site->flagged = 1;
+    }
+}
+
+static void prof_register(void *ptr, size_t size, const char *file, const char *func)
+{
+    pthread_mutex_lock(&prof.lock);
+    prof_register_locked(ptr, size, file, func);
+    pthread_mutex_unlock(&prof.lock);
+}
+
+static void prof_unregister_locked(void *ptr)
+{
+    if (!ptr || !prof.blocks_cap)
+        return;
+
+    const size_t mask = prof.blocks_cap - 1;
+    size_t i = hash_ptr(ptr, prof.blocks_cap);
+    while (prof.blocks[i].ptr && prof.blocks[i].ptr != ptr)
+        i = (i + 1) & mask;
+
+    struct mem_block *block = &prof.blocks[i];
+    if (!block->ptr) {
+        /* Not allocated through a tagged function */
+        return;
+    }
+
+    block->site->live_size -= block->size;
+    prof.live_size -= block->size;
+    prof.nb_blocks--;
+
+    /* Backward shift deletion to keep the probe sequences contiguous */
+    size_t j = i;
+    for (;;) {
+        j = (j + 1) & mask;
+        if (!prof.blocks[j].ptr)
+            break;
+        const size_t k = hash_ptr(prof.blocks[j].ptr, prof.blocks_cap);
+        if ((j > i && (k <= i || k > j)) || (j < i && (k <= i && k > j))) {
+            prof.blocks[i] = prof.blocks[j];
+            i = j;
+        }
+    }
+    prof.blocks[i] = (struct mem_block){0};
+}
+
+static void prof_unregister(void *ptr)
+{
+    pthread_mutex_lock(&prof.lock);
+    prof_unregister_locked(ptr);
+    pthread_mutex_unlock(&prof.lock);
+}
+
+void ngli_mem_prof_set_phase(int phase)
+{
+    set_thread_value(&phase_key, phase);
+}
+
+void ngli_mem_prof_end_frame(void)
+{
+    set_thread_value(&frames_key, get_thread_value(&frames_key) + 1);
+}
+
+void ngli_mem_prof_reset_frames(void)
+{
+    set_thread_value(&frames_key, 0);
+}
+
+static uint64_t get_nb_allocs(const struct mem_site *site)
+{
+    uint64_t nb = 0;
+    for (size_t i = 0; i < NGLI_MEM_PHASE_NB; i++)
+        nb += site->nb_allocs[i];
+    return nb;
+}
+
+static int cmp_site(const void *a, const void *b)
+{
+    const uint64_t nb_a = get_nb_allocs(*(const struct mem_site * const *)a);
+    const uint64_t nb_b = get_nb_allocs(*(const struct mem_site * const *)b);
+    return (nb_a < nb_b) - (nb_a > nb_b);
+}
+
+/* Must be called with the lock held */
+static size_t get_sorted_sites(struct mem_site **sites)
+{
+    size_t nb_sites = 0;
+    for (size_t i = 0; i < MAX_SITES; i++)
+        if (prof.sites[i].func)
+            sites[nb_sites++] = &prof.sites[i];
+    if (get_nb_allocs(&prof.overflow_site))
+        sites[nb_sites++] = &prof.overflow_site;
+    qsort(sites, nb_sites, sizeof(*sites), cmp_site);
+    return nb_sites;
+}
+
+int ngli_mem_prof_get_sites(void *arg, void (*callback)(void *arg, const struct ngl_mem_prof_site *site))
+{
+    struct mem_site *sites[MAX_SITES + 1];
+    struct ngl_mem_prof_site *infos = malloc(NGLI_ARRAY_NB(sites) * sizeof(*infos));
+    if (!infos)
+        return NGL_ERROR_MEMORY;
+
+    /* The callback is called out of the lock as it may allocate memory */
+    pthread_mutex_lock(&prof.lock);
+    const size_t nb_sites = get_sorted_sites(sites);
+    for (size_t i = 0; i < nb_sites; i++) {
+        const struct mem_site *site = sites[i];
+        infos[i] = (struct ngl_mem_prof_site){
+            .file              = site->file,
+            .func              = site->func,
+            .nb_allocs_none    = site->nb_allocs[NGLI_MEM_PHASE_NONE],
+            .nb_allocs_prepare = site->nb_allocs[NGLI_MEM_PHASE_PREPARE],
+            .nb_allocs_update  = site->nb_allocs[NGLI_MEM_PHASE_UPDATE],
+            .nb_allocs_draw    = site->nb_allocs[NGLI_MEM_PHASE_DRAW],
+            .live_size         = site->live_size,
+            .peak_size         = site->peak_size,
+        };
+    }
+    pthread_mutex_unlock(&prof.lock);
+
+    for (size_t i = 0; i < nb_sites; i++)
+        callback(arg, &infos[i]);
+
+    free(infos);
+    return 0;
+}
+
+void ngli_mem_prof_report(void)
+{
+    pthread_mutex_lock(&prof.lock);
+
+    if (!prof.mode_parsed)
+        parse_mode();
+    if (!prof.report) {
+        pthread_mutex_unlock(&prof.lock);
+        return;
+    }
+
+    struct mem_site *sites[MAX_SITES + 1];
+    const size_t nb_sites = get_sorted_sites(sites);
+
+    fprintf(stderr, "MEMPROF: %-48s %10s %10s %10s %10s %12s %12s\n",
+            "site", "none", "prepare", "update", "draw", "live", "peak");
+    for (size_t i = 0; i < nb_sites; i++) {
+        const struct mem_site *site = sites[i];
+        char name[128];
+        snprintf(name, sizeof(name), "%s:%s()", site->file, site->func);
+        fprintf(stderr, "MEMPROF: %-48s", name);
+        for (size_t j = 0; j < NGLI_MEM_PHASE_NB; j++)
+            fprintf(stderr, " %10" PRIu64, site->nb_allocs[j]);
+        fprintf(stderr, " %12" PRIu64 " %12" PRIu64 "\n", site->live_size, site->peak_size);
+    }
+    fprintf(stderr, "MEMPROF: live %" PRIu64 " bytes, peak %" PRIu64 " bytes\n",
+            prof.live_size, prof.peak_size);
+
+    pthread_mutex_unlock(&prof.lock);
+}
+
+void *ngli_malloc_tag(size_t size, const char *file, const char *func)
+{
+    void *ptr = ngli_malloc(size);
+    prof_register(ptr, size, file, func);
+    return ptr;
+}
+
+void *ngli_calloc_tag(size_t n, size_t size, const char *file, const char *func)
+{
+    void *ptr = ngli_calloc(n, size);
+    prof_register(ptr, n * size, file, func);
+    return ptr;
+}
+
+void *ngli_malloc_aligned_tag(size_t size, const char *file, const char *func)
+{
+    void *ptr = ngli_malloc_aligned(size);
+    prof_register(ptr, size, file, func);
+    return ptr;
+}
+
+void *ngli_realloc_tag(void *ptr, size_t n, size_t size, const char *file, const char *func)
+{
+    /*
+     * The old block is unregistered within the same lock as the reallocation:
+     * otherwise another thread could get the freed address allocated and
+     * registered before we unregister it.
+     */
+    pthread_mutex_lock(&prof.lock);
+    void *new_ptr = ngli_realloc(ptr, n, size);
+    if (new_ptr) {
+        prof_unregister_locked(ptr);
+        prof_register_locked(new_ptr, n * size, file, func);
+    }
+    pthread_mutex_unlock(&prof.lock);
+    return new_ptr;
+}
+
+void *ngli_memdup_tag(const void *src, size_t n, const char *file, const char *func)
+{
+    void *dst = ngli_memdup(src, n);
+    prof_register(dst, n, file, func);
+    return dst;
+}
+#else
+static inline void prof_unregister(void *ptr)
+{
+}
+#endif
+
 void *ngli_malloc(size_t size)
 {
     if (failure_requested())
@@ -103,6 +493,7 @@ void *ngli_realloc(void *ptr, size_t n, size_t size)
 
 void ngli_free(void *ptr)
 {
+    prof_unregister(ptr);
     free(ptr);
 }
 
@@ -114,6 +505,7 @@ void ngli_freep(void *ptr)
 
 void ngli_free_aligned(void *ptr)
 {
+    prof_unregister(ptr);
 #ifdef _WIN32
     _aligned_free(ptr);
 #else
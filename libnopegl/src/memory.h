@@ -24,6 +24,8 @@
 
 #include <stddef.h>
 
+#include "config.h"
+
 void *ngli_malloc(size_t size);
 void *ngli_calloc(size_t n, size_t size);
 void *ngli_malloc_aligned(size_t size);
@@ -37,4 +39,43 @@ void ngli_freep_aligned(void *ptr);
 
 void *ngli_memdup(const void *src, size_t n);
 
+/* Frame phases in which the allocations are accounted by the profiler */
+enum {
+    NGLI_MEM_PHASE_NONE,
+    NGLI_MEM_PHASE_PREPARE, /* release and prefetch of the nodes */
+    NGLI_MEM_PHASE_UPDATE,
+    NGLI_MEM_PHASE_DRAW,
+    NGLI_MEM_PHASE_NB
+};
+
+#if DEBUG_MEM_PROF
+void *ngli_malloc_tag(size_t size, const char *file, const char *func);
+void *ngli_calloc_tag(size_t n, size_t size, const char *file, const char *func);
+void *ngli_malloc_aligned_tag(size_t size, const char *file, const char *func);
+void *ngli_realloc_tag(void *ptr, size_t n, size_t size, const char *file, const char *func);
+void *ngli_memdup_tag(const void *src, size_t n, const char *file, const char *func);
+
+/*
+ * Record the allocations with their call site: the allocation functions used
+ * as function pointers (such as ngli_free) are not affected by these macros
+ */
+#define ngli_malloc(size)           ngli_malloc_tag(size, __FILE__, __func__)
+#define ngli_calloc(n, size)        ngli_calloc_tag(n, size, __FILE__, __func__)
+#define ngli_malloc_aligned(size)   ngli_malloc_aligned_tag(size, __FILE__, __func__)
+#define ngli_realloc(ptr, n, size)  ngli_realloc_tag(ptr, n, size, __FILE__, __func__)
+#define ngli_memdup(src, n)         ngli_memdup_tag(src, n, __FILE__, __func__)
+
+void ngli_mem_prof_set_phase(int phase);
+void ngli_mem_prof_end_frame(void);
+void ngli_mem_prof_reset_frames(void);
+void ngli_mem_prof_report(void);
+struct ngl_mem_prof_site;
+int ngli_mem_prof_get_sites(void *arg, void (*callback)(void *arg, const struct ngl_mem_prof_site *site));
+#else
+static inline void ngli_mem_prof_set_phase(int phase) {}
+static inline void ngli_mem_prof_end_frame(void) {}
+static inline void ngli_mem_prof_reset_frames(void) {}
+static inline void ngli_mem_prof_report(void) {}
+#endif
+
 #endif
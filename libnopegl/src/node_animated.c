@@ -20,12 +20,14 @@
  */
 
 #include <float.h>
+#include <math.h>
 #include <stddef.h>
 #include <string.h>
 #include "animation.h"
 #include "colorconv.h"
 #include "log.h"
 #include "math_utils.h"
+#include "memory.h"
 #include "nopegl.h"
 #include "internal.h"
 #include "path.h"
@@ -120,8 +122,15 @@ struct animated_priv {
     double dval;
     struct animation anim;
     struct animation anim_eval;
+    uint8_t *baked;         /* var.data sampled for every frame at the bake rate */
+    size_t nb_baked;
+    double baked_start;     /* index of the first baked frame */
+    double baked_period;
 };
 
+/* Upper bound of the memory used by the baked samples of a single animation */
+#define MAX_BAKED_SIZE (16 << 20)
+
 NGLI_STATIC_ASSERT(variable_info_is_first, offsetof(struct animated_priv, var) == 0);
 
 static void mix_time(void *user_arg, void *dst,
@@ -291,21 +300,44 @@ static ngli_animation_cpy_func_type get_cpy_func(const struct variable_opts *o,
     return NULL;
 }
 
-int ngl_anim_evaluate(struct ngl_node *node, void *dst, double t)
+static int is_velocity(const struct ngl_node *node)
 {
-    if (node->cls->id == NGL_NODE_VELOCITYFLOAT ||
-        node->cls->id == NGL_NODE_VELOCITYVEC2 ||
-        node->cls->id == NGL_NODE_VELOCITYVEC3 ||
-        node->cls->id == NGL_NODE_VELOCITYVEC4)
-        return ngli_velocity_evaluate(node, dst, t);
+    return node->cls->id == NGL_NODE_VELOCITYFLOAT ||
+           node->cls->id == NGL_NODE_VELOCITYVEC2 ||
+           node->cls->id == NGL_NODE_VELOCITYVEC3 ||
+           node->cls->id == NGL_NODE_VELOCITYVEC4;
+}
 
-    if (node->cls->id != NGL_NODE_ANIMATEDFLOAT &&
-        node->cls->id != NGL_NODE_ANIMATEDVEC2 &&
-        node->cls->id != NGL_NODE_ANIMATEDVEC3 &&
-        node->cls->id != NGL_NODE_ANIMATEDVEC4 &&
-        node->cls->id != NGL_NODE_ANIMATEDQUAT)
-        return NGL_ERROR_INVALID_ARG;
+static int is_noise(const struct ngl_node *node)
+{
+    return node->cls->id == NGL_NODE_NOISEFLOAT ||
+           node->cls->id == NGL_NODE_NOISEVEC2 ||
+           node->cls->id == NGL_NODE_NOISEVEC3 ||
+           node->cls->id == NGL_NODE_NOISEVEC4;
+}
 
+static size_t get_eval_size(const struct ngl_node *node)
+{
+    switch (node->cls->id) {
+    case NGL_NODE_ANIMATEDFLOAT:
+    case NGL_NODE_VELOCITYFLOAT:
+    case NGL_NODE_NOISEFLOAT:    return 1 * sizeof(float);
+    case NGL_NODE_ANIMATEDVEC2:
+    case NGL_NODE_VELOCITYVEC2:
+    case NGL_NODE_NOISEVEC2:     return 2 * sizeof(float);
+    case NGL_NODE_ANIMATEDVEC3:
+    case NGL_NODE_VELOCITYVEC3:
+    case NGL_NODE_NOISEVEC3:     return 3 * sizeof(float);
+    case NGL_NODE_ANIMATEDVEC4:
+    case NGL_NODE_ANIMATEDQUAT:
+    case NGL_NODE_VELOCITYVEC4:
+    case NGL_NODE_NOISEVEC4:     return 4 * sizeof(float);
+    }
+    return 0;
+}
+
+static int init_anim_eval(struct ngl_node *node)
+{
     struct animated_priv *s = node->priv_data;
     const struct variable_opts *o = node->opts;
     if (!o->nb_animkf)
@@ -334,18 +366,174 @@ int ngl_anim_evaluate(struct ngl_node *node, void *dst, double t)
         }
     }
 
+    return 0;
+}
+
+int ngl_anim_evaluate(struct ngl_node *node, void *dst, double t)
+{
+    if (is_velocity(node))
+        return ngli_velocity_evaluate(node, dst, t);
+
+    if (is_noise(node))
+        return ngli_noise_evaluate_batch(node, dst, &t, 1);
+
+    if (!get_eval_size(node))
+        return NGL_ERROR_INVALID_ARG;
+
+    int ret = init_anim_eval(node);
+    if (ret < 0)
+        return ret;
+
+    struct animated_priv *s = node->priv_data;
+    const struct variable_opts *o = node->opts;
     return ngli_animation_evaluate(&s->anim_eval, dst, t - o->time_offset);
 }
 
-static int animation_init(struct ngl_node *node)
+int ngl_anim_evaluate_batch(struct ngl_node *node, void *dst, const double *times, size_t nb_times)
+{
+    const size_t size = get_eval_size(node);
+    if (!size)
+        return NGL_ERROR_INVALID_ARG;
+
+    uint8_t *dstp = dst;
+
+    if (is_velocity(node)) {
+        for (size_t i = 0; i < nb_times; i++) {
+            int ret = ngli_velocity_evaluate(node, dstp, times[i]);
+            if (ret < 0)
+                return ret;
+            dstp += size;
+        }
+        return 0;
+    }
+
+    /* All the samples of the noise are computed together */
+    if (is_noise(node))
+        return ngli_noise_evaluate_batch(node, dst, times, nb_times);
+
+    int ret = init_anim_eval(node);
+    if (ret < 0)
+        return ret;
+
+    /*
+     * The key frame cursor of the evaluation is kept between the samples, so
+     * walking through increasing times only ever moves it forward.
+     */
+    struct animated_priv *s = node->priv_data;
+    const struct variable_opts *o = node->opts;
+    for (size_t i = 0; i < nb_times; i++) {
+        ret = ngli_animation_evaluate(&s->anim_eval, dstp, times[i] - o->time_offset);
+        if (ret < 0)
+            return ret;
+        dstp += size;
+    }
+    return 0;
+}
+
+static int animation_evaluate(struct ngl_node *node, double t)
+{
+    struct animated_priv *s = node->priv_data;
+    const struct variable_opts *o = node->opts;
+    return ngli_animation_evaluate(&s->anim, s->var.data, t - o->time_offset);
+}
+
+static int animatedquat_evaluate(struct ngl_node *node, double t)
+{
+    struct animated_priv *s = node->priv_data;
+    const struct variable_opts *o = node->opts;
+    int ret = ngli_animation_evaluate(&s->anim, s->vector, t - o->time_offset);
+    if (ret < 0)
+        return ret;
+    if (o->as_mat4)
+        ngli_mat4_rotate_from_quat(s->matrix, s->vector, NULL);
+    return 0;
+}
+
+typedef int (*eval_func_type)(struct ngl_node *node, double t);
+
+/*
+ * Sample the animation for every frame at the configured bake rate between its
+ * first and last key frames, so that the update of a frame time becomes a
+ * copy from the table. Outside this range, the animation is a constant copy of
+ * the boundary key frame and is cheap enough to keep evaluating.
+ */
+static int bake_animation(struct ngl_node *node, eval_func_type eval_func)
+{
+    struct animated_priv *s = node->priv_data;
+    const struct variable_opts *o = node->opts;
+    const int *rate = node->ctx->config.anim_bake_rate;
+
+    if (rate[0] <= 0 || rate[1] <= 0)
+        return 0;
+
+    const struct animkeyframe_opts *kf0 = o->animkf[0]->opts;
+    const struct animkeyframe_opts *kfn = o->animkf[o->nb_animkf - 1]->opts;
+    const double period = rate[1] / (double)rate[0];
+    const double start = ceil((kf0->time + o->time_offset) / period);
+    const double end = floor((kfn->time + o->time_offset) / period);
+    if (end < start)
+        return 0;
+
+    const double nb_frames = end - start + 1;
+    if (nb_frames > (double)(MAX_BAKED_SIZE / s->var.data_size)) {
+        LOG(DEBUG, "%s: %g frames exceed the bake size limit, keeping live evaluation",
+            node->label, nb_frames);
+        return 0;
+    }
+
+    s->baked = ngli_calloc((size_t)nb_frames, s->var.data_size);
+    if (!s->baked)
+        return NGL_ERROR_MEMORY;
+
+    uint8_t *dst = s->baked;
+    for (size_t i = 0; i < (size_t)nb_frames; i++) {
+        int ret = eval_func(node, (start + (double)i) * period);
+        if (ret < 0) {
+            ngli_freep(&s->baked);
+            return ret;
+        }
+        memcpy(dst, s->var.data, s->var.data_size);
+        dst += s->var.data_size;
+    }
+
+    s->nb_baked = (size_t)nb_frames;
+    s->baked_start = start;
+    s->baked_period = period;
+    return 0;
+}
+
+static int lookup_baked(struct ngl_node *node, double t)
+{
+    struct animated_priv *s = node->priv_data;
+    if (!s->baked)
+        return 0;
+
+    /* Only the times landing on a frame of the bake rate are looked up */
+    const double frame = t / s->baked_period;
+    const double index = round(frame);
+    if (fabs(frame - index) > 1e-6)
+        return 0;
+
+    const double pos = index - s->baked_start;
+    if (pos < 0 || pos >= (double)s->nb_baked)
+        return 0;
+
+    memcpy(s->var.data, s->baked + (size_t)pos * s->var.data_size, s->var.data_size);
+    return 1;
+}
+
+static int animation_init(struct ngl_node *node, eval_func_type eval_func)
 {
     struct animated_priv *s = node->priv_data;
     const struct variable_opts *o = node->opts;
     s->var.dynamic = 1;
-    return ngli_animation_init(&s->anim, node->opts,
-                               o->animkf, o->nb_animkf,
-                               get_mix_func(o, node->cls->id),
-                               get_cpy_func(o, node->cls->id));
+    int ret = ngli_animation_init(&s->anim, node->opts,
+                                  o->animkf, o->nb_animkf,
+                                  get_mix_func(o, node->cls->id),
+                                  get_cpy_func(o, node->cls->id));
+    if (ret < 0)
+        return ret;
+    return bake_animation(node, eval_func);
 }
 
 #define DECLARE_INIT_FUNC(suffix, class_data, class_data_size, class_data_type) \
@@ -355,7 +543,7 @@ static int animated##suffix##_init(struct ngl_node *node)
     s->var.data = class_data;                                                   \
     s->var.data_size = class_data_size;                                         \
     s->var.data_type = class_data_type;                                         \
-    return animation_init(node);                                                \
+    return animation_init(node, animation_evaluate);                            \
 }
 
 DECLARE_INIT_FUNC(float, s->vector,  1 * sizeof(*s->vector), NGLI_TYPE_F32)
@@ -389,7 +577,7 @@ static int animatedtime_init(struct ngl_node *node)
         prev_time = kf->scalar;
     }
 
-    return animation_init(node);
+    return animation_init(node, animation_evaluate);
 }
 
 static int animatedquat_init(struct ngl_node *node)
@@ -405,7 +593,7 @@ static int animatedquat_init(struct ngl_node *node)
         s->var.data_size = sizeof(s->matrix);
         s->var.data_type = NGLI_TYPE_MAT4;
     }
-    return animation_init(node);
+    return animation_init(node, animatedquat_evaluate);
 }
 
 static int animatedpath_init(struct ngl_node *node)
@@ -414,14 +602,14 @@ static int animatedpath_init(struct ngl_node *node)
     s->var.data = s->vector;
     s->var.data_size = 3 * sizeof(*s->vector);
     s->var.data_type = NGLI_TYPE_VEC3;
-    return animation_init(node);
+    return animation_init(node, animation_evaluate);
 }
 
 static int animation_update(struct ngl_node *node, double t)
 {
-    struct animated_priv *s = node->priv_data;
-    const struct variable_opts *o = node->opts;
-    return ngli_animation_evaluate(&s->anim, s->var.data, t - o->time_offset);
+    if (lookup_baked(node, t))
+        return 0;
+    return animation_evaluate(node, t);
 }
 
 #define animatedtime_update  animation_update
@@ -433,15 +621,17 @@ static int animation_update(struct ngl_node *node, double t)
 #define animatedcolor_update animation_update
 
 static int animatedquat_update(struct ngl_node *node, double t)
+{
+    if (lookup_baked(node, t))
+        return 0;
+    return animatedquat_evaluate(node, t);
+}
+
+static void animation_uninit(struct ngl_node *node)
 {
     struct animated_priv *s = node->priv_data;
-    const struct variable_opts *o = node->opts;
-    int ret = ngli_animation_evaluate(&s->anim, s->vector, t - o->time_offset);
-    if (ret < 0)
-        return ret;
-    if (o->as_mat4)
-        ngli_mat4_rotate_from_quat(s->matrix, s->vector, NULL);
-    return 0;
+    ngli_freep(&s->baked);
+    s->nb_baked = 0;
 }
 
 #define DEFINE_ANIMATED_CLASS(class_id, class_name, type)       \
@@ -451,6 +641,7 @@ const struct node_class ngli_animated##type##_class = {         \
     .name      = class_name,                                    \
     .init      = animated##type##_init,                         \
     .update    = animated##type##_update,                       \
+    .uninit    = animation_uninit,                              \
     .opts_size = sizeof(struct variable_opts),                  \
     .priv_size = sizeof(struct animated_priv),                  \
     .params    = animated##type##_params,                       \
@@ -167,10 +167,23 @@ static void compute_uninit(struct ngl_node *node)
     ngli_pass_uninit(&s->pass);
 }
 
+static int compute_update(struct ngl_node *node, double t)
+{
+    struct compute_priv *s = node->priv_data;
+
+    int ret = ngli_node_update_children(node, t);
+    if (ret < 0)
+        return ret;
+
+    return ngli_pass_update(&s->pass);
+}
+
 static void compute_draw(struct ngl_node *node)
 {
     struct compute_priv *s = node->priv_data;
-    ngli_pass_exec(&s->pass);
+    int ret = ngli_pass_exec(&s->pass);
+    if (ret < 0)
+        ngli_node_set_draw_error(node, ret);
 }
 
 const struct node_class ngli_compute_class = {
@@ -179,7 +192,7 @@ const struct node_class ngli_compute_class = {
     .init      = compute_init,
     .prepare   = compute_prepare,
     .uninit    = compute_uninit,
-    .update    = ngli_node_update_children,
+    .update    = compute_update,
     .draw      = compute_draw,
     .opts_size = sizeof(struct compute_opts),
     .priv_size = sizeof(struct compute_priv),
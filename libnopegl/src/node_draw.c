@@ -226,10 +226,23 @@ static void render_uninit(struct ngl_node *node)
     ngli_pass_uninit(&s->pass);
 }
 
+static int render_update(struct ngl_node *node, double t)
+{
+    struct draw_priv *s = node->priv_data;
+
+    int ret = ngli_node_update_children(node, t);
+    if (ret < 0)
+        return ret;
+
+    return ngli_pass_update(&s->pass);
+}
+
 static void render_draw(struct ngl_node *node)
 {
     struct draw_priv *s = node->priv_data;
-    ngli_pass_exec(&s->pass);
+    int ret = ngli_pass_exec(&s->pass);
+    if (ret < 0)
+        ngli_node_set_draw_error(node, ret);
 }
 
 const struct node_class ngli_draw_class = {
@@ -239,7 +252,7 @@ const struct node_class ngli_draw_class = {
     .init      = render_init,
     .prepare   = render_prepare,
     .uninit    = render_uninit,
-    .update    = ngli_node_update_children,
+    .update    = render_update,
     .draw      = render_draw,
     .opts_size = sizeof(struct draw_opts),
     .priv_size = sizeof(struct draw_priv),
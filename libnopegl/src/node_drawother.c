@@ -281,9 +281,11 @@ struct drawwaveform_priv {
 static const struct node_param drawcolor_params[] = {
     {"color",    NGLI_PARAM_TYPE_VEC3, OFFSET(color_node), {.vec={1.f, 1.f, 1.f}},
                  .flags=NGLI_PARAM_FLAG_ALLOW_LIVE_CHANGE | NGLI_PARAM_FLAG_ALLOW_NODE,
+                 .scope=NGLI_PARAM_SCOPE_UNIFORM,
                  .desc=NGLI_DOCSTRING("color of the shape")},
     {"opacity",  NGLI_PARAM_TYPE_F32, OFFSET(opacity_node), {.f32=1.f},
                  .flags=NGLI_PARAM_FLAG_ALLOW_LIVE_CHANGE | NGLI_PARAM_FLAG_ALLOW_NODE,
+                 .scope=NGLI_PARAM_SCOPE_UNIFORM,
                  .desc=NGLI_DOCSTRING("opacity of the color")},
     COMMON_PARAMS
     {NULL}
@@ -321,27 +323,34 @@ static const struct param_choices gradient_mode_choices = {
 static const struct node_param drawgradient_params[] = {
     {"color0",   NGLI_PARAM_TYPE_VEC3, OFFSET(color0_node), {.vec={0.f, 0.f, 0.f}},
                  .flags=NGLI_PARAM_FLAG_ALLOW_LIVE_CHANGE | NGLI_PARAM_FLAG_ALLOW_NODE,
+                 .scope=NGLI_PARAM_SCOPE_UNIFORM,
                  .desc=NGLI_DOCSTRING("color of the first point")},
     {"color1",   NGLI_PARAM_TYPE_VEC3, OFFSET(color1_node), {.vec={1.f, 1.f, 1.f}},
                  .flags=NGLI_PARAM_FLAG_ALLOW_LIVE_CHANGE | NGLI_PARAM_FLAG_ALLOW_NODE,
+                 .scope=NGLI_PARAM_SCOPE_UNIFORM,
                  .desc=NGLI_DOCSTRING("color of the second point")},
     {"opacity0", NGLI_PARAM_TYPE_F32, OFFSET(opacity0_node), {.f32=1.f},
                  .flags=NGLI_PARAM_FLAG_ALLOW_LIVE_CHANGE | NGLI_PARAM_FLAG_ALLOW_NODE,
+                 .scope=NGLI_PARAM_SCOPE_UNIFORM,
                  .desc=NGLI_DOCSTRING("opacity of the first color")},
     {"opacity1", NGLI_PARAM_TYPE_F32, OFFSET(opacity1_node), {.f32=1.f},
                  .flags=NGLI_PARAM_FLAG_ALLOW_LIVE_CHANGE | NGLI_PARAM_FLAG_ALLOW_NODE,
+                 .scope=NGLI_PARAM_SCOPE_UNIFORM,
                  .desc=NGLI_DOCSTRING("opacity of the second color")},
     {"pos0",     NGLI_PARAM_TYPE_VEC2, OFFSET(pos0_node), {.vec={0.f, 0.5f}},
                  .flags=NGLI_PARAM_FLAG_ALLOW_LIVE_CHANGE | NGLI_PARAM_FLAG_ALLOW_NODE,
+                 .scope=NGLI_PARAM_SCOPE_UNIFORM,
                  .desc=NGLI_DOCSTRING("position of the first point (in UV coordinates)")},
     {"pos1",     NGLI_PARAM_TYPE_VEC2, OFFSET(pos1_node), {.vec={1.f, 0.5f}},
                  .flags=NGLI_PARAM_FLAG_ALLOW_LIVE_CHANGE | NGLI_PARAM_FLAG_ALLOW_NODE,
+                 .scope=NGLI_PARAM_SCOPE_UNIFORM,
                  .desc=NGLI_DOCSTRING("position of the second point (in UV coordinates)")},
     {"mode",     NGLI_PARAM_TYPE_SELECT, OFFSET(mode), {.i32=GRADIENT_MODE_RAMP},
                  .choices=&gradient_mode_choices,
                  .desc=NGLI_DOCSTRING("mode of interpolation between the two points")},
     {"linear",   NGLI_PARAM_TYPE_BOOL, OFFSET(linear_node), {.i32=1},
                  .flags=NGLI_PARAM_FLAG_ALLOW_LIVE_CHANGE | NGLI_PARAM_FLAG_ALLOW_NODE,
+                 .scope=NGLI_PARAM_SCOPE_UNIFORM,
                  .desc=NGLI_DOCSTRING("interpolate colors linearly")},
     COMMON_PARAMS
     {NULL}
@@ -352,30 +361,39 @@ static const struct node_param drawgradient_params[] = {
 static const struct node_param drawgradient4_params[] = {
     {"color_tl",   NGLI_PARAM_TYPE_VEC3, OFFSET(color_tl_node), {.vec={1.f, .5f, 0.f}}, /* orange */
                    .flags=NGLI_PARAM_FLAG_ALLOW_LIVE_CHANGE | NGLI_PARAM_FLAG_ALLOW_NODE,
+                   .scope=NGLI_PARAM_SCOPE_UNIFORM,
                    .desc=NGLI_DOCSTRING("top-left color")},
     {"color_tr",   NGLI_PARAM_TYPE_VEC3, OFFSET(color_tr_node), {.vec={0.f, 1.f, 0.f}}, /* green */
                    .flags=NGLI_PARAM_FLAG_ALLOW_LIVE_CHANGE | NGLI_PARAM_FLAG_ALLOW_NODE,
+                   .scope=NGLI_PARAM_SCOPE_UNIFORM,
                    .desc=NGLI_DOCSTRING("top-right color")},
     {"color_br",   NGLI_PARAM_TYPE_VEC3, OFFSET(color_br_node), {.vec={0.f, .5f, 1.f}}, /* azure */
                    .flags=NGLI_PARAM_FLAG_ALLOW_LIVE_CHANGE | NGLI_PARAM_FLAG_ALLOW_NODE,
+                   .scope=NGLI_PARAM_SCOPE_UNIFORM,
                    .desc=NGLI_DOCSTRING("bottom-right color")},
     {"color_bl",   NGLI_PARAM_TYPE_VEC3, OFFSET(color_bl_node), {.vec={1.f, .0f, 1.f}}, /* magenta */
                    .flags=NGLI_PARAM_FLAG_ALLOW_LIVE_CHANGE | NGLI_PARAM_FLAG_ALLOW_NODE,
+                   .scope=NGLI_PARAM_SCOPE_UNIFORM,
                    .desc=NGLI_DOCSTRING("bottom-left color")},
     {"opacity_tl", NGLI_PARAM_TYPE_F32, OFFSET(opacity_tl_node), {.f32=1.f},
                    .flags=NGLI_PARAM_FLAG_ALLOW_LIVE_CHANGE | NGLI_PARAM_FLAG_ALLOW_NODE,
+                   .scope=NGLI_PARAM_SCOPE_UNIFORM,
                    .desc=NGLI_DOCSTRING("opacity of the top-left color")},
     {"opacity_tr", NGLI_PARAM_TYPE_F32, OFFSET(opacity_tr_node), {.f32=1.f},
                    .flags=NGLI_PARAM_FLAG_ALLOW_LIVE_CHANGE | NGLI_PARAM_FLAG_ALLOW_NODE,
+                   .scope=NGLI_PARAM_SCOPE_UNIFORM,
                    .desc=NGLI_DOCSTRING("opacity of the top-right color")},
     {"opacity_br", NGLI_PARAM_TYPE_F32, OFFSET(opacity_br_node), {.f32=1.f},
                    .flags=NGLI_PARAM_FLAG_ALLOW_LIVE_CHANGE | NGLI_PARAM_FLAG_ALLOW_NODE,
+                   .scope=NGLI_PARAM_SCOPE_UNIFORM,
                    .desc=NGLI_DOCSTRING("opacity of the bottom-right color")},
     {"opacity_bl", NGLI_PARAM_TYPE_F32, OFFSET(opacity_bl_node), {.f32=1.f},
                    .flags=NGLI_PARAM_FLAG_ALLOW_LIVE_CHANGE | NGLI_PARAM_FLAG_ALLOW_NODE,
+                   .scope=NGLI_PARAM_SCOPE_UNIFORM,
                    .desc=NGLI_DOCSTRING("opacity of the bottol-left color")},
     {"linear",     NGLI_PARAM_TYPE_BOOL, OFFSET(linear_node), {.i32=1},
                    .flags=NGLI_PARAM_FLAG_ALLOW_LIVE_CHANGE | NGLI_PARAM_FLAG_ALLOW_NODE,
+                   .scope=NGLI_PARAM_SCOPE_UNIFORM,
                    .desc=NGLI_DOCSTRING("interpolate colors linearly")},
     COMMON_PARAMS
     {NULL}
@@ -788,8 +806,8 @@ static int init_desc(struct ngl_node *node, struct render_common *s,
 
     /* register common uniforms */
     const struct pgcraft_uniform common_uniforms[] = {
-        {.name="modelview_matrix",  .type=NGLI_TYPE_MAT4,  .stage=NGLI_PROGRAM_SHADER_VERT},
-        {.name="projection_matrix", .type=NGLI_TYPE_MAT4,  .stage=NGLI_PROGRAM_SHADER_VERT},
+        {.name="modelview_matrix",  .type=NGLI_TYPE_MAT4,  .stage=NGLI_PROGRAM_SHADER_VERT, .push_constant=1},
+        {.name="projection_matrix", .type=NGLI_TYPE_MAT4,  .stage=NGLI_PROGRAM_SHADER_VERT, .push_constant=1},
         {.name="aspect",            .type=NGLI_TYPE_F32,   .stage=NGLI_PROGRAM_SHADER_FRAG},
     };
     for (size_t i = 0; i < NGLI_ARRAY_NB(common_uniforms); i++)
@@ -111,24 +111,31 @@ static const struct node_param drawpath_params[] = {
                      .desc=NGLI_DOCSTRING("aspect ratio")},
     {"color",        NGLI_PARAM_TYPE_VEC3, OFFSET(color_node), {.vec={1.f, 1.f, 1.f}},
                      .flags=NGLI_PARAM_FLAG_ALLOW_LIVE_CHANGE | NGLI_PARAM_FLAG_ALLOW_NODE,
+                     .scope=NGLI_PARAM_SCOPE_UNIFORM,
                      .desc=NGLI_DOCSTRING("path fill color")},
     {"opacity",      NGLI_PARAM_TYPE_F32, OFFSET(opacity_node), {.f32=1.f},
                      .flags=NGLI_PARAM_FLAG_ALLOW_LIVE_CHANGE | NGLI_PARAM_FLAG_ALLOW_NODE,
+                     .scope=NGLI_PARAM_SCOPE_UNIFORM,
                      .desc=NGLI_DOCSTRING("path fill opacity")},
     {"outline",      NGLI_PARAM_TYPE_F32, OFFSET(outline_node), {.f32=.005f},
                      .flags=NGLI_PARAM_FLAG_ALLOW_LIVE_CHANGE | NGLI_PARAM_FLAG_ALLOW_NODE,
+                     .scope=NGLI_PARAM_SCOPE_UNIFORM,
                      .desc=NGLI_DOCSTRING("path outline width")},
     {"outline_color", NGLI_PARAM_TYPE_VEC3, OFFSET(outline_color_node), {.vec={1.f, .7f, 0.f}},
                      .flags=NGLI_PARAM_FLAG_ALLOW_LIVE_CHANGE | NGLI_PARAM_FLAG_ALLOW_NODE,
+                     .scope=NGLI_PARAM_SCOPE_UNIFORM,
                      .desc=NGLI_DOCSTRING("path outline color")},
     {"glow",         NGLI_PARAM_TYPE_F32, OFFSET(glow_node),
                      .flags=NGLI_PARAM_FLAG_ALLOW_LIVE_CHANGE | NGLI_PARAM_FLAG_ALLOW_NODE,
+                     .scope=NGLI_PARAM_SCOPE_UNIFORM,
                      .desc=NGLI_DOCSTRING("path glow width")},
     {"glow_color",   NGLI_PARAM_TYPE_VEC3, OFFSET(glow_color_node), {.vec={1.f, 1.f, 1.f}},
                      .flags=NGLI_PARAM_FLAG_ALLOW_LIVE_CHANGE | NGLI_PARAM_FLAG_ALLOW_NODE,
+                     .scope=NGLI_PARAM_SCOPE_UNIFORM,
                      .desc=NGLI_DOCSTRING("path glow color")},
     {"blur",         NGLI_PARAM_TYPE_F32, OFFSET(blur_node),
                      .flags=NGLI_PARAM_FLAG_ALLOW_LIVE_CHANGE | NGLI_PARAM_FLAG_ALLOW_NODE,
+                     .scope=NGLI_PARAM_SCOPE_UNIFORM,
                      .desc=NGLI_DOCSTRING("path blur")},
     {NULL}
 };
@@ -334,8 +341,8 @@ static int drawpath_prepare(struct ngl_node *node)
     struct drawpath_opts *o = node->opts;
 
     const struct pgcraft_uniform uniforms[] = {
-        {.name="modelview_matrix",  .type=NGLI_TYPE_MAT4,  .stage=NGLI_PROGRAM_SHADER_VERT},
-        {.name="projection_matrix", .type=NGLI_TYPE_MAT4,  .stage=NGLI_PROGRAM_SHADER_VERT},
+        {.name="modelview_matrix",  .type=NGLI_TYPE_MAT4,  .stage=NGLI_PROGRAM_SHADER_VERT, .push_constant=1},
+        {.name="projection_matrix", .type=NGLI_TYPE_MAT4,  .stage=NGLI_PROGRAM_SHADER_VERT, .push_constant=1},
         {.name="transform",         .type=NGLI_TYPE_MAT4,  .stage=NGLI_PROGRAM_SHADER_VERT},
 
         {.name="debug",             .type=NGLI_TYPE_BOOL,  .stage=NGLI_PROGRAM_SHADER_FRAG},
@@ -71,11 +71,13 @@ struct fgblur_priv {
     int32_t max_lod;
     float bluriness;
 
-    /* Intermediates Mips used by the blur passses */
+    /*
+     * Intermediates Mips used by the blur passses, only the levels required
+     * by the current bluriness are acquired from the context pool during the
+     * draw
+     */
     struct rendertarget_layout mip_layout;
-
-    struct rtt_ctx *mip;
-    struct rtt_ctx *mips[MAX_MIP_LEVELS];
+    struct texture_params mip_params[MAX_MIP_LEVELS];
 
     struct gpu_block down_up_data_block;
 
@@ -376,39 +378,9 @@ static int resize(struct ngl_node *node)
                          NGLI_TEXTURE_USAGE_SAMPLED_BIT,
     };
 
-    struct rtt_ctx *mip = NULL;
-    struct rtt_ctx *mips[MAX_MIP_LEVELS] = {0};
-
     struct texture *dst = NULL;
     struct rtt_ctx *dst_rtt_ctx = NULL;
 
-    mip = ngli_rtt_create(ctx);
-    if (!mip)
-        return NGL_ERROR_MEMORY;
-
-    ret = ngli_rtt_from_texture_params(mip, &texture_params);
-    if (ret < 0)
-        goto fail;
-
-    int32_t mip_width = width;
-    int32_t mip_height = height;
-    for (size_t i = 0; i < MAX_MIP_LEVELS; i++) {
-        mips[i] = ngli_rtt_create(ctx);
-        if (!mips[i]) {
-            ret = NGL_ERROR_MEMORY;
-            goto fail;
-        }
-
-        texture_params.width = mip_width;
-        texture_params.height = mip_height;
-        ret = ngli_rtt_from_texture_params(mips[i], &texture_params);
-        if (ret < 0)
-            goto fail;
-
-        mip_width = NGLI_MAX(mip_width >> 1, 1);
-        mip_height = NGLI_MAX(mip_height >> 1, 1);
-    }
-
     dst = dst_priv->texture;
     if (s->dst_is_resizeable) {
         dst = ngli_texture_create(ctx->gpu_ctx);
@@ -437,7 +409,8 @@ static int resize(struct ngl_node *node)
         .nb_colors = 1,
         .colors[0] = {
             .attachment = dst,
-            .load_op = NGLI_LOAD_OP_CLEAR,
+            /* Fully overwritten by the interpolation pass */
+            .load_op = NGLI_LOAD_OP_DONT_CARE,
             .store_op = NGLI_STORE_OP_STORE,
         },
     };
@@ -446,12 +419,15 @@ static int resize(struct ngl_node *node)
     if (ret < 0)
         goto fail;
 
-    ngli_rtt_freep(&s->mip);
-    s->mip = mip;
-
+    int32_t mip_width = width;
+    int32_t mip_height = height;
     for (size_t i = 0; i < MAX_MIP_LEVELS; i++) {
-        ngli_rtt_freep(&s->mips[i]);
-        s->mips[i] = mips[i];
+        texture_params.width = mip_width;
+        texture_params.height = mip_height;
+        s->mip_params[i] = texture_params;
+
+        mip_width = NGLI_MAX(mip_width >> 1, 1);
+        mip_height = NGLI_MAX(mip_height >> 1, 1);
     }
 
     if (s->dst_is_resizeable) {
@@ -481,10 +457,6 @@ static int resize(struct ngl_node *node)
     return 0;
 
 fail:
-    ngli_rtt_freep(&mip);
-    for (size_t i = 0; i < MAX_MIP_LEVELS; i++)
-        ngli_rtt_freep(&mips[i]);
-
     ngli_rtt_freep(&dst_rtt_ctx);
     if (s->dst_is_resizeable)
         ngli_texture_freep(&dst);
@@ -551,15 +523,28 @@ static void fgblur_draw(struct ngl_node *node)
     const int32_t lod_i = (int32_t)lod;
     const float lod_f = lod - (float)lod_i;
 
+    struct rtt_ctx *full_mip = NULL;
+    struct rtt_ctx *mips[MAX_MIP_LEVELS] = {0};
+    for (int32_t i = 0; i <= lod_i + 1; i++) {
+        mips[i] = ngli_rtt_pool_acquire(ctx, &s->mip_params[i], 1);
+        if (!mips[i])
+            goto end;
+    }
+    if (lod_i > 0) {
+        full_mip = ngli_rtt_pool_acquire(ctx, &s->mip_params[0], 1);
+        if (!full_mip)
+            goto end;
+    }
+
     /* Downsample source to mips[1] */
     struct texture_priv *src_priv = (struct texture_priv *)o->source->priv_data;
     const struct image *src_image = &src_priv->image;
     struct texture *mip = src_image->planes[0];
-    execute_down_up_pass(ctx, s->mips[1], s->dws.pl, mip);
+    execute_down_up_pass(ctx, mips[1], s->dws.pl, mip);
 
     /* Downsample successively until mips[lod_i+1] is generated */
     for (int32_t i = 2; i <= lod_i + 1; i++)
-        execute_down_up_pass(ctx, s->mips[i], s->dws.pl, ngli_rtt_get_texture(s->mips[i - 1], 0));
+        execute_down_up_pass(ctx, mips[i], s->dws.pl, ngli_rtt_get_texture(mips[i - 1], 0));
 
     /*
      * Upsample successively from mips[lod_i] back to full resolution and store
@@ -567,9 +552,9 @@ static void fgblur_draw(struct ngl_node *node)
      */
     if (lod_i > 0) {
         for (int32_t i = lod_i - 1; i > 0; i--)
-            execute_down_up_pass(ctx, s->mips[i], s->ups.pl, ngli_rtt_get_texture(s->mips[i + 1], 0));
-        execute_down_up_pass(ctx, s->mip, s->ups.pl, ngli_rtt_get_texture(s->mips[1], 0));
-        mip = ngli_rtt_get_texture(s->mip, 0);
+            execute_down_up_pass(ctx, mips[i], s->ups.pl, ngli_rtt_get_texture(mips[i + 1], 0));
+        execute_down_up_pass(ctx, full_mip, s->ups.pl, ngli_rtt_get_texture(mips[1], 0));
+        mip = ngli_rtt_get_texture(full_mip, 0);
     }
 
     /*
@@ -577,7 +562,7 @@ static void fgblur_draw(struct ngl_node *node)
      * store the result in mips[0]
      */
     for (int32_t i = lod_i; i >= 0; i--)
-        execute_down_up_pass(ctx, s->mips[i], s->ups.pl, ngli_rtt_get_texture(s->mips[i + 1], 0));
+        execute_down_up_pass(ctx, mips[i], s->ups.pl, ngli_rtt_get_texture(mips[i + 1], 0));
 
     const struct interpolate_block interpolate_block = {.lod = lod_f};
     ngli_gpu_block_update(&s->interpolate.block, 0, &interpolate_block);
@@ -590,7 +575,7 @@ static void fgblur_draw(struct ngl_node *node)
     ngli_gpu_ctx_begin_render_pass(ctx->gpu_ctx, ctx->current_rendertarget);
     ctx->render_pass_started = 1;
     ngli_pipeline_compat_update_texture(s->interpolate.pl, 0, mip);
-    ngli_pipeline_compat_update_texture(s->interpolate.pl, 1, ngli_rtt_get_texture(s->mips[0], 0));
+    ngli_pipeline_compat_update_texture(s->interpolate.pl, 1, ngli_rtt_get_texture(mips[0], 0));
     ngli_pipeline_compat_draw(s->interpolate.pl, 3, 1);
     ngli_rtt_end(s->dst_rtt_ctx);
 
@@ -602,16 +587,17 @@ static void fgblur_draw(struct ngl_node *node)
     struct texture_priv *dst_priv = (struct texture_priv *)o->destination->priv_data;
     struct image *dst_image = &dst_priv->image;
     memcpy(dst_image->coordinates_matrix, src_image->coordinates_matrix, sizeof(src_image->coordinates_matrix));
+
+end:
+    ngli_rtt_pool_release(&full_mip);
+    for (size_t i = 0; i < MAX_MIP_LEVELS; i++)
+        ngli_rtt_pool_release(&mips[i]);
 }
 
 static void fgblur_release(struct ngl_node *node)
 {
     struct fgblur_priv *s = node->priv_data;
 
-    ngli_rtt_freep(&s->mip);
-    for (size_t i = 0; i < MAX_MIP_LEVELS; i++)
-        ngli_rtt_freep(&s->mips[i]);
-
     ngli_rtt_freep(&s->dst_rtt_ctx);
 }
 
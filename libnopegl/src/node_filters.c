@@ -149,6 +149,7 @@ NGLI_STATIC_ASSERT(filter_on_top_of_srgb2linear_priv,   offsetof(struct filtersr
 static const struct node_param filteralpha_params[] = {
     {"alpha", NGLI_PARAM_TYPE_F32, OFFSET(alpha_node), {.f32=1.f},
               .flags=NGLI_PARAM_FLAG_ALLOW_LIVE_CHANGE | NGLI_PARAM_FLAG_ALLOW_NODE,
+              .scope=NGLI_PARAM_SCOPE_UNIFORM,
               .desc=NGLI_DOCSTRING("alpha channel value")},
     {NULL}
 };
@@ -167,9 +168,11 @@ static const struct node_param filtercolormap_params[] = {
 static const struct node_param filtercontrast_params[] = {
     {"contrast",  NGLI_PARAM_TYPE_F32, OFFSET(contrast_node), {.f32=1.f},
                   .flags=NGLI_PARAM_FLAG_ALLOW_LIVE_CHANGE | NGLI_PARAM_FLAG_ALLOW_NODE,
+                  .scope=NGLI_PARAM_SCOPE_UNIFORM,
                   .desc=NGLI_DOCSTRING("perceptual contrast value")},
     {"pivot",     NGLI_PARAM_TYPE_F32, OFFSET(pivot_node), {.f32=.5f},
                   .flags=NGLI_PARAM_FLAG_ALLOW_LIVE_CHANGE | NGLI_PARAM_FLAG_ALLOW_NODE,
+                  .scope=NGLI_PARAM_SCOPE_UNIFORM,
                   .desc=NGLI_DOCSTRING("pivot point between light and dark")},
     {NULL}
 };
@@ -179,6 +182,7 @@ static const struct node_param filtercontrast_params[] = {
 static const struct node_param filterexposure_params[] = {
     {"exposure", NGLI_PARAM_TYPE_F32, OFFSET(exposure_node),
                  .flags=NGLI_PARAM_FLAG_ALLOW_LIVE_CHANGE | NGLI_PARAM_FLAG_ALLOW_NODE,
+                 .scope=NGLI_PARAM_SCOPE_UNIFORM,
                  .desc=NGLI_DOCSTRING("exposure")},
     {NULL}
 };
@@ -191,6 +195,7 @@ static const struct node_param filterexposure_params[] = {
 static const struct node_param filteropacity_params[] = {
     {"opacity", NGLI_PARAM_TYPE_F32, OFFSET(opacity_node), {.f32=1.f},
               .flags=NGLI_PARAM_FLAG_ALLOW_LIVE_CHANGE | NGLI_PARAM_FLAG_ALLOW_NODE,
+              .scope=NGLI_PARAM_SCOPE_UNIFORM,
               .desc=NGLI_DOCSTRING("opacity value (color gets premultiplied by this value)")},
     {NULL}
 };
@@ -202,6 +207,7 @@ static const struct node_param filteropacity_params[] = {
 static const struct node_param filtersaturation_params[] = {
     {"saturation", NGLI_PARAM_TYPE_F32, OFFSET(saturation_node), {.f32=1.f},
                    .flags=NGLI_PARAM_FLAG_ALLOW_LIVE_CHANGE | NGLI_PARAM_FLAG_ALLOW_NODE,
+                   .scope=NGLI_PARAM_SCOPE_UNIFORM,
                    .desc=NGLI_DOCSTRING("saturation")},
     {NULL}
 };
@@ -255,6 +261,7 @@ static const struct param_choices selector_output_choices = {
 static const struct node_param filterselector_params[] = {
     {"range",        NGLI_PARAM_TYPE_VEC2, OFFSET(range_node), {.vec={0.f, 1.f}},
                      .flags=NGLI_PARAM_FLAG_ALLOW_LIVE_CHANGE | NGLI_PARAM_FLAG_ALLOW_NODE,
+                     .scope=NGLI_PARAM_SCOPE_UNIFORM,
                      .desc=NGLI_DOCSTRING("values within this range are selected")},
     {"component",    NGLI_PARAM_TYPE_SELECT, OFFSET(component), {.i32=SELECTOR_COMPONENT_LIGHTNESS},
                      .choices=&selector_component_choices,
@@ -267,6 +274,7 @@ static const struct node_param filterselector_params[] = {
                      .desc=NGLI_DOCSTRING("define the output color")},
     {"smoothedges",  NGLI_PARAM_TYPE_BOOL, OFFSET(smoothedges_node), {.i32=0},
                      .flags=NGLI_PARAM_FLAG_ALLOW_LIVE_CHANGE | NGLI_PARAM_FLAG_ALLOW_NODE,
+                     .scope=NGLI_PARAM_SCOPE_UNIFORM,
                      .desc=NGLI_DOCSTRING("make edges less sharp")},
     {NULL}
 };
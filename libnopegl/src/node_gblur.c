@@ -75,9 +75,12 @@ struct gblur_priv {
     struct image *image;
     size_t image_rev;
 
-    /* Render the horizontal pass to a temporary destination */
+    /*
+     * Render the horizontal pass to a temporary destination, acquired from
+     * the context pool for the duration of the draw
+     */
     struct rendertarget_layout tmp_layout;
-    struct rtt_ctx *tmp;
+    struct texture_params tmp_params;
 
     /* Render the vertical pass to the destination */
     int dst_is_resizeable;
@@ -359,8 +362,6 @@ static int resize(struct ngl_node *node)
     struct texture_priv *dst_priv = o->destination->priv_data;
     ngli_assert(dst_priv->params.format == s->dst_layout.colors[0].format);
 
-    struct rtt_ctx *tmp = NULL;
-
     struct texture *dst = NULL;
     struct rtt_ctx *dst_rtt_ctx = NULL;
 
@@ -377,16 +378,6 @@ static int resize(struct ngl_node *node)
                          NGLI_TEXTURE_USAGE_SAMPLED_BIT,
     };
 
-    tmp = ngli_rtt_create(ctx);
-    if (!tmp) {
-        ret = NGL_ERROR_MEMORY;
-        goto fail;
-    }
-
-    ret = ngli_rtt_from_texture_params(tmp, &texture_params);
-    if (ret < 0)
-        goto fail;
-
     dst = dst_priv->texture;
     if (s->dst_is_resizeable) {
         dst = ngli_texture_create(ctx->gpu_ctx);
@@ -403,8 +394,7 @@ static int resize(struct ngl_node *node)
             goto fail;
     }
 
-    ngli_rtt_freep(&s->tmp);
-    s->tmp = tmp;
+    s->tmp_params = texture_params;
 
     if (s->dst_is_resizeable) {
         ngli_texture_freep(&dst_priv->texture);
@@ -427,7 +417,8 @@ static int resize(struct ngl_node *node)
         .nb_colors = 1,
         .colors[0] = {
             .attachment = dst,
-            .load_op = NGLI_LOAD_OP_CLEAR,
+            /* Fully overwritten by the vertical pass */
+            .load_op = NGLI_LOAD_OP_DONT_CARE,
             .store_op = NGLI_STORE_OP_STORE,
         },
     };
@@ -448,8 +439,6 @@ static int resize(struct ngl_node *node)
     return 0;
 
 fail:
-    ngli_rtt_freep(&tmp);
-
     ngli_rtt_freep(&dst_rtt_ctx);
     if (s->dst_is_resizeable)
         ngli_texture_freep(&dst);
@@ -472,7 +461,11 @@ static void gblur_draw(struct ngl_node *node)
     if (ret < 0)
         return;
 
-    ngli_rtt_begin(s->tmp);
+    struct rtt_ctx *tmp = ngli_rtt_pool_acquire(ctx, &s->tmp_params, 1);
+    if (!tmp)
+        return;
+
+    ngli_rtt_begin(tmp);
     ngli_gpu_ctx_begin_render_pass(gpu_ctx, ctx->current_rendertarget);
     ctx->render_pass_started = 1;
     uint32_t offset = 0;
@@ -482,23 +475,24 @@ static void gblur_draw(struct ngl_node *node)
         s->image_rev = s->image->rev;
     }
     ngli_pipeline_compat_draw(s->pl_blur_h, 3, 1);
-    ngli_rtt_end(s->tmp);
+    ngli_rtt_end(tmp);
 
     ngli_rtt_begin(s->dst_rtt_ctx);
     ngli_gpu_ctx_begin_render_pass(gpu_ctx, ctx->current_rendertarget);
     ctx->render_pass_started = 1;
     offset = (uint32_t)s->direction.block_size;
     ngli_pipeline_compat_update_dynamic_offsets(s->pl_blur_v, &offset, 1);
-    ngli_pipeline_compat_update_texture(s->pl_blur_v, 0, ngli_rtt_get_texture(s->tmp, 0));
+    ngli_pipeline_compat_update_texture(s->pl_blur_v, 0, ngli_rtt_get_texture(tmp, 0));
     ngli_pipeline_compat_draw(s->pl_blur_v, 3, 1);
     ngli_rtt_end(s->dst_rtt_ctx);
+
+    ngli_rtt_pool_release(&tmp);
 }
 
 static void gblur_release(struct ngl_node *node)
 {
     struct gblur_priv *s = node->priv_data;
 
-    ngli_rtt_freep(&s->tmp);
     ngli_rtt_freep(&s->dst_rtt_ctx);
 }
 
@@ -131,15 +131,16 @@ static void gridlayout_draw(struct ngl_node *node)
     const struct gridlayout_opts *o = node->opts;
 
     struct rnode *rnode_pos = ctx->rnode_pos;
-    struct rnode *rnodes = ngli_darray_data(&rnode_pos->children);
+    struct rnode **rnodes = ngli_darray_data(&rnode_pos->children);
 
     const float *matrices = ngli_darray_data(&s->matrices);
     for (size_t i = 0; i < o->nb_children; i++) {
-        ctx->rnode_pos = &rnodes[i];
+        ctx->rnode_pos = rnodes[i];
         s->trf.child = o->children[i];
 
         const float *matrix = &matrices[i * 4 * 4];
         memcpy(s->trf.matrix, matrix, sizeof(s->trf.matrix));
+        ngli_transform_fold(&s->trf);
 
         ngli_transform_draw(node);
     }
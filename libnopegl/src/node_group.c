@@ -67,9 +67,9 @@ static void group_draw(struct ngl_node *node)
     const struct group_opts *o = node->opts;
 
     struct rnode *rnode_pos = ctx->rnode_pos;
-    struct rnode *rnodes = ngli_darray_data(&rnode_pos->children);
+    struct rnode **rnodes = ngli_darray_data(&rnode_pos->children);
     for (size_t i = 0; i < o->nb_children; i++) {
-        ctx->rnode_pos = &rnodes[i];
+        ctx->rnode_pos = rnodes[i];
         struct ngl_node *child = o->children[i];
         ngli_node_draw(child);
     }
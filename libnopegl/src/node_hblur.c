@@ -71,12 +71,14 @@ struct hblur_priv {
     struct gpu_block blur_params_block;
 
     int prefered_format;
-    struct texture *tex0;
-    struct texture *tex1;
 
+    /*
+     * The first pass renders to two intermediate textures acquired from the
+     * context pool for the duration of the draw
+     */
     struct {
         struct rendertarget_layout layout;
-        struct rtt_ctx *rtt_ctx;
+        struct texture_params texture_params;
         struct pgcraft *crafter;
         struct pipeline_compat *pl;
     } pass1;
@@ -447,16 +449,13 @@ static int resize(struct ngl_node *node)
         return 0;
 
     struct texture *dst = NULL;
-    struct texture *tex0 = ngli_texture_create(ctx->gpu_ctx);
-    struct texture *tex1 = ngli_texture_create(ctx->gpu_ctx);
-    struct rtt_ctx *pass1_rtt_ctx = ngli_rtt_create(ctx);
     struct rtt_ctx *pass2_rtt_ctx = ngli_rtt_create(ctx);
-    if (!tex0 || !tex1 || !pass1_rtt_ctx || !pass2_rtt_ctx) {
+    if (!pass2_rtt_ctx) {
         ret = NGL_ERROR_MEMORY;
         goto fail;
     }
 
-    struct texture_params texture_params = {
+    const struct texture_params texture_params = {
         .type          = NGLI_TEXTURE_TYPE_2D,
         .format        = s->prefered_format,
         .width         = width,
@@ -469,32 +468,6 @@ static int resize(struct ngl_node *node)
                          NGLI_TEXTURE_USAGE_SAMPLED_BIT,
     };
 
-    ret = ngli_texture_init(tex0, &texture_params);
-    if (ret < 0)
-        goto fail;
-
-    ret = ngli_texture_init(tex1, &texture_params);
-    if (ret < 0)
-        goto fail;
-
-    struct rtt_params pass1_rtt_params = {
-        .width = width,
-        .height = height,
-        .nb_colors = 2,
-        .colors[0] = {
-            .attachment = tex0,
-            .store_op = NGLI_STORE_OP_STORE
-        },
-        .colors[1] = {
-            .attachment = tex1,
-            .store_op = NGLI_STORE_OP_STORE
-        },
-    };
-
-    ret = ngli_rtt_init(pass1_rtt_ctx, &pass1_rtt_params);
-    if (ret < 0)
-        goto fail;
-
     /* Assert that the destination texture format does not change */
     struct texture_priv *dst_priv = o->destination->priv_data;
     ngli_assert(dst_priv->params.format == s->pass2.layout.colors[0].format);
@@ -521,7 +494,8 @@ static int resize(struct ngl_node *node)
         .nb_colors = 1,
         .colors[0] = {
             .attachment = dst,
-            .load_op = NGLI_LOAD_OP_CLEAR,
+            /* Fully overwritten by the second pass */
+            .load_op = NGLI_LOAD_OP_DONT_CARE,
             .store_op = NGLI_STORE_OP_STORE,
         },
     };
@@ -530,21 +504,11 @@ static int resize(struct ngl_node *node)
     if (ret < 0)
         goto fail;
 
-    ngli_rtt_freep(&s->pass1.rtt_ctx);
-    s->pass1.rtt_ctx = pass1_rtt_ctx;
-
-    ngli_texture_freep(&s->tex0);
-    s->tex0 = tex0;
-
-    ngli_texture_freep(&s->tex1);
-    s->tex1 = tex1;
+    s->pass1.texture_params = texture_params;
 
     ngli_rtt_freep(&s->pass2.rtt_ctx);
     s->pass2.rtt_ctx = pass2_rtt_ctx;
 
-    ngli_pipeline_compat_update_texture(s->pass2.pl, 0, s->tex0);
-    ngli_pipeline_compat_update_texture(s->pass2.pl, 1, s->tex1);
-
     if (s->dst_is_resizeable) {
         ngli_texture_freep(&dst_priv->texture);
         dst_priv->texture = dst;
@@ -560,10 +524,6 @@ static int resize(struct ngl_node *node)
     return 0;
 
 fail:
-    ngli_texture_freep(&tex0);
-    ngli_texture_freep(&tex1);
-    ngli_rtt_freep(&pass1_rtt_ctx);
-
     ngli_rtt_freep(&pass2_rtt_ctx);
     if (s->dst_is_resizeable)
         ngli_texture_freep(&dst);
@@ -596,7 +556,11 @@ static void hblur_draw(struct ngl_node *node)
         .nb_samples = nb_samples,
     });
 
-    ngli_rtt_begin(s->pass1.rtt_ctx);
+    struct rtt_ctx *pass1_rtt_ctx = ngli_rtt_pool_acquire(ctx, &s->pass1.texture_params, 2);
+    if (!pass1_rtt_ctx)
+        return;
+
+    ngli_rtt_begin(pass1_rtt_ctx);
     ngli_gpu_ctx_begin_render_pass(gpu_ctx, ctx->current_rendertarget);
     ctx->render_pass_started = 1;
     if (s->image_rev != s->image->rev) {
@@ -608,11 +572,13 @@ static void hblur_draw(struct ngl_node *node)
         s->image_rev = s->map_image->rev;
     }
     ngli_pipeline_compat_draw(s->pass1.pl, 3, 1);
-    ngli_rtt_end(s->pass1.rtt_ctx);
+    ngli_rtt_end(pass1_rtt_ctx);
 
     ngli_rtt_begin(s->pass2.rtt_ctx);
     ngli_gpu_ctx_begin_render_pass(gpu_ctx, ctx->current_rendertarget);
     ctx->render_pass_started = 1;
+    ngli_pipeline_compat_update_texture(s->pass2.pl, 0, ngli_rtt_get_texture(pass1_rtt_ctx, 0));
+    ngli_pipeline_compat_update_texture(s->pass2.pl, 1, ngli_rtt_get_texture(pass1_rtt_ctx, 1));
     if (s->map_rev != s->map_image->rev) {
         ngli_pipeline_compat_update_image(s->pass2.pl, 2, s->map_image);
         s->image_rev = s->map_image->rev;
@@ -620,6 +586,8 @@ static void hblur_draw(struct ngl_node *node)
     ngli_pipeline_compat_draw(s->pass2.pl, 3, 1);
     ngli_rtt_end(s->pass2.rtt_ctx);
 
+    ngli_rtt_pool_release(&pass1_rtt_ctx);
+
     /*
      * The blur render passes do not deal with the texture coordinates at all,
      * thus we need to forward the source coordinates matrix to the
@@ -634,9 +602,6 @@ static void hblur_release(struct ngl_node *node)
 {
     struct hblur_priv *s = node->priv_data;
 
-    ngli_texture_freep(&s->tex0);
-    ngli_texture_freep(&s->tex1);
-    ngli_rtt_freep(&s->pass1.rtt_ctx);
     ngli_rtt_freep(&s->pass2.rtt_ctx);
 }
 
@@ -26,6 +26,7 @@
 #include "internal.h"
 #include "noise.h"
 #include "type.h"
+#include "utils.h"
 
 struct noise_opts {
     float frequency;
@@ -35,7 +36,7 @@ struct noise_opts {
 struct noise_priv {
     struct variable_info var;
     float vector[4];
-    struct noise generator[4];
+    struct noisevec generator;
 };
 
 const struct param_choices noise_func_choices = {
@@ -75,52 +76,46 @@ static const struct node_param noise_params[] = {
 
 NGLI_STATIC_ASSERT(variable_info_is_first, offsetof(struct noise_priv, var) == 0);
 
-static int noisevec_update(struct ngl_node *node, double t, int n)
+static int noisevec_update(struct ngl_node *node, double t)
 {
     struct noise_priv *s = node->priv_data;
     const struct noise_opts *o = node->opts;
     const float v = (float)(t * o->frequency);
-    for (int i = 0; i < n; i++)
-        s->vector[i] = ngli_noise_get(&s->generator[i], v);
+    ngli_noisevec_get(&s->generator, v, s->vector);
     return 0;
 }
 
-static int noisefloat_update(struct ngl_node *node, double t)
+static size_t get_nb_components(const struct ngl_node *node)
 {
-    return noisevec_update(node, t, 1);
-}
-
-static int noisevec2_update(struct ngl_node *node, double t)
-{
-    return noisevec_update(node, t, 2);
+    switch (node->cls->id) {
+    case NGL_NODE_NOISEVEC2: return 2;
+    case NGL_NODE_NOISEVEC3: return 3;
+    case NGL_NODE_NOISEVEC4: return 4;
+    }
+    return 1;
 }
 
-static int noisevec3_update(struct ngl_node *node, double t)
+/* Used for standalone evaluation (outside a context) */
+int ngli_noise_evaluate_batch(struct ngl_node *node, float *dst, const double *times, size_t nb_times)
 {
-    return noisevec_update(node, t, 3);
-}
+    const struct noise_opts *o = node->opts;
+    const size_t nb_components = get_nb_components(node);
 
-static int noisevec4_update(struct ngl_node *node, double t)
-{
-    return noisevec_update(node, t, 4);
-}
+    /* The generator is private so that concurrent evaluations do not share any state */
+    struct noisevec generator;
+    int ret = ngli_noisevec_init(&generator, &o->generator_params, nb_components);
+    if (ret < 0)
+        return ret;
 
-static int init_noise_generators(struct noise_priv *s, const struct noise_opts *o, int n)
-{
-    /*
-     * Every generator is instanciated the same, except for the seed: the seed
-     * offset is defined to create a large gap between every components to keep
-     * the overlap to the minimum possible
-     */
-    const uint32_t seed_offset = UINT32_MAX / n;
-    uint32_t seed = o->generator_params.seed;
-    for (int i = 0; i < n; i++) {
-        struct noise_params np = o->generator_params;
-        np.seed = seed;
-        int ret = ngli_noise_init(&s->generator[i], &np);
-        if (ret < 0)
-            return ret;
-        seed += seed_offset;
+    float t[64];
+    while (nb_times) {
+        const size_t n = NGLI_MIN(nb_times, NGLI_ARRAY_NB(t));
+        for (size_t i = 0; i < n; i++)
+            t[i] = (float)(times[i] * o->frequency);
+        ngli_noisevec_get_batch(&generator, t, n, dst);
+        times += n;
+        dst += n * nb_components;
+        nb_times -= n;
     }
     return 0;
 }
@@ -134,7 +129,7 @@ static int noise##type##_init(struct ngl_node *node)                        \
     s->var.data_size = count * sizeof(float);                               \
     s->var.data_type = dtype;                                               \
     s->var.dynamic = 1;                                                     \
-    return init_noise_generators(s, o, count);                              \
+    return ngli_noisevec_init(&s->generator, &o->generator_params, count);  \
 }                                                                           \
                                                                             \
 const struct node_class ngli_noise##type##_class = {                        \
@@ -142,7 +137,7 @@ const struct node_class ngli_noise##type##_class = {                        \
     .category  = NGLI_NODE_CATEGORY_VARIABLE,                               \
     .name      = class_name,                                                \
     .init      = noise##type##_init,                                        \
-    .update    = noise##type##_update,                                      \
+    .update    = noisevec_update,                                           \
     .opts_size = sizeof(struct noise_opts),                                 \
     .priv_size = sizeof(struct noise_priv),                                 \
     .params    = noise_params,                                              \
@@ -67,6 +67,8 @@ static int rotate_init(struct ngl_node *node)
     if (!o->angle_node)
         update_trf_matrix(node, o->angle);
     s->trf.child = o->child;
+    s->trf.is_static = !o->angle_node;
+    ngli_transform_fold(&s->trf);
     return 0;
 }
 
@@ -87,7 +89,7 @@ static int rotate_update(struct ngl_node *node, double t)
         struct variable_info *angle = o->angle_node->priv_data;
         update_trf_matrix(node, *(float *)angle->data);
     }
-    return ngli_node_update(o->child, t);
+    return ngli_transform_update_child(node, t);
 }
 
 #define OFFSET(x) offsetof(struct rotate_opts, x)
@@ -114,6 +116,7 @@ const struct node_class ngli_rotate_class = {
     .name      = "Rotate",
     .init      = rotate_init,
     .update    = rotate_update,
+    .invalidate = ngli_transform_invalidate,
     .draw      = ngli_transform_draw,
     .opts_size = sizeof(struct rotate_opts),
     .priv_size = sizeof(struct rotate_priv),
@@ -58,6 +58,8 @@ static int rotatequat_init(struct ngl_node *node)
     if (!o->quat_node)
         update_trf_matrix(node, o->quat);
     s->trf.child = o->child;
+    s->trf.is_static = !o->quat_node;
+    ngli_transform_fold(&s->trf);
     return 0;
 }
 
@@ -78,7 +80,7 @@ static int rotatequat_update(struct ngl_node *node, double t)
         struct variable_info *quat = o->quat_node->priv_data;
         update_trf_matrix(node, quat->data);
     }
-    return ngli_node_update(o->child, t);
+    return ngli_transform_update_child(node, t);
 }
 
 #define OFFSET(x) offsetof(struct rotatequat_opts, x)
@@ -103,6 +105,7 @@ const struct node_class ngli_rotatequat_class = {
     .name      = "RotateQuat",
     .init      = rotatequat_init,
     .update    = rotatequat_update,
+    .invalidate = ngli_transform_invalidate,
     .draw      = ngli_transform_draw,
     .opts_size = sizeof(struct rotatequat_opts),
     .priv_size = sizeof(struct rotatequat_priv),
@@ -119,6 +119,35 @@ static struct rtt_texture_info get_rtt_texture_info(struct ngl_node *node)
     }
 }
 
+/*
+ * A texture only referenced as a render target destination (directly or
+ * through texture views) is never sampled by the graph: its content does not
+ * need to be stored at the end of the render pass.
+ */
+static int is_texture_consumed(const struct ngl_node *node)
+{
+    const struct ngl_node **parents = ngli_darray_data(&node->parents);
+    for (size_t i = 0; i < ngli_darray_count(&node->parents); i++) {
+        const struct ngl_node *parent = parents[i];
+        if (parent->cls->id == NGL_NODE_TEXTUREVIEW) {
+            if (is_texture_consumed(parent))
+                return 1;
+        } else if (parent->cls->id != NGL_NODE_RENDERTOTEXTURE) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int get_store_op(const struct ngl_node *node)
+{
+    if (node->cls->id == NGL_NODE_TEXTUREVIEW) {
+        const struct textureview_opts *textureview_opts = node->opts;
+        node = textureview_opts->texture;
+    }
+    return is_texture_consumed(node) ? NGLI_STORE_OP_STORE : NGLI_STORE_OP_DONT_CARE;
+}
+
 static int rtt_init(struct ngl_node *node)
 {
     struct ngl_ctx *ctx = node->ctx;
@@ -281,6 +310,7 @@ static int rtt_prefetch(struct ngl_node *node)
         const struct rtt_texture_info info = get_rtt_texture_info(o->color_textures[i]);
         struct texture_priv *texture_priv = info.texture_priv;
         struct texture *texture = texture_priv->texture;
+        const int store_op = get_store_op(o->color_textures[i]);
         const int32_t layer_end = info.layer_base + info.layer_count;
         for (int32_t j = info.layer_base; j < layer_end; j++) {
             s->rtt_params.colors[s->rtt_params.nb_colors++] = (struct attachment) {
@@ -288,7 +318,7 @@ static int rtt_prefetch(struct ngl_node *node)
                 .attachment_layer = j,
                 .load_op          = NGLI_LOAD_OP_CLEAR,
                 .clear_value      = {NGLI_ARG_VEC4(o->clear_color)},
-                .store_op         = NGLI_STORE_OP_STORE,
+                .store_op         = store_op,
             };
         }
         /* Transform the color textures coordinates so it matches how the
@@ -306,7 +336,7 @@ static int rtt_prefetch(struct ngl_node *node)
             .attachment       = texture,
             .attachment_layer = info.layer_base,
             .load_op          = NGLI_LOAD_OP_CLEAR,
-            .store_op         = NGLI_STORE_OP_STORE,
+            .store_op         = get_store_op(o->depth_texture),
         };
         /* Transform the depth texture coordinates so it matches how the
          * graphics context uv coordinate system works */
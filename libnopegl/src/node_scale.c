@@ -57,6 +57,8 @@ static int scale_init(struct ngl_node *node)
     if (!o->factors_node)
         update_trf_matrix(node, o->factors);
     s->trf.child = o->child;
+    s->trf.is_static = !o->factors_node;
+    ngli_transform_fold(&s->trf);
     return 0;
 }
 
@@ -77,7 +79,7 @@ static int scale_update(struct ngl_node *node, double t)
         struct variable_info *factors = o->factors_node->priv_data;
         update_trf_matrix(node, factors->data);
     }
-    return ngli_node_update(o->child, t);
+    return ngli_transform_update_child(node, t);
 }
 
 #define OFFSET(x) offsetof(struct scale_opts, x)
@@ -103,6 +105,7 @@ const struct node_class ngli_scale_class = {
     .name      = "Scale",
     .init      = scale_init,
     .update    = scale_update,
+    .invalidate = ngli_transform_invalidate,
     .draw      = ngli_transform_draw,
     .opts_size = sizeof(struct scale_opts),
     .priv_size = sizeof(struct scale_priv),
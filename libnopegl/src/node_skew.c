@@ -70,6 +70,8 @@ static int skew_init(struct ngl_node *node)
     if (!o->angles_node)
         update_trf_matrix(node, o->angles);
     s->trf.child = o->child;
+    s->trf.is_static = !o->angles_node;
+    ngli_transform_fold(&s->trf);
     return 0;
 }
 
@@ -90,7 +92,7 @@ static int skew_update(struct ngl_node *node, double t)
         struct variable_info *angles = o->angles_node->priv_data;
         update_trf_matrix(node, angles->data);
     }
-    return ngli_node_update(o->child, t);
+    return ngli_transform_update_child(node, t);
 }
 
 #define OFFSET(x) offsetof(struct skew_opts, x)
@@ -117,6 +119,7 @@ const struct node_class ngli_skew_class = {
     .name      = "Skew",
     .init      = skew_init,
     .update    = skew_update,
+    .invalidate = ngli_transform_invalidate,
     .draw      = ngli_transform_draw,
     .opts_size = sizeof(struct skew_opts),
     .priv_size = sizeof(struct skew_priv),
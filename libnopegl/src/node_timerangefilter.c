@@ -100,6 +100,13 @@ static int timerangefilter_visit(struct ngl_node *node, int is_active, double t)
             s->updated = 0;
     }
 
+    /* With lazy init, the child is attached when it enters the prefetch window */
+    if (is_active) {
+        int ret = ngli_node_attach_deferred(node);
+        if (ret < 0)
+            return ret;
+    }
+
     return ngli_node_visit(child, is_active, t);
 }
 
@@ -148,5 +155,6 @@ const struct node_class ngli_timerangefilter_class = {
     .opts_size = sizeof(struct timerangefilter_opts),
     .priv_size = sizeof(struct timerangefilter_priv),
     .params    = timerangefilter_params,
+    .flags     = NGLI_NODE_FLAG_DEFER_CHILDREN,
     .file      = __FILE__,
 };
@@ -64,6 +64,8 @@ static int transform_init(struct ngl_node *node)
     const struct transform_opts *o = node->opts;
     memcpy(s->trf.matrix, o->matrix, sizeof(o->matrix));
     s->trf.child = o->child;
+    s->trf.is_static = !o->matrix_node;
+    ngli_transform_fold(&s->trf);
     return 0;
 }
 
@@ -72,16 +74,15 @@ static int transform_update(struct ngl_node *node, double t)
     struct transform_priv *s = node->priv_data;
     struct transform_opts *o = node->opts;
 
-    int ret = ngli_node_update_children(node, t);
-    if (ret < 0)
-        return ret;
-
     if (o->matrix_node) {
+        int ret = ngli_node_update(o->matrix_node, t);
+        if (ret < 0)
+            return ret;
         float *data = ngli_node_get_data_ptr(o->matrix_node, o->matrix);
         memcpy(s->trf.matrix, data, sizeof(s->trf.matrix));
     }
 
-    return 0;
+    return ngli_transform_update_child(node, t);
 }
 
 const struct node_class ngli_transform_class = {
@@ -90,6 +91,7 @@ const struct node_class ngli_transform_class = {
     .name      = "Transform",
     .init      = transform_init,
     .update    = transform_update,
+    .invalidate = ngli_transform_invalidate,
     .draw      = ngli_transform_draw,
     .opts_size = sizeof(struct transform_opts),
     .priv_size = sizeof(struct transform_priv),
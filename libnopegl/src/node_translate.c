@@ -57,6 +57,8 @@ static int translate_init(struct ngl_node *node)
     if (!o->vector_node)
         update_trf_matrix(node, o->vector);
     s->trf.child = o->child;
+    s->trf.is_static = !o->vector_node;
+    ngli_transform_fold(&s->trf);
     return 0;
 }
 
@@ -70,7 +72,7 @@ static int translate_update(struct ngl_node *node, double t)
         struct variable_info *vector = o->vector_node->priv_data;
         update_trf_matrix(node, vector->data);
     }
-    return ngli_node_update(o->child, t);
+    return ngli_transform_update_child(node, t);
 }
 
 #define OFFSET(x) offsetof(struct translate_opts, x)
@@ -93,6 +95,7 @@ const struct node_class ngli_translate_class = {
     .name      = "Translate",
     .init      = translate_init,
     .update    = translate_update,
+    .invalidate = ngli_transform_invalidate,
     .draw      = ngli_transform_draw,
     .opts_size = sizeof(struct translate_opts),
     .priv_size = sizeof(struct translate_priv),
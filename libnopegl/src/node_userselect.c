@@ -21,6 +21,7 @@
 
 #include <stddef.h>
 
+#include "gpu_ctx.h"
 #include "internal.h"
 #include "log.h"
 #include "params.h"
@@ -29,6 +30,12 @@ struct userselect_opts {
     struct ngl_node **branches;
     size_t nb_branches;
     struct livectl live;
+    int keep_warm;
+};
+
+struct userselect_priv {
+    int cold;
+    int32_t cold_branch_id;
 };
 
 static int branch_update_func(struct ngl_node *node)
@@ -61,6 +68,10 @@ static const struct node_param userselect_params[] = {
                  .desc=NGLI_DOCSTRING("minimum value allowed during live change (only honored when live_id is set)")},
     {"live_max", NGLI_PARAM_TYPE_I32, OFFSET(live.max.i), {.i32=10},
                  .desc=NGLI_DOCSTRING("maximum value allowed during live change (only_honored when live_id is set)")},
+    {"keep_warm", NGLI_PARAM_TYPE_BOOL, OFFSET(keep_warm), {.i32=0},
+                  .desc=NGLI_DOCSTRING("keep the resources of the branches not taken prefetched so that switching "
+                                       "branch does not stall; with a context GPU memory budget, the branches are "
+                                       "only kept warm while the context memory usage fits in the budget")},
     {NULL}
 };
 
@@ -94,12 +105,26 @@ static int userselect_prepare(struct ngl_node *node)
 
 static int userselect_visit(struct ngl_node *node, int is_active, double t)
 {
+    struct ngl_ctx *ctx = node->ctx;
+    struct userselect_priv *s = node->priv_data;
     const struct userselect_opts *o = node->opts;
 
     const int branch_id = o->live.val.i[0];
+
+    /* See userswitch_visit(); the branches get warm again on a branch switch */
+    if (s->cold && s->cold_branch_id != branch_id)
+        s->cold = 0;
+    int warm = is_active && o->keep_warm && !s->cold;
+    const uint64_t budget = ctx->config.gpu_memory_budget;
+    if (warm && budget && ctx->gpu_ctx->memory_usage > budget) {
+        s->cold = 1;
+        s->cold_branch_id = branch_id;
+        warm = 0;
+    }
+
     for (size_t i = 0; i < o->nb_branches; i++) {
         struct ngl_node *branch = o->branches[i];
-        int ret = ngli_node_visit(branch, is_active && i == branch_id, t);
+        int ret = ngli_node_visit(branch, (is_active && i == branch_id) || warm, t);
         if (ret < 0)
             return ret;
     }
@@ -125,12 +150,18 @@ static void userselect_draw(struct ngl_node *node)
     if (branch_id < 0 || branch_id >= o->nb_branches)
         return;
     struct rnode *rnode_pos = ctx->rnode_pos;
-    struct rnode *rnodes = ngli_darray_data(&rnode_pos->children);
-    ctx->rnode_pos = &rnodes[branch_id];
+    struct rnode **rnodes = ngli_darray_data(&rnode_pos->children);
+    ctx->rnode_pos = rnodes[branch_id];
     ngli_node_draw(o->branches[branch_id]);
     ctx->rnode_pos = rnode_pos;
 }
 
+static void userselect_release(struct ngl_node *node)
+{
+    struct userselect_priv *s = node->priv_data;
+    s->cold = 0;
+}
+
 const struct node_class ngli_userselect_class = {
     .id             = NGL_NODE_USERSELECT,
     .name           = "UserSelect",
@@ -138,7 +169,9 @@ const struct node_class ngli_userselect_class = {
     .visit          = userselect_visit,
     .update         = userselect_update,
     .draw           = userselect_draw,
+    .release        = userselect_release,
     .opts_size      = sizeof(struct userselect_opts),
+    .priv_size      = sizeof(struct userselect_priv),
     .params         = userselect_params,
     .flags          = NGLI_NODE_FLAG_LIVECTL,
     .livectl_offset = OFFSET(live),
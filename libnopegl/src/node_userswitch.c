@@ -21,12 +21,18 @@
 
 #include <stddef.h>
 
+#include "gpu_ctx.h"
 #include "internal.h"
 #include "params.h"
 
 struct userswitch_opts {
     struct ngl_node *child;
     struct livectl live;
+    int keep_warm;
+};
+
+struct userswitch_priv {
+    int cold;
 };
 
 #define OFFSET(x) offsetof(struct userswitch_opts, x)
@@ -39,14 +45,37 @@ static const struct node_param userswitch_params[] = {
                .desc=NGLI_DOCSTRING("set if the scene should be rendered")},
     {"live_id",  NGLI_PARAM_TYPE_STR, OFFSET(live.id),
                  .desc=NGLI_DOCSTRING("live control identifier")},
+    {"keep_warm", NGLI_PARAM_TYPE_BOOL, OFFSET(keep_warm), {.i32=0},
+                  .desc=NGLI_DOCSTRING("keep the child resources prefetched while the scene is disabled so that "
+                                       "enabling it does not stall; with a context GPU memory budget, the child is "
+                                       "only kept warm while the context memory usage fits in the budget")},
     {NULL}
 };
 
 static int userswitch_visit(struct ngl_node *node, int is_active, double t)
 {
+    struct ngl_ctx *ctx = node->ctx;
+    struct userswitch_priv *s = node->priv_data;
     const struct userswitch_opts *o = node->opts;
     const int enabled = o->live.val.i[0];
-    return ngli_node_visit(o->child, is_active && enabled, t);
+
+    /*
+     * A warm child is visited as active while the context fits in its memory
+     * budget (if any). Past the budget, the child is visited as inactive so
+     * its nodes go through the resident nodes of the context and get evicted
+     * least recently used first. It then stays cold until it is enabled again
+     * so it is not prefetched back on the next frame.
+     */
+    if (is_active && enabled)
+        s->cold = 0;
+    int warm = is_active && o->keep_warm && !enabled && !s->cold;
+    const uint64_t budget = ctx->config.gpu_memory_budget;
+    if (warm && budget && ctx->gpu_ctx->memory_usage > budget) {
+        s->cold = 1;
+        warm = 0;
+    }
+
+    return ngli_node_visit(o->child, (is_active && enabled) || warm, t);
 }
 
 static int userswitch_update(struct ngl_node *node, double t)
@@ -64,13 +93,21 @@ static void userswitch_draw(struct ngl_node *node)
         ngli_node_draw(o->child);
 }
 
+static void userswitch_release(struct ngl_node *node)
+{
+    struct userswitch_priv *s = node->priv_data;
+    s->cold = 0;
+}
+
 const struct node_class ngli_userswitch_class = {
     .id             = NGL_NODE_USERSWITCH,
     .name           = "UserSwitch",
     .visit          = userswitch_visit,
     .update         = userswitch_update,
     .draw           = userswitch_draw,
+    .release        = userswitch_release,
     .opts_size      = sizeof(struct userswitch_opts),
+    .priv_size      = sizeof(struct userswitch_priv),
     .params         = userswitch_params,
     .flags          = NGLI_NODE_FLAG_LIVECTL,
     .livectl_offset = OFFSET(live),
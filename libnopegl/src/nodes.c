@@ -19,12 +19,14 @@
  * under the License.
  */
 
+#include <inttypes.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include "gpu_ctx.h"
 #include "hmap.h"
 #include "log.h"
 #include "nopegl.h"
@@ -160,16 +162,73 @@ struct ngl_node *ngl_node_create(uint32_t type)
     return node;
 }
 
+/*
+ * GPU memory accounting: the memory allocated or freed by the context while
+ * running a node callback is attributed to that node, minus what the nested
+ * calls on its children (typically updates) already accounted for. The
+ * programs are cached by the context for its whole lifetime, so they are
+ * never given back by a release and are excluded from the ready memory.
+ */
+struct memory_scope {
+    uint64_t start;
+    uint64_t start_program;
+    int64_t parent_nested;
+    int64_t parent_nested_program;
+};
+
+static void memory_scope_enter(struct ngl_ctx *ctx, struct memory_scope *scope)
+{
+    scope->start = ctx->gpu_ctx->memory_usage;
+    scope->start_program = ctx->gpu_ctx->program_memory;
+    scope->parent_nested = ctx->memory_nested;
+    scope->parent_nested_program = ctx->memory_nested_program;
+    ctx->memory_nested = 0;
+    ctx->memory_nested_program = 0;
+}
+
+static void memory_scope_leave(struct ngl_ctx *ctx, struct memory_scope *scope, struct ngl_node *node)
+{
+    const int64_t delta = (int64_t)(ctx->gpu_ctx->memory_usage - scope->start);
+    const int64_t delta_program = (int64_t)(ctx->gpu_ctx->program_memory - scope->start_program);
+    const int64_t node_delta = delta - ctx->memory_nested;
+    const int64_t node_delta_program = delta_program - ctx->memory_nested_program;
+    node->gpu_memory = NGLI_MAX(node->gpu_memory + node_delta, 0);
+    /* Only what is acquired past init is given back by a release */
+    if (node->state != STATE_UNINITIALIZED)
+        node->ready_memory = NGLI_MAX(node->ready_memory + node_delta - node_delta_program, 0);
+    ctx->memory_nested = scope->parent_nested + delta;
+    ctx->memory_nested_program = scope->parent_nested_program + delta_program;
+}
+
+static void remove_resident_node(struct ngl_node *node)
+{
+    struct darray *nodes_array = &node->ctx->resident_nodes;
+    struct ngl_node **nodes = ngli_darray_data(nodes_array);
+    for (size_t i = 0; i < ngli_darray_count(nodes_array); i++) {
+        if (nodes[i] == node) {
+            ngli_darray_remove(nodes_array, i);
+            break;
+        }
+    }
+    node->is_resident = 0;
+}
+
 static void node_release(struct ngl_node *node)
 {
     if (node->state != STATE_READY)
         return;
 
     ngli_assert(node->ctx);
+    if (node->is_resident)
+        remove_resident_node(node);
     if (node->cls->release) {
         TRACE("RELEASE %s @ %p", node->label, node);
+        struct memory_scope scope;
+        memory_scope_enter(node->ctx, &scope);
         node->cls->release(node);
+        memory_scope_leave(node->ctx, &scope, node);
     }
+    node->ready_memory = 0;
     node->state = STATE_INITIALIZED;
     node->last_update_time = -1.;
 }
@@ -187,8 +246,11 @@ static void node_uninit(struct ngl_node *node)
         node->cls->uninit(node);
     }
     memset(node->priv_data, 0, node->cls->priv_size);
+    node->gpu_memory = 0;
+    node->ready_memory = 0;
     node->state = STATE_UNINITIALIZED;
     node->visit_time = -1.;
+    node->is_active = 0;
 }
 
 static int node_init(struct ngl_node *node)
@@ -199,7 +261,10 @@ static int node_init(struct ngl_node *node)
     ngli_assert(node->ctx);
     if (node->cls->init) {
         LOG(VERBOSE, "INIT %s @ %p", node->label, node);
+        struct memory_scope scope;
+        memory_scope_enter(node->ctx, &scope);
         int ret = node->cls->init(node);
+        memory_scope_leave(node->ctx, &scope, node);
         if (ret < 0) {
             LOG(ERROR, "initializing node %s failed: %s", node->label, NGLI_RET_STR(ret));
             node->state = STATE_INIT_FAILED;
@@ -216,16 +281,30 @@ static int node_init(struct ngl_node *node)
     return 0;
 }
 
+/* Render path snapshot in which the deferred children are going to be prepared */
+struct deferred_rnode {
+    struct rnode *rnode;
+    size_t nb_children; /* rnode children count before the attach attempt */
+    struct graphics_state graphics_state;
+    struct rendertarget_layout rendertarget_layout;
+};
+
 static int node_set_ctx(struct ngl_node *node, struct ngl_ctx *ctx)
 {
     int ret;
 
-    struct ngl_node **children = ngli_darray_data(&node->children);
-    for (size_t i = 0; i < ngli_darray_count(&node->children); i++) {
-        struct ngl_node *child = children[i];
-        ret = node_set_ctx(child, ctx);
-        if (ret < 0)
-            return ret;
+    const int defer = ctx->config.lazy_init &&
+                      (node->cls->flags & NGLI_NODE_FLAG_DEFER_CHILDREN) &&
+                      (!node->ctx_refcount || node->deferred);
+
+    if (!defer) {
+        struct ngl_node **children = ngli_darray_data(&node->children);
+        for (size_t i = 0; i < ngli_darray_count(&node->children); i++) {
+            struct ngl_node *child = children[i];
+            ret = node_set_ctx(child, ctx);
+            if (ret < 0)
+                return ret;
+        }
     }
 
     node->ctx = ctx;
@@ -234,6 +313,10 @@ static int node_set_ctx(struct ngl_node *node, struct ngl_ctx *ctx)
         node->ctx = NULL;
         return ret;
     }
+    if (defer && !node->deferred) {
+        node->deferred = 1;
+        ngli_darray_init(&node->deferred_rnodes, sizeof(struct deferred_rnode), 0);
+    }
     node->ctx_refcount++;
 
     return 0;
@@ -241,16 +324,24 @@ static int node_set_ctx(struct ngl_node *node, struct ngl_ctx *ctx)
 
 static void node_reset_ctx(struct ngl_node *node, struct ngl_ctx *ctx)
 {
+    const int deferred = node->deferred;
+
     if (node->state > STATE_UNINITIALIZED) {
         if (node->ctx != ctx)
             return;
         if (node->ctx_refcount-- == 1) {
             node_uninit(node);
             node->ctx = NULL;
+            node->deferred = 0;
+            ngli_darray_reset(&node->deferred_rnodes);
         }
     }
     ngli_assert(node->ctx_refcount >= 0);
 
+    /* The children were never attached */
+    if (deferred)
+        return;
+
     struct ngl_node **children = ngli_darray_data(&node->children);
     for (size_t i = 0; i < ngli_darray_count(&node->children); i++) {
         struct ngl_node *child = children[i];
@@ -289,6 +380,18 @@ int ngli_node_prepare_children(struct ngl_node *node)
 
 int ngli_node_prepare(struct ngl_node *node)
 {
+    if (node->deferred) {
+        const struct rnode *rnode = node->ctx->rnode_pos;
+        const struct deferred_rnode deferred_rnode = {
+            .rnode               = node->ctx->rnode_pos,
+            .graphics_state      = rnode->graphics_state,
+            .rendertarget_layout = rnode->rendertarget_layout,
+        };
+        if (!ngli_darray_push(&node->deferred_rnodes, &deferred_rnode))
+            return NGL_ERROR_MEMORY;
+        return 0;
+    }
+
     if (node->cls->prepare) {
         TRACE("PREPARE %s @ %p", node->label, node);
         int ret = node->cls->prepare(node);
@@ -301,6 +404,81 @@ int ngli_node_prepare(struct ngl_node *node)
     return ngli_node_prepare_children(node);
 }
 
+/*
+ * Attach the children of a node whose attachment has been deferred (see
+ * NGLI_NODE_FLAG_DEFER_CHILDREN): they are initialized once for every path
+ * leading to the node, just like node_set_ctx() would have done, and prepared
+ * in the render paths recorded when the node itself was prepared.
+ */
+int ngli_node_attach_deferred(struct ngl_node *node)
+{
+    if (!node->deferred)
+        return 0;
+
+    struct ngl_ctx *ctx = node->ctx;
+    struct rnode *rnode_pos = ctx->rnode_pos;
+    LOG(DEBUG, "attach deferred children of %s", node->label);
+
+    node->deferred = 0;
+
+    int ret = 0;
+    struct ngl_node **children = ngli_darray_data(&node->children);
+    const size_t nb_children = ngli_darray_count(&node->children);
+    const size_t nb_attachments = (size_t)node->ctx_refcount * nb_children;
+    size_t nb_attached = 0;
+    struct deferred_rnode *deferred_rnodes = ngli_darray_data(&node->deferred_rnodes);
+    size_t nb_prepared = 0;
+    while (nb_attached < nb_attachments) {
+        /* A failed attachment is partially done and needs a reset as well */
+        ret = node_set_ctx(children[nb_attached++ % nb_children], ctx);
+        if (ret < 0)
+            goto fail;
+    }
+
+    /*
+     * The recorded rnodes may be shared with siblings which have been
+     * prepared (and possibly attached rnode children) since: the state they
+     * currently hold is only borrowed during the preparation of the node, and
+     * the rnode children added by a failed attempt are the only ones removed.
+     */
+    while (nb_prepared < ngli_darray_count(&node->deferred_rnodes)) {
+        struct deferred_rnode *deferred_rnode = &deferred_rnodes[nb_prepared++];
+        struct rnode *rnode = deferred_rnode->rnode;
+        const struct graphics_state graphics_state = rnode->graphics_state;
+        const struct rendertarget_layout rendertarget_layout = rnode->rendertarget_layout;
+        deferred_rnode->nb_children = ngli_darray_count(&rnode->children);
+        rnode->graphics_state = deferred_rnode->graphics_state;
+        rnode->rendertarget_layout = deferred_rnode->rendertarget_layout;
+        ctx->rnode_pos = rnode;
+        ret = ngli_node_prepare(node);
+        rnode->graphics_state = graphics_state;
+        rnode->rendertarget_layout = rendertarget_layout;
+        if (ret < 0)
+            goto fail;
+    }
+    ctx->rnode_pos = rnode_pos;
+
+    ngli_darray_reset(&node->deferred_rnodes);
+    return 0;
+
+fail:
+    /* Roll back to the deferred state so the next activation tries again */
+    ctx->rnode_pos = rnode_pos;
+    while (nb_prepared) {
+        /* Reverse order: the same rnode may have been recorded several times */
+        const struct deferred_rnode *deferred_rnode = &deferred_rnodes[--nb_prepared];
+        struct darray *rnode_children = &deferred_rnode->rnode->children;
+        const size_t nb_rnodes = ngli_darray_count(rnode_children);
+        if (nb_rnodes > deferred_rnode->nb_children)
+            ngli_darray_remove_range(rnode_children, deferred_rnode->nb_children,
+                                     nb_rnodes - deferred_rnode->nb_children);
+    }
+    for (size_t i = 0; i < nb_attached; i++)
+        node_reset_ctx(children[i % nb_children], ctx);
+    node->deferred = 1;
+    return ret;
+}
+
 int ngli_node_visit(struct ngl_node *node, int is_active, double t)
 {
     /*
@@ -373,14 +551,21 @@ static int node_prefetch(struct ngl_node *node)
 
     if (node->cls->prefetch) {
         TRACE("PREFETCH %s @ %p", node->label, node);
+        node->ctx->nb_prefetches++;
+        struct memory_scope scope;
+        memory_scope_enter(node->ctx, &scope);
         int ret = node->cls->prefetch(node);
+        memory_scope_leave(node->ctx, &scope, node);
         if (ret < 0) {
             LOG(ERROR, "prefetching node %s failed: %s", node->label, NGLI_RET_STR(ret));
             node->visit_time = -1.;
             if (node->cls->release) {
                 LOG(VERBOSE, "RELEASE %s @ %p", node->label, node);
+                memory_scope_enter(node->ctx, &scope);
                 node->cls->release(node);
+                memory_scope_leave(node->ctx, &scope, node);
             }
+            node->ready_memory = 0;
             return ret;
         }
     }
@@ -399,34 +584,85 @@ int ngli_node_honor_release_prefetch(struct ngl_node *scene, double t)
         return ret;
 
     struct ngl_node **nodes = ngli_darray_data(nodes_array);
+    struct ngl_ctx *ctx = scene->ctx;
+    const uint64_t budget = ctx->config.gpu_memory_budget;
+    struct darray *resident_array = &ctx->resident_nodes;
 
-    /* Release nodes starting from the parents (root) down to the children (leaves) */
+    /*
+     * Release nodes starting from the parents (root) down to the children
+     * (leaves). With a memory budget, the nodes holding GPU memory are instead
+     * kept resident, and queued in the same order for a later eviction.
+     */
     for (size_t i = 0; i < ngli_darray_count(nodes_array); i++) {
         struct ngl_node *node = nodes[ngli_darray_count(nodes_array) - i - 1];
-        if (!node->is_active)
-            node_release(node);
+        if (node->is_active || node->is_resident)
+            continue;
+        if (budget && node->state == STATE_READY && node->ready_memory > 0) {
+            if (!ngli_darray_push(resident_array, &node))
+                return NGL_ERROR_MEMORY;
+            node->is_resident = 1;
+            continue;
+        }
+        node_release(node);
     }
 
     /* Prefetch nodes starting from the children (leaves) up to the parents (root) */
     for (size_t i = 0; i < ngli_darray_count(nodes_array); i++) {
         struct ngl_node *node = nodes[i];
         if (node->is_active) {
+            if (node->is_resident)
+                remove_resident_node(node);
             int ret = node_prefetch(node);
             if (ret < 0)
                 return ret;
         }
     }
 
+    /* Evict the least recently used resident nodes until we fit the budget */
+    while (ngli_darray_count(resident_array) && ctx->gpu_ctx->memory_usage > budget) {
+        struct ngl_node **resident_nodes = ngli_darray_data(resident_array);
+        struct ngl_node *node = resident_nodes[0];
+        LOG(DEBUG, "evict %s holding %" PRId64 " bytes of GPU memory", node->label, node->ready_memory);
+        node_release(node);
+    }
+
     return 0;
 }
 
+uint64_t ngli_node_get_resident_memory(const struct ngl_ctx *ctx)
+{
+    uint64_t size = 0;
+    const struct darray *resident_array = &ctx->resident_nodes;
+    struct ngl_node **nodes = ngli_darray_data(resident_array);
+    for (size_t i = 0; i < ngli_darray_count(resident_array); i++)
+        size += (uint64_t)nodes[i]->ready_memory;
+    return size;
+}
+
+void ngli_node_get_stats(const struct ngl_scene *scene, struct ngl_stats *stats)
+{
+    struct ngl_node **nodes = ngli_darray_data(&scene->nodes);
+    const size_t nb_nodes = ngli_darray_count(&scene->nodes);
+    stats->nb_nodes = nb_nodes;
+    for (size_t i = 0; i < nb_nodes; i++) {
+        const struct ngl_node *node = nodes[i];
+        stats->nb_nodes_initialized += node->state >= STATE_INITIALIZED;
+        stats->nb_nodes_ready       += node->state == STATE_READY;
+        stats->nb_nodes_active      += node->is_active;
+        stats->nb_nodes_resident    += node->is_resident;
+    }
+}
+
 int ngli_node_update(struct ngl_node *node, double t)
 {
     ngli_assert(node->state == STATE_READY);
     if (node->cls->update) {
         if (node->last_update_time != t) {
             TRACE("UPDATE %s @ %p with t=%g", node->label, node, t);
+            struct memory_scope scope;
+            memory_scope_enter(node->ctx, &scope);
             int ret = node->cls->update(node, t);
+            memory_scope_leave(node->ctx, &scope, node);
             if (ret < 0) {
                 LOG(ERROR, "updating node %s failed: %s", node->label, NGLI_RET_STR(ret));
                 return ret;
@@ -471,6 +707,14 @@ void ngli_node_draw(struct ngl_node *node)
     }
 }
 
+void ngli_node_set_draw_error(struct ngl_node *node, int ret)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    LOG(ERROR, "drawing node %s failed: %s", node->label, NGLI_RET_STR(ret));
+    if (!ctx->draw_ret)
+        ctx->draw_ret = ret;
+}
+
 const struct node_param *ngli_node_param_find(const struct ngl_node *node, const char *key,
                                               uint8_t **base_ptrp)
 {
@@ -528,8 +772,13 @@ int ngl_node_param_add_f64s(struct ngl_node *node, const char *key,
     return param_add(node, key, nb_f64s, f64s);
 }
 
-static int node_invalidate_branch(struct ngl_node *node)
+static int node_invalidate_branch(struct ngl_node *node, uint64_t invalidation_id)
 {
+    /* Diamond shaped graphs and batched changes reach the same ancestors */
+    if (node->invalidation_id == invalidation_id)
+        return 0;
+    node->invalidation_id = invalidation_id;
+
     node->last_update_time = -1;
     if (node->cls->invalidate) {
         int ret = node->cls->invalidate(node);
@@ -538,7 +787,160 @@ static int node_invalidate_branch(struct ngl_node *node)
     }
     struct ngl_node **parents = ngli_darray_data(&node->parents);
     for (size_t i = 0; i < ngli_darray_count(&node->parents); i++) {
-        int ret = node_invalidate_branch(parents[i]);
+        int ret = node_invalidate_branch(parents[i], invalidation_id);
+        if (ret < 0)
+            return ret;
+    }
+    return 0;
+}
+
+static int node_apply_change(struct ngl_node *node, const struct node_param *par, uint64_t invalidation_id)
+{
+    if (par->update_func) {
+        int ret = par->update_func(node);
+        if (ret < 0)
+            return ret;
+    }
+
+    if (par->scope == NGLI_PARAM_SCOPE_UNIFORM)
+        return 0;
+
+    return node_invalidate_branch(node, invalidation_id);
+}
+
+static size_t get_param_size(const struct node_param *par)
+{
+    size_t size = ngli_params_specs[par->type].size;
+    if (par->flags & NGLI_PARAM_FLAG_ALLOW_NODE)
+        size += sizeof(struct ngl_node *);
+    return size;
+}
+
+/* Pointer to the memory owned by a string or data parameter value, if any */
+static void **get_param_alloc(const struct node_param *par, uint8_t *value)
+{
+    if (par->type != NGLI_PARAM_TYPE_STR && par->type != NGLI_PARAM_TYPE_DATA)
+        return NULL;
+    if (par->flags & NGLI_PARAM_FLAG_ALLOW_NODE)
+        value += sizeof(struct ngl_node *);
+    return (void **)value;
+}
+
+void ngli_node_param_change_freep(struct param_change **changep)
+{
+    struct param_change *change = *changep;
+    if (!change)
+        return;
+    if (change->value) {
+        void **alloc = get_param_alloc(change->par, change->value);
+        if (alloc)
+            ngli_freep(alloc);
+        ngli_freep(&change->value);
+    }
+    ngl_node_unrefp(&change->node);
+    ngli_freep(changep);
+}
+
+/*
+ * Start from a copy of the current value so that a change rejected by the
+ * setter leaves the parameter untouched at commit.
+ */
+static int copy_param_value(const struct node_param *par, uint8_t *dst, const uint8_t *src, size_t size)
+{
+    memcpy(dst, src, size);
+
+    void **alloc = get_param_alloc(par, dst);
+    if (!alloc || !*alloc)
+        return 0;
+
+    if (par->type == NGLI_PARAM_TYPE_STR) {
+        *alloc = ngli_strdup(*alloc);
+    } else {
+        size_t data_size;
+        memcpy(&data_size, (uint8_t *)alloc + sizeof(void *), sizeof(data_size));
+        *alloc = ngli_memdup(*alloc, data_size);
+    }
+    return *alloc ? 0 : NGL_ERROR_MEMORY;
+}
+
+/*
+ * Within a batch of changes, redirect the parameter write to a staged copy
+ * of its value which is only copied back into the node at commit
+ */
+static int stage_change(struct ngl_scene *scene, struct ngl_node *node,
+                        const struct node_param *par, uint8_t **dstp)
+{
+    uint8_t *dst = *dstp;
+    const uint64_t key = (uint64_t)(uintptr_t)dst;
+    struct param_change *change = ngli_hmap_get_u64(scene->changes_map, key);
+    if (change) {
+        *dstp = change->value;
+        return 0;
+    }
+
+    change = ngli_calloc(1, sizeof(*change));
+    if (!change)
+        return NGL_ERROR_MEMORY;
+    change->node = ngl_node_ref(node);
+    change->par = par;
+    change->dst = dst;
+    change->size = get_param_size(par);
+
+    int ret;
+    change->value = ngli_calloc(1, change->size);
+    if (!change->value) {
+        ret = NGL_ERROR_MEMORY;
+        goto fail;
+    }
+
+    ret = copy_param_value(par, change->value, dst, change->size);
+    if (ret < 0)
+        goto fail;
+
+    if (!ngli_darray_push(&scene->changes, &change)) {
+        ret = NGL_ERROR_MEMORY;
+        goto fail;
+    }
+
+    ret = ngli_hmap_set_u64(scene->changes_map, key, change);
+    if (ret < 0) {
+        ngli_darray_pop(&scene->changes);
+        goto fail;
+    }
+
+    *dstp = change->value;
+    return 0;
+
+fail:
+    ngli_node_param_change_freep(&change);
+    return ret;
+}
+
+int ngli_node_commit_changes(struct ngl_scene *scene, struct param_change **changes, size_t nb_changes)
+{
+    if (!nb_changes)
+        return 0;
+
+    /* All the new values are visible before any of the updates is run */
+    for (size_t i = 0; i < nb_changes; i++) {
+        struct param_change *change = changes[i];
+        void **alloc = get_param_alloc(change->par, change->dst);
+        if (alloc)
+            ngli_freep(alloc);
+        memcpy(change->dst, change->value, change->size);
+        ngli_freep(&change->value);
+
+        if (change->par->flags & NGLI_PARAM_FLAG_FILEPATH)
+            ngli_scene_update_filepath_ref(change->node, change->par);
+    }
+
+    /* All the changes share the same invalidation pass */
+    const uint64_t invalidation_id = ++scene->invalidation_id;
+    for (size_t i = 0; i < nb_changes; i++) {
+        const struct param_change *change = changes[i];
+        if (!change->node->ctx)
+            continue;
+        int ret = node_apply_change(change->node, change->par, invalidation_id);
         if (ret < 0)
             return ret;
     }
@@ -575,13 +977,27 @@ static int node_param_update(struct ngl_node *node, const struct node_param *par
     if (!node->ctx)
         return 0;
 
-    if (par->update_func) {
-        int ret = par->update_func(node);
-        if (ret < 0)
-            return ret;
-    }
+    return node_apply_change(node, par, ++node->scene->invalidation_id);
+}
 
-    return node_invalidate_branch(node);
+static int is_change_staged(const struct ngl_node *node)
+{
+    return node->ctx && node->scene->changes_started;
+}
+
+static int node_param_get_dst(struct ngl_node *node, const struct node_param *par, uint8_t **dstp)
+{
+    if (!is_change_staged(node))
+        return 0;
+    return stage_change(node->scene, node, par, dstp);
+}
+
+static int node_param_commit(struct ngl_node *node, const struct node_param *par)
+{
+    /* Staged changes are applied by ngl_scene_commit_changes() */
+    if (is_change_staged(node))
+        return 0;
+    return node_param_update(node, par);
 }
 
 #define FORWARD_TO_PARAM(type, ...)                                     \
@@ -593,8 +1009,9 @@ static int node_param_update(struct ngl_node *node, const struct node_param *par
         return NGL_ERROR_NOT_FOUND;                                     \
     uint8_t *dst = base_ptr + par->offset;                              \
     if ((ret = node_param_is_value_allowed(node, key, dst, par)) < 0 || \
+        (ret = node_param_get_dst(node, par, &dst)) < 0 ||              \
         (ret = ngli_params_set_##type(dst, par, __VA_ARGS__)) < 0 ||    \
-        (ret = node_param_update(node, par)) < 0)                       \
+        (ret = node_param_commit(node, par)) < 0)                       \
         return ret;                                                     \
     return 0
 
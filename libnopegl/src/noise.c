@@ -21,6 +21,7 @@
  */
 
 #include <math.h>
+#include <string.h>
 
 #include "math_utils.h"
 #include "noise.h"
@@ -116,3 +117,100 @@ float ngli_noise_get(const struct noise *s, float t)
     }
     return sum;
 }
+
+/*
+ * The time, lattice point and interpolation factor are shared by all the
+ * components, only the hashed slopes differ between lanes. The curve is
+ * inlined in each kernel instead of being called for every octave.
+ */
+#define LANES NGLI_NOISEVEC_MAX_COMPONENTS
+
+#define DEFINE_NOISEVEC_FUNCS(curve)                                                    \
+static inline void noisevec_##curve##_eval(const struct noisevec *s, float t, float *sum) \
+{                                                                                       \
+    const struct noise_params *p = &s->params;                                          \
+    float amp = p->amplitude;                                                           \
+    for (size_t l = 0; l < LANES; l++)                                                  \
+        sum[l] = 0.f;                                                                   \
+    for (int32_t o = 0; o < p->octaves; o++) {                                          \
+        const float i = floorf(t);                                                      \
+        const float f = t - i;                                                          \
+        const float a = curve_##curve(f);                                               \
+        const uint32_t x = (uint32_t)i;                                                 \
+        for (size_t l = 0; l < LANES; l++) {                                            \
+            const uint32_t xl = x + s->seeds[l];                                        \
+            const float s0 = u32tof32(hash(xl))     * 2.f - 1.f;                        \
+            const float s1 = u32tof32(hash(xl + 1)) * 2.f - 1.f;                        \
+            const float y0 = s0 * f;                                                    \
+            const float y1 = s1 * (f - 1.f);                                            \
+            sum[l] += NGLI_MIX_F32(y0, y1, a) * amp;                                    \
+        }                                                                               \
+        t *= p->lacunarity;                                                             \
+        amp *= p->gain;                                                                 \
+    }                                                                                   \
+}                                                                                       \
+                                                                                        \
+static void noisevec_##curve##_get(const struct noisevec *s, float t, float *dst)      \
+{                                                                                       \
+    float sum[LANES];                                                                   \
+    noisevec_##curve##_eval(s, t, sum);                                                 \
+    memcpy(dst, sum, s->nb_components * sizeof(*dst));                                  \
+}                                                                                       \
+                                                                                        \
+static void noisevec_##curve##_get_batch(const struct noisevec *s, const float *t,     \
+                                         size_t nb_samples, float *dst)                 \
+{                                                                                       \
+    const size_t n = s->nb_components;                                                  \
+    for (size_t i = 0; i < nb_samples; i++) {                                           \
+        float sum[LANES];                                                               \
+        noisevec_##curve##_eval(s, t[i], sum);                                          \
+        memcpy(dst + i * n, sum, n * sizeof(*dst));                                     \
+    }                                                                                   \
+}
+
+DEFINE_NOISEVEC_FUNCS(linear)
+DEFINE_NOISEVEC_FUNCS(cubic)
+DEFINE_NOISEVEC_FUNCS(quintic)
+
+static const struct {
+    noisevec_func_type get;
+    noisevec_batch_func_type get_batch;
+} noisevec_funcs_map[NGLI_NOISE_NB] = {
+    [NGLI_NOISE_LINEAR]  = {noisevec_linear_get,  noisevec_linear_get_batch},
+    [NGLI_NOISE_CUBIC]   = {noisevec_cubic_get,   noisevec_cubic_get_batch},
+    [NGLI_NOISE_QUINTIC] = {noisevec_quintic_get, noisevec_quintic_get_batch},
+};
+
+int ngli_noisevec_init(struct noisevec *s, const struct noise_params *params, size_t nb_components)
+{
+    ngli_assert(params->function >= 0 && params->function < NGLI_ARRAY_NB(noisevec_funcs_map));
+    ngli_assert(nb_components > 0 && nb_components <= NGLI_NOISEVEC_MAX_COMPONENTS);
+
+    s->params = *params;
+    s->nb_components = nb_components;
+    s->get_func = noisevec_funcs_map[params->function].get;
+    s->get_batch_func = noisevec_funcs_map[params->function].get_batch;
+
+    /*
+     * The seed offset is defined to create a large gap between every
+     * components; the unused lanes are still evaluated (they are free in
+     * SIMD) with a seed following the same progression.
+     */
+    const uint32_t seed_offset = UINT32_MAX / (uint32_t)nb_components;
+    uint32_t seed = params->seed;
+    for (size_t i = 0; i < LANES; i++) {
+        s->seeds[i] = seed;
+        seed += seed_offset;
+    }
+    return 0;
+}
+
+void ngli_noisevec_get(const struct noisevec *s, float t, float *dst)
+{
+    s->get_func(s, t, dst);
+}
+
+void ngli_noisevec_get_batch(const struct noisevec *s, const float *t, size_t nb_samples, float *dst)
+{
+    s->get_batch_func(s, t, nb_samples, dst);
+}
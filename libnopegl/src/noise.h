@@ -23,6 +23,7 @@
 #ifndef NOISE_H
 #define NOISE_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 enum {
@@ -51,4 +52,34 @@ struct noise {
 int ngli_noise_init(struct noise *s, const struct noise_params *params);
 float ngli_noise_get(const struct noise *s, float t);
 
+/*
+ * Multi-components noise generator: every component is evaluated the same,
+ * except for its seed, so all the components (up to 4) and octaves are
+ * computed together in SIMD-friendly lanes. The seeds are derived from the
+ * seed specified in the parameters, spread to keep the overlap between the
+ * components to the minimum possible.
+ */
+#define NGLI_NOISEVEC_MAX_COMPONENTS 4
+
+struct noisevec;
+
+typedef void (*noisevec_func_type)(const struct noisevec *s, float t, float *dst);
+typedef void (*noisevec_batch_func_type)(const struct noisevec *s, const float *t, size_t nb_samples, float *dst);
+
+struct noisevec {
+    struct noise_params params;
+    size_t nb_components;
+    uint32_t seeds[NGLI_NOISEVEC_MAX_COMPONENTS];
+    noisevec_func_type get_func;
+    noisevec_batch_func_type get_batch_func;
+};
+
+int ngli_noisevec_init(struct noisevec *s, const struct noise_params *params, size_t nb_components);
+
+/* Write the nb_components values at time t into dst */
+void ngli_noisevec_get(const struct noisevec *s, float t, float *dst);
+
+/* Evaluate nb_samples times, dst receives nb_samples * nb_components interleaved values */
+void ngli_noisevec_get_batch(const struct noisevec *s, const float *t, size_t nb_samples, float *dst);
+
 #endif
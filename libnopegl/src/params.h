@@ -143,6 +143,24 @@ struct ngl_node;
  */
 #define NGLI_PARAM_FLAG_FILEPATH (1U<<5)
 
+/*
+ * What a live change of a parameter affects, which determines the work needed
+ * to honor it once its update_func (if any) has been called.
+ */
+enum {
+    /*
+     * Default: the node and all its ancestors are invalidated so that the
+     * branch is updated again, even if the time does not change.
+     */
+    NGLI_PARAM_SCOPE_BRANCH,
+
+    /*
+     * The value is only referenced in-place by the GPU pipelines (uniform
+     * data) and is read at draw time, so nothing needs to be invalidated.
+     */
+    NGLI_PARAM_SCOPE_UNIFORM,
+};
+
 struct node_param {
     const char *key;
     int type; // NGLI_PARAM_TYPE_*
@@ -165,6 +183,7 @@ struct node_param {
     const char *desc;
     const struct param_choices *choices;
     int (*update_func)(struct ngl_node *node);
+    int scope; // any of NGLI_PARAM_SCOPE_*, only meaningful with NGLI_PARAM_FLAG_ALLOW_LIVE_CHANGE
 };
 
 int ngli_params_get_select_val(const struct param_const *consts, const char *s, int *dst);
@@ -57,6 +57,12 @@ struct resource_map {
     size_t buffer_rev;
 };
 
+struct constant_map {
+    const void *data;
+    size_t size;
+    uint8_t value[4 * 4 * sizeof(float)]; // value inlined in the shader
+};
+
 struct texture_map {
     const struct image *image;
     size_t image_rev;
@@ -69,11 +75,41 @@ struct pipeline_desc {
     int32_t projection_matrix_index;
     int32_t normal_matrix_index;
     int32_t resolution_index;
+    struct graphics_state state;
+    struct rendertarget_layout rt_layout;
+    struct darray constants_map;
+    int normal_matrix_cached;
+    float normal_matrix_src[4*4]; // modelview matrix the normal matrix is derived from
+    float normal_matrix[3*3];
     struct darray uniforms_map;
     struct darray blocks_map;
     struct darray textures_map;
 };
 
+/*
+ * With ngl_config.specialize_uniforms, the values of the Uniform* nodes which
+ * are neither animated nor exposed as live controls are inlined in the
+ * shaders. They can still be changed through the parameters API, in which case
+ * the pipeline is crafted again with the new value.
+ */
+static int is_constant_uniform(const struct pass *s, const struct ngl_node *node)
+{
+    const struct ngl_ctx *ctx = s->ctx;
+    if (!ctx->config.specialize_uniforms)
+        return 0;
+
+    if (node->cls->category != NGLI_NODE_CATEGORY_VARIABLE ||
+        !(node->cls->flags & NGLI_NODE_FLAG_LIVECTL))
+        return 0;
+
+    const struct variable_info *variable_info = node->priv_data;
+    if (variable_info->dynamic || variable_info->data_size > sizeof(((struct constant_map *)0)->value))
+        return 0;
+
+    const struct livectl *livectl = (const struct livectl *)((const uint8_t *)node->opts + node->cls->livectl_offset);
+    return !livectl->id;
+}
+
 static int register_uniform(struct pass *s, const char *name, struct ngl_node *uniform, int stage)
 {
     struct pgcraft_uniform crafter_uniform = {.stage = stage};
@@ -88,6 +124,13 @@ static int register_uniform(struct pass *s, const char *name, struct ngl_node *u
         struct variable_info *variable_info = uniform->priv_data;
         crafter_uniform.type  = variable_info->data_type;
         crafter_uniform.data  = variable_info->data;
+
+        if (is_constant_uniform(s, uniform)) {
+            const struct constant_map map = {.data = variable_info->data, .size = variable_info->data_size};
+            if (!ngli_darray_push(&s->constants, &map))
+                return NGL_ERROR_MEMORY;
+            crafter_uniform.constant = 1;
+        }
     } else {
         ngli_assert(0);
     }
@@ -110,10 +153,10 @@ static int register_uniform(struct pass *s, const char *name, struct ngl_node *u
 static int register_builtin_uniforms(struct pass *s)
 {
     struct pgcraft_uniform crafter_uniforms[] = {
-        {.name = "ngl_modelview_matrix",  .type = NGLI_TYPE_MAT4, .stage=NGLI_PROGRAM_SHADER_VERT, .data = NULL},
-        {.name = "ngl_projection_matrix", .type = NGLI_TYPE_MAT4, .stage=NGLI_PROGRAM_SHADER_VERT, .data = NULL},
-        {.name = "ngl_normal_matrix",     .type = NGLI_TYPE_MAT3, .stage=NGLI_PROGRAM_SHADER_VERT, .data = NULL},
-        {.name = "ngl_resolution",        .type = NGLI_TYPE_VEC2, .stage=NGLI_PROGRAM_SHADER_FRAG, .data = NULL},
+        {.name = "ngl_modelview_matrix",  .type = NGLI_TYPE_MAT4, .stage=NGLI_PROGRAM_SHADER_VERT, .data = NULL, .push_constant = 1},
+        {.name = "ngl_projection_matrix", .type = NGLI_TYPE_MAT4, .stage=NGLI_PROGRAM_SHADER_VERT, .data = NULL, .push_constant = 1},
+        {.name = "ngl_normal_matrix",     .type = NGLI_TYPE_MAT3, .stage=NGLI_PROGRAM_SHADER_VERT, .data = NULL, .push_constant = 1},
+        {.name = "ngl_resolution",        .type = NGLI_TYPE_VEC2, .stage=NGLI_PROGRAM_SHADER_FRAG, .data = NULL, .push_constant = 1},
     };
 
     for (size_t i = 0; i < NGLI_ARRAY_NB(crafter_uniforms); i++) {
@@ -530,34 +573,52 @@ static int build_blocks_map(struct pass *s, struct pipeline_desc *desc)
     return 0;
 }
 
-int ngli_pass_prepare(struct pass *s)
+static int build_constants_map(struct pass *s, struct pipeline_desc *desc)
 {
-    struct ngl_ctx *ctx = s->ctx;
-    struct gpu_ctx *gpu_ctx = ctx->gpu_ctx;
-    struct rnode *rnode = ctx->rnode_pos;
+    ngli_darray_init(&desc->constants_map, sizeof(struct constant_map), 0);
 
-    const int format = rnode->rendertarget_layout.depth_stencil.format;
-    if (rnode->graphics_state.depth_test && !ngli_format_has_depth(format)) {
-        LOG(ERROR, "depth testing is not supported on rendertargets with no depth attachment");
-        return NGL_ERROR_INVALID_USAGE;
+    const struct constant_map *constants = ngli_darray_data(&s->constants);
+    for (size_t i = 0; i < ngli_darray_count(&s->constants); i++) {
+        struct constant_map *map = ngli_darray_push(&desc->constants_map, &constants[i]);
+        if (!map)
+            return NGL_ERROR_MEMORY;
+        memcpy(map->value, map->data, map->size);
     }
 
-    if (rnode->graphics_state.stencil_test && !ngli_format_has_stencil(format)) {
-        LOG(ERROR, "stencil operations are not supported on rendertargets with no stencil attachment");
-        return NGL_ERROR_INVALID_USAGE;
+    return 0;
+}
+
+static int constants_changed(const struct pipeline_desc *desc)
+{
+    const struct constant_map *constants = ngli_darray_data(&desc->constants_map);
+    for (size_t i = 0; i < ngli_darray_count(&desc->constants_map); i++) {
+        const struct constant_map *map = &constants[i];
+        if (memcmp(map->value, map->data, map->size))
+            return 1;
     }
+    return 0;
+}
 
-    struct graphics_state state = rnode->graphics_state;
-    int ret = ngli_blending_apply_preset(&state, s->params.blending);
-    if (ret < 0)
-        return ret;
+static void reset_pipeline_desc(struct pipeline_desc *desc)
+{
+    ngli_pipeline_compat_freep(&desc->pipeline_compat);
+    ngli_pgcraft_freep(&desc->crafter);
+    ngli_darray_reset(&desc->uniforms_map);
+    ngli_darray_reset(&desc->blocks_map);
+    ngli_darray_reset(&desc->textures_map);
+    ngli_darray_reset(&desc->constants_map);
+}
 
-    struct pipeline_desc *desc = ngli_darray_push(&s->pipeline_descs, NULL);
-    if (!desc)
-        return NGL_ERROR_MEMORY;
-    ctx->rnode_pos->id = ngli_darray_count(&s->pipeline_descs) - 1;
+static int init_pipeline_desc(struct pass *s, struct pipeline_desc *desc,
+                              const struct graphics_state *state,
+                              const struct rendertarget_layout *rt_layout)
+{
+    struct ngl_ctx *ctx = s->ctx;
+    struct gpu_ctx *gpu_ctx = ctx->gpu_ctx;
 
     memset(desc, 0, sizeof(*desc));
+    desc->state = *state;
+    desc->rt_layout = *rt_layout;
 
     desc->crafter = ngli_pgcraft_create(ctx);
     if (!desc->crafter)
@@ -582,7 +643,7 @@ int ngli_pass_prepare(struct pass *s)
         .workgroup_size    = {NGLI_ARG_VEC3(s->params.workgroup_size)},
     };
 
-    ret = ngli_pgcraft_craft(desc->crafter, &crafter_params);
+    int ret = ngli_pgcraft_craft(desc->crafter, &crafter_params);
     if (ret < 0)
         return ret;
 
@@ -595,8 +656,8 @@ int ngli_pass_prepare(struct pass *s)
         .type = s->pipeline_type,
         .graphics = {
             .topology     = s->topology,
-            .state        = state,
-            .rt_layout    = rnode->rendertarget_layout,
+            .state        = desc->state,
+            .rt_layout    = desc->rt_layout,
             .vertex_state = ngli_pgcraft_get_vertex_state(desc->crafter),
         },
         .program     = ngli_pgcraft_get_program(desc->crafter),
@@ -616,6 +677,10 @@ int ngli_pass_prepare(struct pass *s)
     if (ret < 0)
         return ret;
 
+    ret = build_constants_map(s, desc);
+    if (ret < 0)
+        return ret;
+
     desc->modelview_matrix_index = ngli_pgcraft_get_uniform_index(desc->crafter, "ngl_modelview_matrix", NGLI_PROGRAM_SHADER_VERT);
     desc->projection_matrix_index = ngli_pgcraft_get_uniform_index(desc->crafter, "ngl_projection_matrix", NGLI_PROGRAM_SHADER_VERT);
     desc->normal_matrix_index = ngli_pgcraft_get_uniform_index(desc->crafter, "ngl_normal_matrix", NGLI_PROGRAM_SHADER_VERT);
@@ -632,6 +697,35 @@ int ngli_pass_prepare(struct pass *s)
     return 0;
 }
 
+int ngli_pass_prepare(struct pass *s)
+{
+    struct ngl_ctx *ctx = s->ctx;
+    struct rnode *rnode = ctx->rnode_pos;
+
+    const int format = rnode->rendertarget_layout.depth_stencil.format;
+    if (rnode->graphics_state.depth_test && !ngli_format_has_depth(format)) {
+        LOG(ERROR, "depth testing is not supported on rendertargets with no depth attachment");
+        return NGL_ERROR_INVALID_USAGE;
+    }
+
+    if (rnode->graphics_state.stencil_test && !ngli_format_has_stencil(format)) {
+        LOG(ERROR, "stencil operations are not supported on rendertargets with no stencil attachment");
+        return NGL_ERROR_INVALID_USAGE;
+    }
+
+    struct graphics_state state = rnode->graphics_state;
+    int ret = ngli_blending_apply_preset(&state, s->params.blending);
+    if (ret < 0)
+        return ret;
+
+    struct pipeline_desc *desc = ngli_darray_push(&s->pipeline_descs, NULL);
+    if (!desc)
+        return NGL_ERROR_MEMORY;
+    ctx->rnode_pos->id = ngli_darray_count(&s->pipeline_descs) - 1;
+
+    return init_pipeline_desc(s, desc, &state, &rnode->rendertarget_layout);
+}
+
 int ngli_pass_init(struct pass *s, struct ngl_ctx *ctx, const struct pass_params *params)
 {
     s->ctx = ctx;
@@ -641,6 +735,7 @@ int ngli_pass_init(struct pass *s, struct ngl_ctx *ctx, const struct pass_params
     ngli_darray_init(&s->crafter_textures, sizeof(struct pgcraft_texture), 0);
     ngli_darray_init(&s->crafter_uniforms, sizeof(struct pgcraft_uniform), 0);
     ngli_darray_init(&s->crafter_blocks, sizeof(struct pgcraft_block), 0);
+    ngli_darray_init(&s->constants, sizeof(struct constant_map), 0);
 
     ngli_darray_init(&s->pipeline_descs, sizeof(struct pipeline_desc), 0);
     ngli_darray_init(&s->draw_resources, sizeof(struct ngl_node *), 0);
@@ -666,12 +761,7 @@ void ngli_pass_uninit(struct pass *s)
 
     struct pipeline_desc *descs = ngli_darray_data(&s->pipeline_descs);
     for (size_t i = 0; i < ngli_darray_count(&s->pipeline_descs); i++) {
-        struct pipeline_desc *desc = &descs[i];
-        ngli_pipeline_compat_freep(&desc->pipeline_compat);
-        ngli_pgcraft_freep(&desc->crafter);
-        ngli_darray_reset(&desc->uniforms_map);
-        ngli_darray_reset(&desc->blocks_map);
-        ngli_darray_reset(&desc->textures_map);
+        reset_pipeline_desc(&descs[i]);
     }
     ngli_darray_reset(&s->pipeline_descs);
 
@@ -679,10 +769,39 @@ void ngli_pass_uninit(struct pass *s)
     ngli_darray_reset(&s->crafter_textures);
     ngli_darray_reset(&s->crafter_uniforms);
     ngli_darray_reset(&s->crafter_blocks);
+    ngli_darray_reset(&s->constants);
 
     memset(s, 0, sizeof(*s));
 }
 
+int ngli_pass_update(struct pass *s)
+{
+    /*
+     * The specialized pipelines are crafted again outside of the render
+     * passes. The command buffers still using the previous ones hold
+     * references on their pipelines and bindgroups (and through them on their
+     * buffers and textures), so they can be released right away.
+     */
+    struct pipeline_desc *descs = ngli_darray_data(&s->pipeline_descs);
+    for (size_t i = 0; i < ngli_darray_count(&s->pipeline_descs); i++) {
+        struct pipeline_desc *desc = &descs[i];
+        if (desc->pipeline_compat && !constants_changed(desc))
+            continue;
+
+        const struct graphics_state state = desc->state;
+        const struct rendertarget_layout rt_layout = desc->rt_layout;
+        reset_pipeline_desc(desc);
+        int ret = init_pipeline_desc(s, desc, &state, &rt_layout);
+        if (ret < 0) {
+            LOG(ERROR, "unable to specialize pipeline with the new uniform values");
+            reset_pipeline_desc(desc);
+            return ret;
+        }
+    }
+
+    return 0;
+}
+
 int ngli_pass_exec(struct pass *s)
 {
     struct ngl_node **draw_resources = ngli_darray_data(&s->draw_resources);
@@ -694,6 +813,10 @@ int ngli_pass_exec(struct pass *s)
     struct pipeline_desc *descs = ngli_darray_data(&s->pipeline_descs);
     struct pipeline_desc *desc = &descs[ctx->rnode_pos->id];
     struct pipeline_compat *pipeline_compat = desc->pipeline_compat;
+    if (!pipeline_compat) {
+        LOG(ERROR, "no pipeline available for %s", params->label);
+        return NGL_ERROR_INVALID_USAGE;
+    }
 
     const float *modelview_matrix = ngli_darray_tail(&ctx->modelview_matrix_stack);
     const float *projection_matrix = ngli_darray_tail(&ctx->projection_matrix_stack);
@@ -707,11 +830,16 @@ int ngli_pass_exec(struct pass *s)
     ngli_pipeline_compat_update_uniform(pipeline_compat, desc->resolution_index, resolution);
 
     if (desc->normal_matrix_index >= 0) {
-        float normal_matrix[3*3];
-        ngli_mat3_from_mat4(normal_matrix, modelview_matrix);
-        ngli_mat3_inverse(normal_matrix, normal_matrix);
-        ngli_mat3_transpose(normal_matrix, normal_matrix);
-        ngli_pipeline_compat_update_uniform(pipeline_compat, desc->normal_matrix_index, normal_matrix);
+        if (!desc->normal_matrix_cached ||
+            memcmp(desc->normal_matrix_src, modelview_matrix, sizeof(desc->normal_matrix_src))) {
+            float *normal_matrix = desc->normal_matrix;
+            ngli_mat3_from_mat4(normal_matrix, modelview_matrix);
+            ngli_mat3_inverse(normal_matrix, normal_matrix);
+            ngli_mat3_transpose(normal_matrix, normal_matrix);
+            memcpy(desc->normal_matrix_src, modelview_matrix, sizeof(desc->normal_matrix_src));
+            desc->normal_matrix_cached = 1;
+        }
+        ngli_pipeline_compat_update_uniform(pipeline_compat, desc->normal_matrix_index, desc->normal_matrix);
     }
 
     const struct uniform_map *uniform_map = ngli_darray_data(&desc->uniforms_map);
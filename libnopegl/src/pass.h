@@ -75,6 +75,7 @@ struct pass {
     struct darray crafter_uniforms;
     struct darray crafter_textures;
     struct darray crafter_blocks;
+    struct darray constants; // constant_map
     struct darray pipeline_descs;
     struct darray draw_resources;
 };
@@ -83,6 +84,7 @@ int ngli_pass_init(struct pass *s, struct ngl_ctx *ctx, const struct pass_params
 int ngli_pass_prepare(struct pass *s);
 void ngli_pass_uninit(struct pass *s);
 void ngli_pass_update_texture_uniforms(struct pipeline *pipeline, const struct pgcraft_texture_info *info);
+int ngli_pass_update(struct pass *s);
 int ngli_pass_exec(struct pass *s);
 
 #endif
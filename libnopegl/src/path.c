@@ -344,19 +344,18 @@ void ngli_path_transform(struct path *s, const float *matrix)
         const float *y = segment->bezier_y;
         const float *z = segment->bezier_z;
 
-        NGLI_ALIGNED_VEC(p0) = {x[0], y[0], z[0], 1.f};
-        NGLI_ALIGNED_VEC(p1) = {x[1], y[1], z[1], 1.f};
-        NGLI_ALIGNED_VEC(p2) = {x[2], y[2], z[2], 1.f};
-        NGLI_ALIGNED_VEC(p3) = {x[3], y[3], z[3], 1.f};
-
-        ngli_mat4_mul_vec4(p0, matrix, p0);
-        ngli_mat4_mul_vec4(p1, matrix, p1);
-        ngli_mat4_mul_vec4(p2, matrix, p2);
-        ngli_mat4_mul_vec4(p3, matrix, p3);
-
-        const float xt[4] = {p0[0], p1[0], p2[0], p3[0]};
-        const float yt[4] = {p0[1], p1[1], p2[1], p3[1]};
-        const float zt[4] = {p0[2], p1[2], p2[2], p3[2]};
+        NGLI_ALIGNED_MAT(p) = {
+            x[0], y[0], z[0], 1.f,
+            x[1], y[1], z[1], 1.f,
+            x[2], y[2], z[2], 1.f,
+            x[3], y[3], z[3], 1.f,
+        };
+
+        ngli_mat4_mul_vec4_array(p, matrix, p, 4);
+
+        const float xt[4] = {p[0], p[4], p[ 8], p[12]};
+        const float yt[4] = {p[1], p[5], p[ 9], p[13]};
+        const float zt[4] = {p[2], p[6], p[10], p[14]};
 
         memcpy(segment->bezier_x, xt, sizeof(xt));
         memcpy(segment->bezier_y, yt, sizeof(yt));
@@ -21,7 +21,9 @@
  * under the License.
  */
 
+#include <inttypes.h>
 #include <limits.h>
+#include <math.h>
 #include <string.h>
 #include <stddef.h>
 
@@ -288,9 +290,109 @@ static int inject_block_uniform(struct pgcraft *s, struct bstr *b,
     return ngli_block_add_field(block, uniform->name, uniform->type, uniform->count);
 }
 
+static int get_constant_nb_components(int type)
+{
+    switch (type) {
+    case NGLI_TYPE_BOOL:
+    case NGLI_TYPE_I32:
+    case NGLI_TYPE_U32:
+    case NGLI_TYPE_F32:   return 1;
+    case NGLI_TYPE_IVEC2:
+    case NGLI_TYPE_UVEC2:
+    case NGLI_TYPE_VEC2:  return 2;
+    case NGLI_TYPE_IVEC3:
+    case NGLI_TYPE_UVEC3:
+    case NGLI_TYPE_VEC3:  return 3;
+    case NGLI_TYPE_IVEC4:
+    case NGLI_TYPE_UVEC4:
+    case NGLI_TYPE_VEC4:  return 4;
+    case NGLI_TYPE_MAT3:  return 3 * 3;
+    case NGLI_TYPE_MAT4:  return 4 * 4;
+    default:              return 0;
+    }
+}
+
+static int is_float_type(int type)
+{
+    return type == NGLI_TYPE_F32  ||
+           type == NGLI_TYPE_VEC2 ||
+           type == NGLI_TYPE_VEC3 ||
+           type == NGLI_TYPE_VEC4 ||
+           type == NGLI_TYPE_MAT3 ||
+           type == NGLI_TYPE_MAT4;
+}
+
+static int is_unsigned_type(int type)
+{
+    return type == NGLI_TYPE_U32   ||
+           type == NGLI_TYPE_UVEC2 ||
+           type == NGLI_TYPE_UVEC3 ||
+           type == NGLI_TYPE_UVEC4;
+}
+
+/*
+ * Uniforms flagged as constant are inlined as GLSL constants (and thus do not
+ * take any room in the uniform blocks) as long as their value can be expressed
+ * as a literal.
+ */
+static int can_inline_uniform(const struct pgcraft_uniform *uniform)
+{
+    if (!uniform->constant || !uniform->data || uniform->count)
+        return 0;
+
+    const int nb_comps = get_constant_nb_components(uniform->type);
+    if (!nb_comps)
+        return 0;
+
+    if (is_float_type(uniform->type)) {
+        const float *values = uniform->data;
+        for (int i = 0; i < nb_comps; i++)
+            if (!isfinite(values[i]))
+                return 0;
+    }
+
+    return 1;
+}
+
+static void inject_constant_uniform(struct pgcraft *s, struct bstr *b,
+                                    const struct pgcraft_uniform *uniform)
+{
+    const char *type = get_glsl_type(uniform->type);
+    ngli_bstr_printf(b, "const %s %s = %s(", type, uniform->name, type);
+
+    const int nb_comps = get_constant_nb_components(uniform->type);
+    for (int i = 0; i < nb_comps; i++) {
+        const char *sep = i ? ", " : "";
+        /* Bit exact and independent of the locale */
+        if (is_float_type(uniform->type))
+            ngli_bstr_printf(b, "%suintBitsToFloat(0x%08" PRIx32 "u)", sep, ((const uint32_t *)uniform->data)[i]);
+        else if (is_unsigned_type(uniform->type))
+            ngli_bstr_printf(b, "%s%uu", sep, ((const uint32_t *)uniform->data)[i]);
+        else
+            ngli_bstr_printf(b, "%s%d", sep, ((const int32_t *)uniform->data)[i]);
+    }
+    ngli_bstr_print(b, ");\n");
+}
+
+static int is_push_constant(const struct pgcraft *s, const struct pgcraft_uniform *uniform)
+{
+    const struct darray *fields_array = &s->compat_info.pcblock.fields;
+    const struct block_field *fields = ngli_darray_data(fields_array);
+    for (size_t i = 0; i < ngli_darray_count(fields_array); i++)
+        if (!strcmp(fields[i].name, uniform->name))
+            return 1;
+    return 0;
+}
+
 static int inject_uniform(struct pgcraft *s, struct bstr *b,
                           const struct pgcraft_uniform *uniform)
 {
+    if (is_push_constant(s, uniform))
+        return 0;
+    if (can_inline_uniform(uniform)) {
+        inject_constant_uniform(s, b, uniform);
+        return 0;
+    }
     return inject_block_uniform(s, b, uniform, uniform->stage);
 }
 
@@ -707,6 +809,49 @@ static int inject_ublock(struct pgcraft *s, struct bstr *b, int stage)
     return 0;
 }
 
+/*
+ * Gather the uniforms flagged as push constants in a block shared by all the
+ * stages, as long as they fit in the device limits. The ones that do not fit
+ * fall back on their stage uniform block.
+ */
+static int prepare_push_constants(struct pgcraft *s, const struct pgcraft_params *params)
+{
+    const struct gpu_limits *limits = &s->ctx->gpu_ctx->limits;
+    struct block *block = &s->compat_info.pcblock;
+
+    for (size_t i = 0; i < params->nb_uniforms; i++) {
+        const struct pgcraft_uniform *uniform = &params->uniforms[i];
+        if (!uniform->push_constant || uniform->count)
+            continue;
+
+        const size_t prev_size = block->size;
+        int ret = ngli_block_add_field(block, uniform->name, uniform->type, 0);
+        if (ret < 0)
+            return ret;
+
+        if (ngli_block_get_size(block, 0) > limits->max_push_constants_size) {
+            ngli_darray_pop(&block->fields);
+            block->size = prev_size;
+        }
+    }
+
+    return 0;
+}
+
+static void inject_push_constants(struct pgcraft *s, struct bstr *b)
+{
+    const struct block *block = &s->compat_info.pcblock;
+    if (!ngli_darray_count(&block->fields))
+        return;
+
+    /* instance name is empty to make field accesses identical to uniform accesses */
+    ngli_bstr_printf(b, "layout(%s,push_constant) uniform ngl_push_block {\n", glsl_layout_str_map[block->layout]);
+    const struct block_field *fields = ngli_darray_data(&block->fields);
+    for (size_t i = 0; i < ngli_darray_count(&block->fields); i++)
+        ngli_bstr_printf(b, "    %s %s;\n", get_glsl_type(fields[i].type), fields[i].name);
+    ngli_bstr_print(b, "};\n");
+}
+
 static int params_have_ssbos(struct pgcraft *s, const struct pgcraft_params *params, int stage)
 {
     for (size_t i = 0; i < params->nb_blocks; i++) {
@@ -1070,6 +1215,7 @@ static int craft_vert(struct pgcraft *s, const struct pgcraft_params *params)
         (ret = inject_attributes(s, b, params)) < 0 ||
         (ret = inject_ublock(s, b, NGLI_PROGRAM_SHADER_VERT)) < 0)
         return ret;
+    inject_push_constants(s, b);
 
     ngli_bstr_print(b, params->vert_base);
     return samplers_preproc(s, params, b);
@@ -1120,6 +1266,7 @@ static int craft_frag(struct pgcraft *s, const struct pgcraft_params *params)
         (ret = inject_blocks(s, b, params, NGLI_PROGRAM_SHADER_FRAG)) < 0 ||
         (ret = inject_ublock(s, b, NGLI_PROGRAM_SHADER_FRAG)) < 0)
         return ret;
+    inject_push_constants(s, b);
 
     ngli_bstr_print(b, "\n");
 
@@ -1142,6 +1289,7 @@ static int craft_comp(struct pgcraft *s, const struct pgcraft_params *params)
         (ret = inject_blocks(s, b, params, NGLI_PROGRAM_SHADER_COMP)) < 0 ||
         (ret = inject_ublock(s, b, NGLI_PROGRAM_SHADER_COMP)) < 0)
         return ret;
+    inject_push_constants(s, b);
 
     ngli_bstr_print(b, params->comp_base);
     return samplers_preproc(s, params, b);
@@ -1225,6 +1373,12 @@ static int32_t get_ublock_index(const struct pgcraft *s, const char *name, int s
     for (int32_t i = 0; i < (int32_t)ngli_darray_count(fields_array); i++)
         if (!strcmp(fields[i].name, name))
             return stage << 16 | i;
+
+    fields_array = &compat_info->pcblock.fields;
+    fields = ngli_darray_data(fields_array);
+    for (int32_t i = 0; i < (int32_t)ngli_darray_count(fields_array); i++)
+        if (!strcmp(fields[i].name, name))
+            return NGLI_PGCRAFT_PUSH_CONSTANTS_STAGE << 16 | i;
     return -1;
 }
 
@@ -1424,6 +1578,7 @@ struct pgcraft *ngli_pgcraft_create(struct ngl_ctx *ctx)
         compat_info->ubindings[i] = -1;
         compat_info->uindices[i] = -1;
     }
+    ngli_block_init(ctx->gpu_ctx, &compat_info->pcblock, NGLI_BLOCK_LAYOUT_STD430);
 
     ngli_darray_init(&s->symbols, sizeof(char[MAX_ID_LEN]), 0);
 
@@ -1505,8 +1660,12 @@ static int get_program_graphics(struct pgcraft *s, const struct pgcraft_params *
 
 int ngli_pgcraft_craft(struct pgcraft *s, const struct pgcraft_params *params)
 {
-    int ret = params->comp_base ? get_program_compute(s, params)
-                                : get_program_graphics(s, params);
+    int ret = prepare_push_constants(s, params);
+    if (ret < 0)
+        return ret;
+
+    ret = params->comp_base ? get_program_compute(s, params)
+                            : get_program_graphics(s, params);
     if (ret < 0)
         return ret;
 
@@ -1645,6 +1804,7 @@ void ngli_pgcraft_freep(struct pgcraft **sp)
     for (size_t i = 0; i < NGLI_ARRAY_NB(compat_info->ublocks); i++) {
         ngli_block_reset(&compat_info->ublocks[i]);
     }
+    ngli_block_reset(&compat_info->pcblock);
 
     for (size_t i = 0; i < NGLI_ARRAY_NB(s->shaders); i++)
         ngli_bstr_freep(&s->shaders[i]);
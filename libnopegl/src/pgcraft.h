@@ -41,6 +41,8 @@ struct pgcraft_uniform { // also buffers (for arrays)
     int precision;
     const void *data;
     size_t count;
+    int push_constant; // hint: small value updated for every draw
+    int constant;      // hint: inline the current value in the shader
 };
 
 enum pgcraft_shader_tex_type {
@@ -161,11 +163,19 @@ struct pgcraft_texture_info {
  * the user (through the Uniform* nodes), we have to make a compatibility
  * layer, which we name "ublock" (for uniform-block). This compatibility layer
  * maps single uniforms to dedicated uniform blocks.
+ *
+ * When the backend supports them, the uniforms flagged with the push_constant
+ * hint are instead gathered (within the device limits) in a push constant
+ * block shared by all the stages. The index of such uniforms uses
+ * NGLI_PGCRAFT_PUSH_CONSTANTS_STAGE as stage.
  */
+#define NGLI_PGCRAFT_PUSH_CONSTANTS_STAGE NGLI_PROGRAM_SHADER_NB
+
 struct pgcraft_compat_info {
     struct block ublocks[NGLI_PROGRAM_SHADER_NB];
     int32_t ubindings[NGLI_PROGRAM_SHADER_NB];
     int32_t uindices[NGLI_PROGRAM_SHADER_NB];
+    struct block pcblock;
 
     const struct pgcraft_texture_info *texture_infos;
     const struct image **images;
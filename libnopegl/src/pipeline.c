@@ -30,6 +30,9 @@
 #include "type.h"
 #include "utils.h"
 
+/* Rough estimate of the driver state backing a pipeline object */
+#define PIPELINE_MEMORY_SIZE 4096
+
 int ngli_pipeline_graphics_copy(struct pipeline_graphics *dst, const struct pipeline_graphics *src)
 {
     dst->topology = src->topology;
@@ -54,7 +57,9 @@ static void pipeline_freep(struct pipeline **sp)
     struct pipeline *s = *sp;
     ngli_pipeline_graphics_reset(&s->graphics);
 
-    (*sp)->gpu_ctx->cls->pipeline_freep(sp);
+    struct gpu_ctx *gpu_ctx = s->gpu_ctx;
+    gpu_ctx->memory_usage -= s->memory_size;
+    gpu_ctx->cls->pipeline_freep(sp);
 }
 
 struct pipeline *ngli_pipeline_create(struct gpu_ctx *gpu_ctx)
@@ -75,7 +80,13 @@ int ngli_pipeline_init(struct pipeline *s, const struct pipeline_params *params)
     s->program  = params->program;
     s->layout = params->layout;
 
-    return s->gpu_ctx->cls->pipeline_init(s);
+    ret = s->gpu_ctx->cls->pipeline_init(s);
+    if (ret < 0)
+        return ret;
+
+    s->memory_size = PIPELINE_MEMORY_SIZE;
+    s->gpu_ctx->memory_usage += s->memory_size;
+    return 0;
 }
 
 void ngli_pipeline_freep(struct pipeline **sp)
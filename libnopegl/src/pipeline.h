@@ -68,6 +68,7 @@ enum {
 
 struct pipeline_layout {
     const struct bindgroup_layout *bindgroup_layout;
+    size_t push_constants_size;
 };
 
 struct pipeline_params {
@@ -85,6 +86,7 @@ struct pipeline {
     struct pipeline_graphics graphics;
     const struct program *program;
     struct pipeline_layout layout;
+    uint64_t memory_size; /* accounted in gpu_ctx.memory_usage */
 };
 
 NGLI_RC_CHECK_STRUCT(pipeline);
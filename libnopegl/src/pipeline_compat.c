@@ -58,6 +58,14 @@ struct pipeline_compat {
     const struct pgcraft_compat_info *compat_info;
     struct buffer *ubuffers[NGLI_PROGRAM_SHADER_NB];
     uint8_t *mapped_datas[NGLI_PROGRAM_SHADER_NB];
+    /*
+     * CPU copies of the uniform buffers content, used to skip the writes
+     * (and the buffer mappings) of uniforms that did not change since the
+     * last draw
+     */
+    uint8_t *shadow_datas[NGLI_PROGRAM_SHADER_NB];
+    uint8_t *push_constants;
+    size_t push_constants_size;
 };
 
 static int map_buffer(struct pipeline_compat *s, int stage)
@@ -110,10 +118,18 @@ static int init_blocks_buffers(struct pipeline_compat *s, const struct pipeline_
         if (ret < 0)
             return ret;
 
-        if (gpu_ctx->features & NGLI_FEATURE_BUFFER_MAP_PERSISTENT) {
-            ret = ngli_buffer_map(buffer, 0, buffer->size, (void **)&s->mapped_datas[i]);
-            if (ret < 0)
-                return ret;
+        s->shadow_datas[i] = ngli_calloc(1, block_size);
+        if (!s->shadow_datas[i])
+            return NGL_ERROR_MEMORY;
+
+        /* Synchronize the buffer content with its (zeroed) shadow copy */
+        ret = map_buffer(s, (int)i);
+        if (ret < 0)
+            return ret;
+        memcpy(s->mapped_datas[i], s->shadow_datas[i], block_size);
+        if (!(gpu_ctx->features & NGLI_FEATURE_BUFFER_MAP_PERSISTENT)) {
+            ngli_buffer_unmap(buffer);
+            s->mapped_datas[i] = NULL;
         }
 
         ngli_pipeline_compat_update_buffer(s, s->compat_info->uindices[i], buffer, 0, buffer->size);
@@ -188,7 +204,8 @@ static int create_pipeline(struct pipeline_compat *s)
         .graphics = s->graphics,
         .program  = s->program,
         .layout   = {
-            .bindgroup_layout = s->bindgroup_layout,
+            .bindgroup_layout    = s->bindgroup_layout,
+            .push_constants_size = s->push_constants_size,
         }
     };
 
@@ -238,6 +255,13 @@ int ngli_pipeline_compat_init(struct pipeline_compat *s, const struct pipeline_c
     if (ret < 0)
         return ret;
 
+    s->push_constants_size = ngli_block_get_size(&s->compat_info->pcblock, 0);
+    if (s->push_constants_size) {
+        s->push_constants = ngli_calloc(1, s->push_constants_size);
+        if (!s->push_constants)
+            return NGL_ERROR_MEMORY;
+    }
+
     ret = create_pipeline(s);
     if (ret < 0)
         return ret;
@@ -264,17 +288,29 @@ int ngli_pipeline_compat_update_uniform_count(struct pipeline_compat *s, int32_t
 
     const int32_t stage = index >> 16;
     const int32_t field_index = index & 0xffff;
+
+    if (stage == NGLI_PGCRAFT_PUSH_CONSTANTS_STAGE) {
+        const struct block_field *fields = ngli_darray_data(&s->compat_info->pcblock.fields);
+        const struct block_field *field = &fields[field_index];
+        if (value)
+            ngli_block_field_update_count(field, s->push_constants + field->offset, value, count);
+        return 0;
+    }
+
     const struct block *block = &s->compat_info->ublocks[stage];
     const struct block_field *fields = ngli_darray_data(&block->fields);
     const struct block_field *field = &fields[field_index];
     if (value) {
+        uint8_t *shadow = s->shadow_datas[stage] + field->offset;
+        if (!ngli_block_field_update_count(field, shadow, value, count))
+            return 0;
         if (!(gpu_ctx->features & NGLI_FEATURE_BUFFER_MAP_PERSISTENT)) {
             int ret = map_buffer(s, stage);
             if (ret < 0)
                 return ret;
         }
         uint8_t *dst = s->mapped_datas[stage] + field->offset;
-        ngli_block_field_copy_count(field, dst, value, count);
+        memcpy(dst, shadow, field->size);
     }
 
     return 0;
@@ -542,6 +578,7 @@ void ngli_pipeline_compat_draw(struct pipeline_compat *s, int nb_vertices, int n
     for (size_t i = 0; i < s->nb_vertex_buffers; i++)
         ngli_gpu_ctx_set_vertex_buffer(gpu_ctx, (uint32_t)i, s->vertex_buffers[i]);
     ngli_gpu_ctx_set_bindgroup(gpu_ctx, s->cur_bindgroup, s->dynamic_offsets, s->nb_dynamic_offsets);
+    ngli_gpu_ctx_set_push_constants(gpu_ctx, s->push_constants, s->push_constants_size);
     ngli_gpu_ctx_draw(gpu_ctx, nb_vertices, nb_instances);
 }
 
@@ -558,6 +595,7 @@ void ngli_pipeline_compat_draw_indexed(struct pipeline_compat *s, const struct b
         ngli_gpu_ctx_set_vertex_buffer(gpu_ctx, (uint32_t)i, s->vertex_buffers[i]);
     ngli_gpu_ctx_set_index_buffer(gpu_ctx, indices, indices_format);
     ngli_gpu_ctx_set_bindgroup(gpu_ctx, s->cur_bindgroup, s->dynamic_offsets, s->nb_dynamic_offsets);
+    ngli_gpu_ctx_set_push_constants(gpu_ctx, s->push_constants, s->push_constants_size);
     ngli_gpu_ctx_draw_indexed(gpu_ctx, nb_indices, nb_instances);
 }
 
@@ -571,6 +609,7 @@ void ngli_pipeline_compat_dispatch(struct pipeline_compat *s, uint32_t nb_group_
 
     ngli_gpu_ctx_set_pipeline(gpu_ctx, s->pipeline);
     ngli_gpu_ctx_set_bindgroup(gpu_ctx, s->cur_bindgroup, s->dynamic_offsets, s->nb_dynamic_offsets);
+    ngli_gpu_ctx_set_push_constants(gpu_ctx, s->push_constants, s->push_constants_size);
     ngli_gpu_ctx_dispatch(gpu_ctx, nb_group_x, nb_group_y, nb_group_z);
 }
 
@@ -599,7 +638,9 @@ void ngli_pipeline_compat_freep(struct pipeline_compat **sp)
                     ngli_buffer_unmap(s->ubuffers[i]);
                 ngli_buffer_freep(&s->ubuffers[i]);
             }
+            ngli_freep(&s->shadow_datas[i]);
         }
     }
+    ngli_freep(&s->push_constants);
     ngli_freep(sp);
 }
@@ -19,22 +19,49 @@
  * under the License.
  */
 
+#include <string.h>
+
 #include "gpu_ctx.h"
 #include "program.h"
+#include "utils.h"
 
 struct program *ngli_program_create(struct gpu_ctx *gpu_ctx)
 {
     return gpu_ctx->cls->program_create(gpu_ctx);
 }
 
+/*
+ * The driver does not tell how much memory a compiled program takes, so its
+ * footprint is estimated from the size of its sources.
+ */
+static uint64_t get_memory_size(const struct program_params *params)
+{
+    uint64_t size = 0;
+    const char *sources[] = {params->vertex, params->fragment, params->compute};
+    for (size_t i = 0; i < NGLI_ARRAY_NB(sources); i++)
+        if (sources[i])
+            size += strlen(sources[i]);
+    return size;
+}
+
 int ngli_program_init(struct program *s, const struct program_params *params)
 {
-    return s->gpu_ctx->cls->program_init(s, params);
+    int ret = s->gpu_ctx->cls->program_init(s, params);
+    if (ret < 0)
+        return ret;
+
+    s->memory_size = get_memory_size(params);
+    s->gpu_ctx->memory_usage += s->memory_size;
+    s->gpu_ctx->program_memory += s->memory_size;
+    return 0;
 }
 
 void ngli_program_freep(struct program **sp)
 {
     if (!*sp)
         return;
-    (*sp)->gpu_ctx->cls->program_freep(sp);
+    struct gpu_ctx *gpu_ctx = (*sp)->gpu_ctx;
+    gpu_ctx->memory_usage -= (*sp)->memory_size;
+    gpu_ctx->program_memory -= (*sp)->memory_size;
+    gpu_ctx->cls->program_freep(sp);
 }
@@ -22,6 +22,8 @@
 #ifndef PROGRAM_H
 #define PROGRAM_H
 
+#include <stdint.h>
+
 #include "hmap.h"
 
 struct gpu_ctx;
@@ -52,6 +54,7 @@ struct program {
     struct hmap *uniforms;
     struct hmap *attributes;
     struct hmap *buffer_blocks;
+    uint64_t memory_size; /* accounted in gpu_ctx.memory_usage */
 };
 
 struct program *ngli_program_create(struct gpu_ctx *gpu_ctx);
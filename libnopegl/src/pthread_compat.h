@@ -51,6 +51,9 @@ typedef SRWLOCK pthread_mutex_t;
 typedef CONDITION_VARIABLE pthread_cond_t;
 #define PTHREAD_COND_INITIALIZER CONDITION_VARIABLE_INIT
 
+typedef INIT_ONCE pthread_once_t;
+#define PTHREAD_ONCE_INIT INIT_ONCE_STATIC_INIT
+
 static unsigned __stdcall pthread_compat_worker(void *arg)
 {
     pthread_t *thread = (pthread_t *)arg;
@@ -175,5 +178,48 @@ static inline int pthread_cond_destroy(pthread_cond_t *cond)
 {
     return 0;
 }
+
+static BOOL CALLBACK pthread_compat_once_cb(PINIT_ONCE once, PVOID param, PVOID *context)
+{
+    void (*init_routine)(void) = (void (*)(void))param;
+    init_routine();
+    return TRUE;
+}
+
+static inline int pthread_once(pthread_once_t *once, void (*init_routine)(void))
+{
+    if (!InitOnceExecuteOnce(once, pthread_compat_once_cb, (PVOID)init_routine, NULL))
+        return EINVAL;
+    return 0;
+}
+
+typedef DWORD pthread_key_t;
+
+/* The destructors are not supported: the stored values must not need one */
+static inline int pthread_key_create(pthread_key_t *key, void (*destructor)(void *))
+{
+    if (destructor)
+        return EINVAL;
+    const DWORD index = TlsAlloc();
+    if (index == TLS_OUT_OF_INDEXES)
+        return EAGAIN;
+    *key = index;
+    return 0;
+}
+
+static inline int pthread_key_delete(pthread_key_t key)
+{
+    return TlsFree(key) ? 0 : EINVAL;
+}
+
+static inline void *pthread_getspecific(pthread_key_t key)
+{
+    return TlsGetValue(key);
+}
+
+static inline int pthread_setspecific(pthread_key_t key, const void *value)
+{
+    return TlsSetValue(key, (LPVOID)value) ? 0 : EINVAL;
+}
 #endif
 #endif
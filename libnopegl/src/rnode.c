@@ -22,18 +22,24 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "memory.h"
 #include "rnode.h"
 
 static void reset_child(void *user_arg, void *data)
 {
-    struct rnode *child = data;
-    ngli_rnode_reset(child);
+    struct rnode **childp = data;
+    ngli_rnode_reset(*childp);
+    ngli_freep(childp);
 }
 
 void ngli_rnode_init(struct rnode *s)
 {
     memset(s, 0, sizeof(*s));
-    ngli_darray_init(&s->children, sizeof(*s), 0);
+    /*
+     * The children are individually allocated so that their address remains
+     * stable while siblings are added (see deferred prepare in nodes.c)
+     */
+    ngli_darray_init(&s->children, sizeof(struct rnode *), 0);
     ngli_darray_set_free_func(&s->children, reset_child, NULL);
 }
 
@@ -45,9 +51,13 @@ void ngli_rnode_reset(struct rnode *s)
 
 struct rnode *ngli_rnode_add_child(struct rnode *s)
 {
-    struct rnode *child = ngli_darray_push(&s->children, NULL);
+    struct rnode *child = ngli_calloc(1, sizeof(*child));
     if (!child)
         return NULL;
+    if (!ngli_darray_push(&s->children, &child)) {
+        ngli_free(child);
+        return NULL;
+    }
     ngli_rnode_init(child);
     child->graphics_state = s->graphics_state;
     child->rendertarget_layout = s->rendertarget_layout;
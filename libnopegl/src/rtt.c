@@ -26,15 +26,29 @@
 
 #include "gpu_ctx.h"
 #include "internal.h"
+#include "log.h"
 #include "memory.h"
 #include "rendertarget.h"
 #include "rtt.h"
 
+/*
+ * Number of frames a pooled rtt is kept without being acquired, so that the
+ * intermediates of a node hidden for a short while are not reallocated
+ */
+#define MAX_POOL_IDLE_FRAMES 8
+
 struct rtt_ctx {
     struct ngl_ctx *ctx;
     struct rtt_params params;
 
-    struct texture *color;
+    /* Color textures owned by the rtt (see ngli_rtt_from_texture_params()) */
+    struct texture *colors[NGLI_MAX_COLOR_ATTACHMENTS];
+    size_t nb_owned_colors;
+
+    /* Pool state (see ngli_rtt_pool_acquire()) */
+    struct texture_params pool_params;
+    int pool_in_use;
+    int pool_idle_frames;
 
     struct rendertarget *rt;
     struct rendertarget *rt_resume;
@@ -46,6 +60,7 @@ struct rtt_ctx {
     struct texture *ms_depth;
 
     int started;
+    int has_visible_clear;
     struct viewport prev_viewport;
     struct scissor prev_scissor;
     struct rendertarget *prev_rendertargets[2];
@@ -61,6 +76,67 @@ struct rtt_ctx *ngli_rtt_create(struct ngl_ctx *ctx)
     return s;
 }
 
+/*
+ * Transient attachments (depth and multisampled textures) of a render target
+ * which is never interrupted do not outlive its render pass: their content is
+ * cleared on load and discarded on store. Such attachments can thus be shared
+ * between all the rtts of the context requiring the same texture parameters.
+ * The context cache holds one reference on each attachment.
+ */
+static struct texture *get_attachment(struct rtt_ctx *s, const struct texture_params *params, int shared)
+{
+    struct ngl_ctx *ctx = s->ctx;
+    struct gpu_ctx *gpu_ctx = ctx->gpu_ctx;
+
+    if (shared) {
+        struct texture **textures = ngli_darray_data(&ctx->rtt_attachments);
+        for (size_t i = 0; i < ngli_darray_count(&ctx->rtt_attachments); i++) {
+            if (!memcmp(&textures[i]->params, params, sizeof(*params)))
+                return NGLI_RC_REF(textures[i]);
+        }
+    }
+
+    struct texture *texture = ngli_texture_create(gpu_ctx);
+    if (!texture)
+        return NULL;
+
+    int ret = ngli_texture_init(texture, params);
+    if (ret < 0)
+        goto fail;
+
+    if (shared) {
+        if (!ngli_darray_push(&ctx->rtt_attachments, &texture))
+            goto fail;
+        return NGLI_RC_REF(texture);
+    }
+
+    return texture;
+
+fail:
+    ngli_texture_freep(&texture);
+    return NULL;
+}
+
+/*
+ * Whether beginning the render pass has an observable effect on its own, that
+ * is, whether an attachment is cleared and its content kept after the pass.
+ * If not, a render pass without any draw can be skipped entirely.
+ */
+static int is_visible_clear(const struct attachment *attachment)
+{
+    return attachment->load_op == NGLI_LOAD_OP_CLEAR &&
+           (attachment->store_op == NGLI_STORE_OP_STORE || attachment->resolve_target);
+}
+
+static int has_visible_clear(const struct rendertarget_params *params)
+{
+    for (size_t i = 0; i < params->nb_colors; i++) {
+        if (is_visible_clear(&params->colors[i]))
+            return 1;
+    }
+    return params->depth_stencil.attachment && is_visible_clear(&params->depth_stencil);
+}
+
 int ngli_rtt_init(struct rtt_ctx *s, const struct rtt_params *params)
 {
     struct ngl_ctx *ctx = s->ctx;
@@ -68,6 +144,7 @@ int ngli_rtt_init(struct rtt_ctx *s, const struct rtt_params *params)
 
     s->params = *params;
 
+    const int shared = !params->nb_interruptions;
     int transient_usage = 0;
     if (!params->nb_interruptions)
         transient_usage |= NGLI_TEXTURE_USAGE_TRANSIENT_ATTACHMENT_BIT;
@@ -83,12 +160,7 @@ int ngli_rtt_init(struct rtt_ctx *s, const struct rtt_params *params)
             struct texture *texture = attachment->attachment;
             const int texture_layer = attachment->attachment_layer;
 
-            struct texture *ms_texture = ngli_texture_create(gpu_ctx);
-            if (!ms_texture)
-                return NGL_ERROR_MEMORY;
-            s->ms_colors[s->nb_ms_colors++] = ms_texture;
-
-            struct texture_params attachment_params = {
+            const struct texture_params attachment_params = {
                 .type    = NGLI_TEXTURE_TYPE_2D,
                 .format  = texture->params.format,
                 .width   = s->params.width,
@@ -96,9 +168,10 @@ int ngli_rtt_init(struct rtt_ctx *s, const struct rtt_params *params)
                 .samples = s->params.samples,
                 .usage   = NGLI_TEXTURE_USAGE_COLOR_ATTACHMENT_BIT | transient_usage,
             };
-            int ret = ngli_texture_init(ms_texture, &attachment_params);
-            if (ret < 0)
-                return ret;
+            struct texture *ms_texture = get_attachment(s, &attachment_params, shared);
+            if (!ms_texture)
+                return NGL_ERROR_MEMORY;
+            s->ms_colors[s->nb_ms_colors++] = ms_texture;
 
             rt_params.colors[rt_params.nb_colors].attachment = ms_texture;
             rt_params.colors[rt_params.nb_colors].attachment_layer = 0;
@@ -111,6 +184,9 @@ int ngli_rtt_init(struct rtt_ctx *s, const struct rtt_params *params)
             rt_params.colors[rt_params.nb_colors].store_op = store_op;
         } else {
             rt_params.colors[rt_params.nb_colors] = s->params.colors[i];
+            /* A discardable attachment must still be preserved across the render pass interruptions */
+            if (s->params.nb_interruptions)
+                rt_params.colors[rt_params.nb_colors].store_op = NGLI_STORE_OP_STORE;
         }
         rt_params.nb_colors++;
     }
@@ -121,12 +197,7 @@ int ngli_rtt_init(struct rtt_ctx *s, const struct rtt_params *params)
             struct texture *texture = attachment->attachment;
             const int texture_layer = attachment->attachment_layer;
 
-            struct texture *ms_texture = ngli_texture_create(gpu_ctx);
-            if (!ms_texture)
-                return NGL_ERROR_MEMORY;
-            s->ms_depth = ms_texture;
-
-            struct texture_params attachment_params = {
+            const struct texture_params attachment_params = {
                 .type    = NGLI_TEXTURE_TYPE_2D,
                 .format  = texture->params.format,
                 .width   = s->params.width,
@@ -134,9 +205,10 @@ int ngli_rtt_init(struct rtt_ctx *s, const struct rtt_params *params)
                 .samples = s->params.samples,
                 .usage   = NGLI_TEXTURE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | transient_usage,
             };
-            int ret = ngli_texture_init(ms_texture, &attachment_params);
-            if (ret < 0)
-                return ret;
+            struct texture *ms_texture = get_attachment(s, &attachment_params, shared);
+            if (!ms_texture)
+                return NGL_ERROR_MEMORY;
+            s->ms_depth = ms_texture;
 
             rt_params.depth_stencil.attachment = ms_texture;
             rt_params.depth_stencil.attachment_layer = 0;
@@ -147,14 +219,11 @@ int ngli_rtt_init(struct rtt_ctx *s, const struct rtt_params *params)
             rt_params.depth_stencil.store_op = store_op;
         } else {
             rt_params.depth_stencil = s->params.depth_stencil;
+            if (s->params.nb_interruptions)
+                rt_params.depth_stencil.store_op = NGLI_STORE_OP_STORE;
         }
     } else if (s->params.depth_stencil_format != NGLI_FORMAT_UNDEFINED) {
-        struct texture *depth = ngli_texture_create(gpu_ctx);
-        if (!depth)
-            return NGL_ERROR_MEMORY;
-        s->depth = depth;
-
-        struct texture_params attachment_params = {
+        const struct texture_params attachment_params = {
             .type    = NGLI_TEXTURE_TYPE_2D,
             .format  = s->params.depth_stencil_format,
             .width   = s->params.width,
@@ -162,9 +231,10 @@ int ngli_rtt_init(struct rtt_ctx *s, const struct rtt_params *params)
             .samples = s->params.samples,
             .usage   = NGLI_TEXTURE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | transient_usage,
         };
-        int ret = ngli_texture_init(depth, &attachment_params);
-        if (ret < 0)
-            return ret;
+        struct texture *depth = get_attachment(s, &attachment_params, shared);
+        if (!depth)
+            return NGL_ERROR_MEMORY;
+        s->depth = depth;
 
         rt_params.depth_stencil.attachment = depth;
         rt_params.depth_stencil.load_op = NGLI_LOAD_OP_CLEAR;
@@ -179,6 +249,8 @@ int ngli_rtt_init(struct rtt_ctx *s, const struct rtt_params *params)
         rt_params.depth_stencil.store_op = store_op;
     }
 
+    s->has_visible_clear = has_visible_clear(&rt_params);
+
     s->rt = ngli_rendertarget_create(gpu_ctx);
     if (!s->rt)
         return NGL_ERROR_MEMORY;
@@ -191,21 +263,27 @@ int ngli_rtt_init(struct rtt_ctx *s, const struct rtt_params *params)
     s->available_rendertargets[1] = s->rt;
 
     if (s->params.nb_interruptions) {
-        for (size_t i = 0; i < rt_params.nb_colors; i++)
+        /*
+         * For the second rendertarget with load operations set to load, if
+         * an attachment is not consumed after the render pass (ie: it is not
+         * a user supplied texture, it is a multisampled texture that gets
+         * resolved or the user requested to discard it) and if the
+         * renderpass is interrupted *once*, we can discard the attachment at
+         * the end of the renderpass.
+         */
+        const int store_op = s->params.nb_interruptions > 1 ? NGLI_STORE_OP_STORE : NGLI_STORE_OP_DONT_CARE;
+
+        for (size_t i = 0; i < rt_params.nb_colors; i++) {
             rt_params.colors[i].load_op = NGLI_LOAD_OP_LOAD;
+            if (s->params.samples > 1 || s->params.colors[i].store_op == NGLI_STORE_OP_DONT_CARE)
+                rt_params.colors[i].store_op = store_op;
+        }
         rt_params.depth_stencil.load_op = NGLI_LOAD_OP_LOAD;
 
-        if (s->params.depth_stencil.attachment) {
+        if (s->params.depth_stencil.attachment && s->params.samples <= 1 &&
+            s->params.depth_stencil.store_op == NGLI_STORE_OP_STORE) {
             rt_params.depth_stencil.store_op = NGLI_STORE_OP_STORE;
         } else {
-            /*
-             * For the second rendertarget with load operations set to load, if
-             * the depth attachment is not exposed in the graph (ie: it is not
-             * a user supplied texture) and if the renderpass is interrupted
-             * *once*, we can discard the depth attachment at the end of the
-             * renderpass.
-             */
-            const int store_op = s->params.nb_interruptions > 1 ? NGLI_STORE_OP_STORE : NGLI_STORE_OP_DONT_CARE;
             rt_params.depth_stencil.store_op = store_op;
         }
 
@@ -222,30 +300,36 @@ int ngli_rtt_init(struct rtt_ctx *s, const struct rtt_params *params)
     return 0;
 }
 
-int ngli_rtt_from_texture_params(struct rtt_ctx *s, const struct texture_params *params)
+int ngli_rtt_from_texture_params(struct rtt_ctx *s, const struct texture_params *params, size_t nb_colors)
 {
     struct ngl_ctx *ctx = s->ctx;
     struct gpu_ctx *gpu_ctx = ctx->gpu_ctx;
 
-    s->color = ngli_texture_create(gpu_ctx);
-    if (!s->color)
-        return NGL_ERROR_MEMORY;
-
-    int ret = ngli_texture_init(s->color, params);
-    if (ret < 0)
-        return ret;
+    ngli_assert(nb_colors > 0 && nb_colors <= NGLI_MAX_COLOR_ATTACHMENTS);
 
-    const struct rtt_params rtt_params = (struct rtt_params) {
+    struct rtt_params rtt_params = {
         .width = params->width,
         .height = params->height,
-        .nb_colors = 1,
-        .colors[0] = {
-            .attachment = s->color,
-            .load_op = NGLI_LOAD_OP_CLEAR,
-            .store_op = NGLI_STORE_OP_STORE,
-        },
+        .nb_colors = nb_colors,
     };
 
+    for (size_t i = 0; i < nb_colors; i++) {
+        struct texture *color = ngli_texture_create(gpu_ctx);
+        if (!color)
+            return NGL_ERROR_MEMORY;
+        s->colors[s->nb_owned_colors++] = color;
+
+        int ret = ngli_texture_init(color, params);
+        if (ret < 0)
+            return ret;
+
+        rtt_params.colors[i] = (struct attachment) {
+            .attachment = color,
+            .load_op = NGLI_LOAD_OP_DONT_CARE,
+            .store_op = NGLI_STORE_OP_STORE,
+        };
+    }
+
     return ngli_rtt_init(s, &rtt_params);
 }
 
@@ -292,11 +376,16 @@ void ngli_rtt_end(struct rtt_ctx *s)
     ngli_assert(s->started);
     s->started = 0;
 
-    if (!ctx->render_pass_started) {
+    /*
+     * An empty render pass is only executed if it has an observable effect
+     * (the clear of an attachment kept after the pass)
+     */
+    if (!ctx->render_pass_started && s->has_visible_clear) {
         ngli_gpu_ctx_begin_render_pass(gpu_ctx, ctx->current_rendertarget);
         ctx->render_pass_started = 1;
     }
-    ngli_gpu_ctx_end_render_pass(gpu_ctx);
+    if (ctx->render_pass_started)
+        ngli_gpu_ctx_end_render_pass(gpu_ctx);
 
     ctx->render_pass_started = 0;
     ctx->current_rendertarget = s->prev_rendertarget;
@@ -330,7 +419,93 @@ void ngli_rtt_freep(struct rtt_ctx **sp)
         ngli_texture_freep(&s->ms_colors[i]);
     s->nb_ms_colors = 0;
     ngli_texture_freep(&s->ms_depth);
-    ngli_texture_freep(&s->color);
+    for (size_t i = 0; i < s->nb_owned_colors; i++)
+        ngli_texture_freep(&s->colors[i]);
+    s->nb_owned_colors = 0;
 
     ngli_freep(sp);
 }
+
+struct rtt_ctx *ngli_rtt_pool_acquire(struct ngl_ctx *ctx, const struct texture_params *params, size_t nb_colors)
+{
+    struct rtt_ctx **pool = ngli_darray_data(&ctx->rtt_pool);
+    for (size_t i = 0; i < ngli_darray_count(&ctx->rtt_pool); i++) {
+        struct rtt_ctx *s = pool[i];
+        if (s->pool_in_use || s->nb_owned_colors != nb_colors ||
+            memcmp(&s->pool_params, params, sizeof(*params)))
+            continue;
+        s->pool_in_use = 1;
+        s->pool_idle_frames = 0;
+        return s;
+    }
+
+    struct rtt_ctx *s = ngli_rtt_create(ctx);
+    if (!s)
+        return NULL;
+
+    int ret = ngli_rtt_from_texture_params(s, params, nb_colors);
+    if (ret < 0)
+        goto fail;
+
+    if (!ngli_darray_push(&ctx->rtt_pool, &s))
+        goto fail;
+
+    s->pool_params = *params;
+    s->pool_in_use = 1;
+    return s;
+
+fail:
+    LOG(ERROR, "could not allocate %zu pooled %dx%d render target(s)", nb_colors, params->width, params->height);
+    ngli_rtt_freep(&s);
+    return NULL;
+}
+
+void ngli_rtt_pool_release(struct rtt_ctx **sp)
+{
+    struct rtt_ctx *s = *sp;
+    if (!s)
+        return;
+    ngli_assert(s->pool_in_use && !s->started);
+    s->pool_in_use = 0;
+    *sp = NULL;
+}
+
+void ngli_rtt_pool_trim(struct ngl_ctx *ctx)
+{
+    size_t i = 0;
+    while (i < ngli_darray_count(&ctx->rtt_pool)) {
+        struct rtt_ctx **sp = ngli_darray_get(&ctx->rtt_pool, i);
+        struct rtt_ctx *s = *sp;
+        if (!s->pool_in_use && s->pool_idle_frames++ >= MAX_POOL_IDLE_FRAMES) {
+            ngli_rtt_freep(&s);
+            ngli_darray_remove(&ctx->rtt_pool, i);
+            continue;
+        }
+        i++;
+    }
+
+    /* Drop the shared attachments only referenced by the cache */
+    i = 0;
+    while (i < ngli_darray_count(&ctx->rtt_attachments)) {
+        struct texture **texturep = ngli_darray_get(&ctx->rtt_attachments, i);
+        if ((*texturep)->rc.count == 1) {
+            ngli_texture_freep(texturep);
+            ngli_darray_remove(&ctx->rtt_attachments, i);
+            continue;
+        }
+        i++;
+    }
+}
+
+void ngli_rtt_pool_reset(struct ngl_ctx *ctx)
+{
+    struct rtt_ctx **pool = ngli_darray_data(&ctx->rtt_pool);
+    for (size_t i = 0; i < ngli_darray_count(&ctx->rtt_pool); i++)
+        ngli_rtt_freep(&pool[i]);
+    ngli_darray_clear(&ctx->rtt_pool);
+
+    struct texture **textures = ngli_darray_data(&ctx->rtt_attachments);
+    for (size_t i = 0; i < ngli_darray_count(&ctx->rtt_attachments); i++)
+        ngli_texture_freep(&textures[i]);
+    ngli_darray_clear(&ctx->rtt_attachments);
+}
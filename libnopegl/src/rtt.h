@@ -23,6 +23,7 @@
 #ifndef RTT_H
 #define RTT_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include "gpu_limits.h"
@@ -46,10 +47,25 @@ struct rtt_params {
 
 struct rtt_ctx *ngli_rtt_create(struct ngl_ctx *ctx);
 int ngli_rtt_init(struct rtt_ctx *s, const struct rtt_params *params);
-int ngli_rtt_from_texture_params(struct rtt_ctx *s, const struct texture_params *params);
+int ngli_rtt_from_texture_params(struct rtt_ctx *s, const struct texture_params *params, size_t nb_colors);
 struct texture *ngli_rtt_get_texture(struct rtt_ctx *s, size_t index);
 void ngli_rtt_begin(struct rtt_ctx *s);
 void ngli_rtt_end(struct rtt_ctx *s);
 void ngli_rtt_freep(struct rtt_ctx **sp);
 
+/*
+ * Context pool of rtts owning their color textures, meant for intermediate
+ * render targets which do not need to live outside a single draw. Their
+ * color attachments are not cleared (as with ngli_rtt_from_texture_params()):
+ * the draws are expected to overwrite every pixel. A pooled
+ * rtt must be released with ngli_rtt_pool_release() once its textures have
+ * been consumed, so that other nodes can reuse it within the same frame.
+ * ngli_rtt_pool_trim() is called at the end of every frame and destroys the
+ * pooled rtts which have not been acquired for a few frames.
+ */
+struct rtt_ctx *ngli_rtt_pool_acquire(struct ngl_ctx *ctx, const struct texture_params *params, size_t nb_colors);
+void ngli_rtt_pool_release(struct rtt_ctx **sp);
+void ngli_rtt_pool_trim(struct ngl_ctx *ctx);
+void ngli_rtt_pool_reset(struct ngl_ctx *ctx);
+
 #endif
@@ -31,6 +31,8 @@
 
 NGLI_RC_CHECK_STRUCT(ngl_scene);
 
+extern const struct param_specs ngli_params_specs[];
+
 typedef int (*children_func_type)(void *user_arg, struct ngl_node *parent, struct ngl_node *node);
 
 /*
@@ -283,6 +285,374 @@ static int attach_root(struct ngl_scene *s, struct ngl_node *node)
     return 0;
 }
 
+/*
+ * Structural deduplication
+ *
+ * Nodes of the same class with identical parameters (child nodes being
+ * compared after they have been deduplicated themselves) are merged into a
+ * single instance, which is then shared by all their parents. Only node
+ * classes without side effects are considered: the merged nodes must be
+ * read-only, must not be controllable at runtime, and must not observe or
+ * depend on how many times they are referenced.
+ */
+static const uint32_t dedup_geometry_ids[] = {
+    NGL_NODE_GEOMETRY,
+    NGL_NODE_QUAD,
+    NGL_NODE_TRIANGLE,
+    NGL_NODE_CIRCLE,
+    NGLI_NODE_NONE
+};
+
+static int has_id(const uint32_t *ids, uint32_t id)
+{
+    for (size_t i = 0; ids[i] != NGLI_NODE_NONE; i++)
+        if (ids[i] == id)
+            return 1;
+    return 0;
+}
+
+static int is_static_buffer(const struct ngl_node *node)
+{
+    return node->cls->category == NGLI_NODE_CATEGORY_BUFFER &&
+           node->cls->params_id && !strcmp(node->cls->params_id, "Buffer");
+}
+
+static int can_dedup(const struct ngl_node *node)
+{
+    const struct node_class *cls = node->cls;
+
+    if (cls->flags & NGLI_NODE_FLAG_LIVECTL)
+        return 0;
+
+    const uint8_t *base_ptr = node->opts;
+    const struct node_param *par = cls->params;
+    for (size_t i = 0; par && par[i].key; i++) {
+        if (par[i].flags & NGLI_PARAM_FLAG_ALLOW_LIVE_CHANGE)
+            return 0;
+        /* File paths are tracked (and can be updated) individually */
+        if ((par[i].flags & NGLI_PARAM_FLAG_FILEPATH) && *(char **)(base_ptr + par[i].offset))
+            return 0;
+    }
+
+    switch (cls->id) {
+    case NGL_NODE_PROGRAM:
+    case NGL_NODE_COMPUTEPROGRAM:
+    case NGL_NODE_RESOURCEPROPS:
+    case NGL_NODE_GEOMETRY:
+    case NGL_NODE_QUAD:
+    case NGL_NODE_TRIANGLE:
+    case NGL_NODE_CIRCLE:
+        return 1;
+    }
+
+    if (cls->category == NGLI_NODE_CATEGORY_IO)
+        return 1;
+
+    /*
+     * Buffers can be written by compute shaders when they are exposed as
+     * resources, so they are only merged when they exclusively serve as
+     * geometry attributes.
+     */
+    if (is_static_buffer(node)) {
+        const struct ngl_node **parents = ngli_darray_data(&node->parents);
+        for (size_t i = 0; i < ngli_darray_count(&node->parents); i++)
+            if (!has_id(dedup_geometry_ids, parents[i]->cls->id))
+                return 0;
+        return 1;
+    }
+
+    return 0;
+}
+
+#define FNV_OFFSET 0xcbf29ce484222325ULL
+#define FNV_PRIME  0x100000001b3ULL
+
+static uint64_t hash_bytes(uint64_t h, const void *data, size_t size)
+{
+    const uint8_t *p = data;
+    for (size_t i = 0; i < size; i++) {
+        h ^= p[i];
+        h *= FNV_PRIME;
+    }
+    return h;
+}
+
+static struct ngl_node *get_canon(const struct hmap *canon_map, struct ngl_node *node)
+{
+    if (!node)
+        return NULL;
+    struct ngl_node *canon = ngli_hmap_get_u64(canon_map, (uint64_t)(uintptr_t)node);
+    return canon ? canon : node;
+}
+
+static uint64_t hash_node(const struct hmap *canon_map, const struct ngl_node *node)
+{
+    uint64_t h = hash_bytes(FNV_OFFSET, &node->cls->id, sizeof(node->cls->id));
+
+    const uint8_t *base_ptr = node->opts;
+    const struct node_param *par = node->cls->params;
+    for (size_t i = 0; par && par[i].key; i++) {
+        const uint8_t *parp = base_ptr + par[i].offset;
+        const size_t size = ngli_params_specs[par[i].type].size;
+
+        if (par[i].type == NGLI_PARAM_TYPE_NODE || (par[i].flags & NGLI_PARAM_FLAG_ALLOW_NODE)) {
+            const struct ngl_node *child = get_canon(canon_map, *(struct ngl_node **)parp);
+            h = hash_bytes(h, &child, sizeof(child));
+            if (!child && par[i].type != NGLI_PARAM_TYPE_NODE)
+                h = hash_bytes(h, parp + sizeof(struct ngl_node *), size);
+        } else if (par[i].type == NGLI_PARAM_TYPE_NODELIST) {
+            struct ngl_node **elems = *(struct ngl_node ***)parp;
+            const size_t nb_elems = *(size_t *)(parp + sizeof(struct ngl_node **));
+            h = hash_bytes(h, &nb_elems, sizeof(nb_elems));
+            for (size_t j = 0; j < nb_elems; j++) {
+                const struct ngl_node *child = get_canon(canon_map, elems[j]);
+                h = hash_bytes(h, &child, sizeof(child));
+            }
+        } else if (par[i].type == NGLI_PARAM_TYPE_NODEDICT) {
+            const struct hmap *hmap = *(struct hmap **)parp;
+            const size_t count = hmap ? ngli_hmap_count(hmap) : 0;
+            h = hash_bytes(h, &count, sizeof(count));
+            /* The entries are summed so the hash does not depend on the insertion order */
+            uint64_t entries_h = 0;
+            const struct hmap_entry *entry = NULL;
+            while (hmap && (entry = ngli_hmap_next(hmap, entry))) {
+                const struct ngl_node *child = get_canon(canon_map, entry->data);
+                uint64_t entry_h = hash_bytes(FNV_OFFSET, entry->key.str, strlen(entry->key.str));
+                entries_h += hash_bytes(entry_h, &child, sizeof(child));
+            }
+            h = hash_bytes(h, &entries_h, sizeof(entries_h));
+        } else if (par[i].type == NGLI_PARAM_TYPE_STR) {
+            const char *str = *(char **)parp;
+            h = str ? hash_bytes(h, str, strlen(str) + 1) : hash_bytes(h, "", 0);
+        } else if (par[i].type == NGLI_PARAM_TYPE_DATA || par[i].type == NGLI_PARAM_TYPE_F64LIST) {
+            const void *data = *(void **)parp;
+            const size_t count = *(size_t *)(parp + sizeof(void *));
+            const size_t data_size = par[i].type == NGLI_PARAM_TYPE_F64LIST ? count * sizeof(double) : count;
+            h = hash_bytes(h, &count, sizeof(count));
+            if (data)
+                h = hash_bytes(h, data, data_size);
+        } else {
+            h = hash_bytes(h, parp, size);
+        }
+    }
+
+    return h;
+}
+
+static int nodes_equal(const struct hmap *canon_map, const struct ngl_node *a, const struct ngl_node *b)
+{
+    if (a->cls != b->cls)
+        return 0;
+
+    const uint8_t *base_ptr_a = a->opts;
+    const uint8_t *base_ptr_b = b->opts;
+    const struct node_param *par = a->cls->params;
+    for (size_t i = 0; par && par[i].key; i++) {
+        const uint8_t *pa = base_ptr_a + par[i].offset;
+        const uint8_t *pb = base_ptr_b + par[i].offset;
+        const size_t size = ngli_params_specs[par[i].type].size;
+
+        if (par[i].type == NGLI_PARAM_TYPE_NODE || (par[i].flags & NGLI_PARAM_FLAG_ALLOW_NODE)) {
+            const struct ngl_node *child_a = get_canon(canon_map, *(struct ngl_node **)pa);
+            const struct ngl_node *child_b = get_canon(canon_map, *(struct ngl_node **)pb);
+            if (child_a != child_b)
+                return 0;
+            if (!child_a && par[i].type != NGLI_PARAM_TYPE_NODE &&
+                memcmp(pa + sizeof(struct ngl_node *), pb + sizeof(struct ngl_node *), size))
+                return 0;
+        } else if (par[i].type == NGLI_PARAM_TYPE_NODELIST) {
+            struct ngl_node **elems_a = *(struct ngl_node ***)pa;
+            struct ngl_node **elems_b = *(struct ngl_node ***)pb;
+            const size_t nb_elems_a = *(size_t *)(pa + sizeof(struct ngl_node **));
+            const size_t nb_elems_b = *(size_t *)(pb + sizeof(struct ngl_node **));
+            if (nb_elems_a != nb_elems_b)
+                return 0;
+            for (size_t j = 0; j < nb_elems_a; j++)
+                if (get_canon(canon_map, elems_a[j]) != get_canon(canon_map, elems_b[j]))
+                    return 0;
+        } else if (par[i].type == NGLI_PARAM_TYPE_NODEDICT) {
+            const struct hmap *hmap_a = *(struct hmap **)pa;
+            const struct hmap *hmap_b = *(struct hmap **)pb;
+            const size_t count_a = hmap_a ? ngli_hmap_count(hmap_a) : 0;
+            const size_t count_b = hmap_b ? ngli_hmap_count(hmap_b) : 0;
+            if (count_a != count_b)
+                return 0;
+            const struct hmap_entry *entry = NULL;
+            while (hmap_a && (entry = ngli_hmap_next(hmap_a, entry))) {
+                struct ngl_node *child_b = ngli_hmap_get_str(hmap_b, entry->key.str);
+                if (!child_b || get_canon(canon_map, entry->data) != get_canon(canon_map, child_b))
+                    return 0;
+            }
+        } else if (par[i].type == NGLI_PARAM_TYPE_STR) {
+            const char *str_a = *(char **)pa;
+            const char *str_b = *(char **)pb;
+            if (!str_a != !str_b || (str_a && strcmp(str_a, str_b)))
+                return 0;
+        } else if (par[i].type == NGLI_PARAM_TYPE_DATA || par[i].type == NGLI_PARAM_TYPE_F64LIST) {
+            const void *data_a = *(void **)pa;
+            const void *data_b = *(void **)pb;
+            const size_t count_a = *(size_t *)(pa + sizeof(void *));
+            const size_t count_b = *(size_t *)(pb + sizeof(void *));
+            const size_t data_size = par[i].type == NGLI_PARAM_TYPE_F64LIST ? count_a * sizeof(double) : count_a;
+            if (count_a != count_b || !data_a != !data_b || (data_a && memcmp(data_a, data_b, data_size)))
+                return 0;
+        } else if (memcmp(pa, pb, size)) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+struct dedup_ctx {
+    struct hmap *visited;   // set of the nodes already processed
+    struct hmap *canon_map; // duplicate node -> canonical node
+    struct hmap *by_hash;   // structural hash -> first canonical node seen
+    size_t nb_merged;
+};
+
+static int dedup_node(struct dedup_ctx *ctx, struct ngl_node *node)
+{
+    const uint64_t key = (uint64_t)(uintptr_t)node;
+    if (ngli_hmap_get_u64(ctx->visited, key))
+        return 0;
+    int ret = ngli_hmap_set_u64(ctx->visited, key, node);
+    if (ret < 0)
+        return ret;
+
+    /* Leaves first, so that parents compare canonical children */
+    struct ngl_node **children = ngli_darray_data(&node->children);
+    for (size_t i = 0; i < ngli_darray_count(&node->children); i++) {
+        ret = dedup_node(ctx, children[i]);
+        if (ret < 0)
+            return ret;
+    }
+
+    if (!can_dedup(node))
+        return 0;
+
+    const uint64_t hash = hash_node(ctx->canon_map, node);
+    struct ngl_node *canon = ngli_hmap_get_u64(ctx->by_hash, hash);
+    if (!canon)
+        return ngli_hmap_set_u64(ctx->by_hash, hash, node);
+
+    /* Hash collisions are not resolved: the node is simply kept as is */
+    if (!nodes_equal(ctx->canon_map, canon, node))
+        return 0;
+
+    ret = ngli_hmap_set_u64(ctx->canon_map, key, canon);
+    if (ret < 0)
+        return ret;
+    ctx->nb_merged++;
+    return 0;
+}
+
+static void replace_node(const struct hmap *canon_map, struct ngl_node **nodep)
+{
+    struct ngl_node *canon = get_canon(canon_map, *nodep);
+    if (canon == *nodep)
+        return;
+    ngl_node_ref(canon);
+    ngl_node_unrefp(nodep);
+    *nodep = canon;
+}
+
+static int replace_duplicates(const struct hmap *canon_map, struct ngl_node *node)
+{
+    uint8_t *base_ptr = node->opts;
+    const struct node_param *par = node->cls->params;
+    for (size_t i = 0; par && par[i].key; i++) {
+        uint8_t *parp = base_ptr + par[i].offset;
+
+        if (par[i].type == NGLI_PARAM_TYPE_NODE || (par[i].flags & NGLI_PARAM_FLAG_ALLOW_NODE)) {
+            replace_node(canon_map, (struct ngl_node **)parp);
+        } else if (par[i].type == NGLI_PARAM_TYPE_NODELIST) {
+            struct ngl_node **elems = *(struct ngl_node ***)parp;
+            const size_t nb_elems = *(size_t *)(parp + sizeof(struct ngl_node **));
+            for (size_t j = 0; j < nb_elems; j++)
+                replace_node(canon_map, &elems[j]);
+        } else if (par[i].type == NGLI_PARAM_TYPE_NODEDICT) {
+            struct hmap *hmap = *(struct hmap **)parp;
+            const struct hmap_entry *entry = NULL;
+            while (hmap && (entry = ngli_hmap_next(hmap, entry))) {
+                struct ngl_node *canon = get_canon(canon_map, entry->data);
+                if (canon == entry->data)
+                    continue;
+                /* Replacing an existing key does not reorganize the map */
+                int ret = ngli_hmap_set_str(hmap, entry->key.str, ngl_node_ref(canon));
+                if (ret < 0) {
+                    ngl_node_unrefp(&canon);
+                    return ret;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+static int dedup_scene(struct ngl_scene *s)
+{
+    struct dedup_ctx ctx = {
+        .visited   = ngli_hmap_create(NGLI_HMAP_TYPE_U64),
+        .canon_map = ngli_hmap_create(NGLI_HMAP_TYPE_U64),
+        .by_hash   = ngli_hmap_create(NGLI_HMAP_TYPE_U64),
+    };
+    struct darray nodes_array;
+    ngli_darray_init(&nodes_array, sizeof(struct ngl_node *), 0);
+
+    int ret = 0;
+    if (!ctx.visited || !ctx.canon_map || !ctx.by_hash) {
+        ret = NGL_ERROR_MEMORY;
+        goto end;
+    }
+
+    ret = dedup_node(&ctx, s->params.root);
+    if (ret < 0 || !ctx.nb_merged)
+        goto end;
+
+    /*
+     * Hold a reference on every node of the graph: the duplicates are going
+     * to be released while the parameters are rewritten, but they may still
+     * reference nodes that need to be rewritten as well.
+     */
+    const struct ngl_node **nodes = ngli_darray_data(&s->nodes);
+    for (size_t i = 0; i < ngli_darray_count(&s->nodes); i++) {
+        struct ngl_node *node = ngl_node_ref((struct ngl_node *)nodes[i]);
+        if (!ngli_darray_push(&nodes_array, &node)) {
+            ngl_node_unrefp(&node);
+            ret = NGL_ERROR_MEMORY;
+            goto end;
+        }
+    }
+
+    struct ngl_node *root = ngl_node_ref(s->params.root);
+    detach_root(s);
+
+    struct ngl_node **all_nodes = ngli_darray_data(&nodes_array);
+    for (size_t i = 0; i < ngli_darray_count(&nodes_array); i++) {
+        ret = replace_duplicates(ctx.canon_map, all_nodes[i]);
+        if (ret < 0)
+            break;
+    }
+
+    if (ret >= 0) {
+        LOG(DEBUG, "merged %zu duplicated node(s)", ctx.nb_merged);
+        ret = attach_root(s, root);
+    }
+    ngl_node_unrefp(&root);
+
+end:
+    for (size_t i = 0; i < ngli_darray_count(&nodes_array); i++) {
+        struct ngl_node **nodep = ngli_darray_get(&nodes_array, i);
+        ngl_node_unrefp(nodep);
+    }
+    ngli_darray_reset(&nodes_array);
+    ngli_hmap_freep(&ctx.visited);
+    ngli_hmap_freep(&ctx.canon_map);
+    ngli_hmap_freep(&ctx.by_hash);
+    return ret;
+}
+
 int ngl_scene_get_filepaths(struct ngl_scene *s, char ***filepathsp, size_t *nb_filepathsp)
 {
     *filepathsp = NULL;
@@ -342,12 +712,23 @@ int ngl_scene_update_filepath(struct ngl_scene *s, size_t index, const char *fil
     return 0;
 }
 
+static void reset_changes(struct ngl_scene *s)
+{
+    struct param_change **changes = ngli_darray_data(&s->changes);
+    for (size_t i = 0; i < ngli_darray_count(&s->changes); i++)
+        ngli_node_param_change_freep(&changes[i]);
+    ngli_darray_clear(&s->changes);
+    ngli_hmap_freep(&s->changes_map);
+}
+
 static void scene_freep(struct ngl_scene **sp)
 {
     struct ngl_scene *s = *sp;
     if (!s)
         return;
     detach_root(s);
+    reset_changes(s);
+    ngli_darray_reset(&s->changes);
     ngli_freep(sp);
 }
 
@@ -357,6 +738,7 @@ struct ngl_scene *ngl_scene_create(void)
     if (!s)
         return NULL;
     s->rc = NGLI_RC_CREATE(scene_freep);
+    ngli_darray_init(&s->changes, sizeof(struct param_change *), 0);
     return s;
 }
 
@@ -402,7 +784,44 @@ int ngl_scene_init(struct ngl_scene *s, const struct ngl_scene_params *params)
 
     detach_root(s);
     s->params = *params;
-    return attach_root(s, s->params.root);
+    int ret = attach_root(s, s->params.root);
+    if (ret < 0)
+        return ret;
+
+    if (s->params.dedup) {
+        ret = dedup_scene(s);
+        if (ret < 0)
+            return ret;
+    }
+
+    return 0;
+}
+
+int ngl_scene_begin_changes(struct ngl_scene *s)
+{
+    if (s->changes_started) {
+        LOG(ERROR, "a batch of changes is already started on this scene");
+        return NGL_ERROR_INVALID_USAGE;
+    }
+    s->changes_map = ngli_hmap_create(NGLI_HMAP_TYPE_U64);
+    if (!s->changes_map)
+        return NGL_ERROR_MEMORY;
+    s->changes_started = 1;
+    return 0;
+}
+
+int ngl_scene_commit_changes(struct ngl_scene *s)
+{
+    if (!s->changes_started) {
+        LOG(ERROR, "no batch of changes started on this scene");
+        return NGL_ERROR_INVALID_USAGE;
+    }
+    s->changes_started = 0;
+
+    struct param_change **changes = ngli_darray_data(&s->changes);
+    int ret = ngli_node_commit_changes(s, changes, ngli_darray_count(&s->changes));
+    reset_changes(s);
+    return ret;
 }
 
 int ngl_scene_init_from_str(struct ngl_scene *s, const char *str)
@@ -420,6 +839,11 @@ char *ngl_scene_serialize(const struct ngl_scene *s)
     return ngli_scene_serialize(s);
 }
 
+int ngl_scene_serialize_fd(const struct ngl_scene *s, int fd)
+{
+    return ngli_scene_serialize_fd(s, fd);
+}
+
 char *ngl_scene_dot(const struct ngl_scene *s)
 {
     return ngli_scene_dot(s);
@@ -19,10 +19,17 @@
  * under the License.
  */
 
+#include <errno.h>
 #include <inttypes.h>
+#include <limits.h>
 #include <string.h>
 
-#include "bstr.h"
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
 #include "darray.h"
 #include "hmap.h"
 #include "log.h"
@@ -33,38 +40,196 @@
 
 extern const struct node_param ngli_base_node_params[];
 
-static void free_func(void *arg, void *data)
+#define WRITER_BUFSIZE (64 * 1024)
+
+/*
+ * Output buffer: the content is either accumulated in a growing buffer
+ * (string output), or flushed to a file descriptor every time it is full.
+ */
+struct writer {
+    char *buf;
+    size_t len;
+    size_t size;
+    int fd;
+    int ret;
+};
+
+static int writer_flush(struct writer *w)
 {
-    ngli_free(data);
+    size_t pos = 0;
+    while (pos < w->len) {
+#ifdef _WIN32
+        const int n = _write(w->fd, w->buf + pos, (unsigned)NGLI_MIN(w->len - pos, INT_MAX));
+#else
+        const ssize_t n = write(w->fd, w->buf + pos, w->len - pos);
+#endif
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            LOG(ERROR, "unable to write serialized scene: %s", strerror(errno));
+            return NGL_ERROR_IO;
+        }
+        pos += (size_t)n;
+    }
+    w->len = 0;
+    return 0;
 }
 
-static int register_node(struct hmap *nlist,
-                          const struct ngl_node *node)
+/* Make sure at least n bytes are available, return NULL on error */
+static char *writer_reserve(struct writer *w, size_t n)
 {
-    const uint64_t key = (uint64_t)(uintptr_t)node;
-    char *val = ngli_asprintf("%zx", ngli_hmap_count(nlist));
-    if (!val)
+    if (w->ret < 0)
+        return NULL;
+
+    if (w->size - w->len >= n)
+        return w->buf + w->len;
+
+    if (w->fd >= 0) {
+        w->ret = writer_flush(w);
+        if (w->ret < 0)
+            return NULL;
+        if (w->size >= n)
+            return w->buf;
+    }
+
+    size_t new_size = w->size;
+    while (new_size - w->len < n)
+        new_size *= 2;
+    char *buf = ngli_realloc(w->buf, new_size, 1);
+    if (!buf) {
+        w->ret = NGL_ERROR_MEMORY;
+        return NULL;
+    }
+    w->buf = buf;
+    w->size = new_size;
+    return w->buf + w->len;
+}
+
+static void write_buf(struct writer *w, const char *str, size_t len)
+{
+    char *dst = writer_reserve(w, len);
+    if (!dst)
+        return;
+    memcpy(dst, str, len);
+    w->len += len;
+}
+
+static void write_str(struct writer *w, const char *str)
+{
+    write_buf(w, str, strlen(str));
+}
+
+static void write_chr(struct writer *w, char c)
+{
+    char *dst = writer_reserve(w, 1);
+    if (!dst)
+        return;
+    *dst = c;
+    w->len++;
+}
+
+static const char hex_lower[] = "0123456789abcdef";
+static const char hex_upper[] = "0123456789ABCDEF";
+
+static void write_hex(struct writer *w, uint64_t v, const char *digits)
+{
+    char tmp[16];
+    size_t n = 0;
+    do {
+        tmp[sizeof(tmp) - ++n] = digits[v & 0xf];
+        v >>= 4;
+    } while (v);
+    write_buf(w, tmp + sizeof(tmp) - n, n);
+}
+
+static void write_u64(struct writer *w, uint64_t v)
+{
+    char tmp[20];
+    size_t n = 0;
+    do {
+        tmp[sizeof(tmp) - ++n] = (char)('0' + v % 10);
+        v /= 10;
+    } while (v);
+    write_buf(w, tmp + sizeof(tmp) - n, n);
+}
+
+static void write_i64(struct writer *w, int64_t v)
+{
+    if (v < 0) {
+        write_chr(w, '-');
+        write_u64(w, -(uint64_t)v);
+    } else {
+        write_u64(w, (uint64_t)v);
+    }
+}
+
+static void write_key(struct writer *w, const char *key)
+{
+    write_chr(w, ' ');
+    write_str(w, key);
+    write_chr(w, ':');
+}
+
+/*
+ * Node ids are assigned in serialization order (0 meaning not serialized
+ * yet). The map from the nodes to their id slot is built once from the scene
+ * node set, so that the nodes themselves are left untouched.
+ */
+struct node_ids {
+    struct hmap *slots; // node pointer -> size_t * in ids
+    size_t *ids;
+    size_t nb_ids;
+};
+
+static int node_ids_init(struct node_ids *nids, const struct ngl_scene *s)
+{
+    const size_t nb_nodes = ngli_darray_count(&s->nodes);
+    nids->ids = ngli_calloc(nb_nodes ? nb_nodes : 1, sizeof(*nids->ids));
+    nids->slots = ngli_hmap_create(NGLI_HMAP_TYPE_U64);
+    if (!nids->ids || !nids->slots)
         return NGL_ERROR_MEMORY;
-    int ret = ngli_hmap_set_u64(nlist, key, val);
-    if (ret < 0)
-        ngli_free(val);
-    return ret;
+
+    struct ngl_node **nodes = ngli_darray_data(&s->nodes);
+    for (size_t i = 0; i < nb_nodes; i++) {
+        int ret = ngli_hmap_set_u64(nids->slots, (uint64_t)(uintptr_t)nodes[i], &nids->ids[i]);
+        if (ret < 0)
+            return ret;
+    }
+    return 0;
+}
+
+static void node_ids_reset(struct node_ids *nids)
+{
+    ngli_hmap_freep(&nids->slots);
+    ngli_freep(&nids->ids);
+}
+
+static size_t *get_node_id_slot(const struct node_ids *nids, const struct ngl_node *node)
+{
+    size_t *slot = ngli_hmap_get_u64(nids->slots, (uint64_t)(uintptr_t)node);
+    ngli_assert(slot);
+    return slot;
+}
+
+static void register_node(struct node_ids *nids, const struct ngl_node *node)
+{
+    *get_node_id_slot(nids, node) = ++nids->nb_ids;
 }
 
-static int get_node_id(const struct hmap *nlist, const struct ngl_node *node)
+static int is_node_registered(const struct node_ids *nids, const struct ngl_node *node)
 {
-    const uint64_t key = (uint64_t)(uintptr_t)node;
-    const char *val = ngli_hmap_get_u64(nlist, key);
-    return val ? (int)strtol(val, NULL, 16) : -1;
+    return *get_node_id_slot(nids, node) != 0;
 }
 
-static int get_rel_node_id(const struct hmap *nlist, const struct ngl_node *node)
+static size_t get_rel_node_id(const struct node_ids *nids, const struct ngl_node *node)
 {
-    return (int)ngli_hmap_count(nlist) - get_node_id(nlist, node);
+    const size_t id = *get_node_id_slot(nids, node);
+    ngli_assert(id);
+    return nids->nb_ids + 1 - id;
 }
 
 #define DECLARE_FLT_PRINT_FUNC(type, nbit, shift_exp, z)                \
-static void print_f##nbit(struct bstr *b, type f)                       \
+static void print_f##nbit(struct writer *w, type f)                     \
 {                                                                       \
     const union { uint##nbit##_t i; type f; } u = {.f = f};             \
     const uint##nbit##_t v = u.i;                                       \
@@ -72,22 +237,26 @@ static void print_f##nbit(struct bstr *b, type f)                       \
     const uint##nbit##_t exp_mask = (1 << (nbit - shift_exp - 1)) - 1;  \
     const uint##nbit##_t exp  = v >> shift_exp & exp_mask;              \
     const uint##nbit##_t mant = v & ((1ULL << shift_exp) - 1);          \
-    ngli_bstr_printf(b, "%s%" PRIX##nbit "%c%" PRIX##nbit,              \
-                    sign ? "-" : "", exp, z, mant);                     \
+    if (sign)                                                           \
+        write_chr(w, '-');                                              \
+    write_hex(w, exp, hex_upper);                                       \
+    write_chr(w, z);                                                    \
+    write_hex(w, mant, hex_upper);                                      \
 }                                                                       \
 
 DECLARE_FLT_PRINT_FUNC(float,  32, 23, 'z')
 DECLARE_FLT_PRINT_FUNC(double, 64, 52, 'Z')
 
-#define print_i32(b, v) ngli_bstr_printf(b, "%d", v)
-#define print_u32(b, v) ngli_bstr_printf(b, "%u", v)
+#define print_i32(w, v) write_i64(w, v)
+#define print_u32(w, v) write_u64(w, v)
 
 #define DECLARE_PRINT_FUNC(name, type)                                  \
-static void print_##name##s(struct bstr *b, size_t n, const type *v)    \
+static void print_##name##s(struct writer *w, size_t n, const type *v)  \
 {                                                                       \
     for (size_t i = 0; i < n; i++) {                                    \
-        ngli_bstr_printf(b, "%s", i ? "," : "");                        \
-        print_##name(b, v[i]);                                          \
+        if (i)                                                          \
+            write_chr(w, ',');                                          \
+        print_##name(w, v[i]);                                          \
     }                                                                   \
 }
 
@@ -124,16 +293,18 @@ static int hmap_to_sorted_items(struct darray *items_array, struct hmap *hm)
     return 0;
 }
 
-static void serialize_select(struct bstr *b, const uint8_t *srcp, const struct node_param *par)
+static void serialize_select(struct writer *w, const uint8_t *srcp, const struct node_param *par)
 {
     const int v = *(int *)srcp;
     const char *s = ngli_params_get_select_str(par->choices->consts, v);
     ngli_assert(s);
-    if (v != par->def_value.i32)
-        ngli_bstr_printf(b, " %s:%s", par->key, s);
+    if (v != par->def_value.i32) {
+        write_key(w, par->key);
+        write_str(w, s);
+    }
 }
 
-static int serialize_flags(struct bstr *b, const uint8_t *srcp, const struct node_param *par)
+static int serialize_flags(struct writer *w, const uint8_t *srcp, const struct node_param *par)
 {
     const int v = *(int *)srcp;
     char *s = ngli_params_get_flags_str(par->choices->consts, v);
@@ -142,52 +313,62 @@ static int serialize_flags(struct bstr *b, const uint8_t *srcp, const struct nod
         return NGL_ERROR_MEMORY;
     }
     ngli_assert(*s);
-    if (v != par->def_value.i32)
-        ngli_bstr_printf(b, " %s:%s", par->key, s);
+    if (v != par->def_value.i32) {
+        write_key(w, par->key);
+        write_str(w, s);
+    }
     ngli_free(s);
     return 0;
 }
 
-static void serialize_i32(struct bstr *b, const uint8_t *srcp, const struct node_param *par)
+static void serialize_i32(struct writer *w, const uint8_t *srcp, const struct node_param *par)
 {
     const int v = *(int *)srcp;
-    if (v != par->def_value.i32)
-        ngli_bstr_printf(b, " %s:%d", par->key, v);
+    if (v != par->def_value.i32) {
+        write_key(w, par->key);
+        print_i32(w, v);
+    }
 }
 
-static void serialize_u32(struct bstr *b, const uint8_t *srcp, const struct node_param *par)
+static void serialize_u32(struct writer *w, const uint8_t *srcp, const struct node_param *par)
 {
-    const int v = *(int *)srcp;
-    if (v != par->def_value.u32)
-        ngli_bstr_printf(b, " %s:%u", par->key, v);
+    const uint32_t v = *(uint32_t *)srcp;
+    if (v != par->def_value.u32) {
+        write_key(w, par->key);
+        print_u32(w, v);
+    }
 }
 
-static void serialize_f32(struct bstr *b, const uint8_t *srcp, const struct node_param *par)
+static void serialize_f32(struct writer *w, const uint8_t *srcp, const struct node_param *par)
 {
     const float v = *(float *)srcp;
     if (v != par->def_value.f32) {
-        ngli_bstr_printf(b, " %s:", par->key);
-        print_f32(b, v);
+        write_key(w, par->key);
+        print_f32(w, v);
     }
 }
 
-static void serialize_f64(struct bstr *b, const uint8_t *srcp, const struct node_param *par)
+static void serialize_f64(struct writer *w, const uint8_t *srcp, const struct node_param *par)
 {
     const double v = *(double *)srcp;
     if (v != par->def_value.f64) {
-        ngli_bstr_printf(b, " %s:", par->key);
-        print_f64(b, v);
+        write_key(w, par->key);
+        print_f64(w, v);
     }
 }
 
-static void serialize_rational(struct bstr *b, const uint8_t *srcp, const struct node_param *par)
+static void serialize_rational(struct writer *w, const uint8_t *srcp, const struct node_param *par)
 {
     const int *r = (int *)srcp;
-    if (memcmp(r, par->def_value.r, sizeof(par->def_value.r)))
-        ngli_bstr_printf(b, " %s:%d/%d", par->key, r[0], r[1]);
+    if (memcmp(r, par->def_value.r, sizeof(par->def_value.r))) {
+        write_key(w, par->key);
+        print_i32(w, r[0]);
+        write_chr(w, '/');
+        print_i32(w, r[1]);
+    }
 }
 
-static void serialize_str(struct bstr *b, const uint8_t *srcp,
+static void serialize_str(struct writer *w, const uint8_t *srcp,
                           const struct node_param *par, const char *label)
 {
     const char *s = *(char **)srcp;
@@ -195,89 +376,109 @@ static void serialize_str(struct bstr *b, const uint8_t *srcp,
         return;
     if (!strcmp(par->key, "label") && ngli_is_default_label(label, s))
         return;
-    ngli_bstr_printf(b, " %s:", par->key);
-    for (size_t i = 0; s[i]; i++)
-        if (s[i] >= '!' && s[i] <= '~' && s[i] != '%')
-            ngli_bstr_printf(b, "%c", s[i]);
-        else
-            ngli_bstr_printf(b, "%%%02x", s[i] & 0xff);
+    write_key(w, par->key);
+    for (size_t i = 0; s[i]; i++) {
+        if (s[i] >= '!' && s[i] <= '~' && s[i] != '%') {
+            write_chr(w, s[i]);
+        } else {
+            const char esc[] = {'%', hex_lower[(s[i] >> 4) & 0xf], hex_lower[s[i] & 0xf]};
+            write_buf(w, esc, sizeof(esc));
+        }
+    }
 }
 
-static void serialize_data(struct bstr *b, const uint8_t *srcp, const struct node_param *par)
+static void serialize_data(struct writer *w, const uint8_t *srcp, const struct node_param *par)
 {
     const uint8_t *data = *(uint8_t **)srcp;
     const size_t size = *(size_t *)(srcp + sizeof(uint8_t *));
     if (!data || !size)
         return;
-    ngli_bstr_printf(b, " %s:%zu,", par->key, size);
-    for (size_t i = 0; i < size; i++)
-        ngli_bstr_printf(b, "%02x", data[i]);
+    write_key(w, par->key);
+    write_u64(w, size);
+    write_chr(w, ',');
+
+    /* Encode the data by chunks directly into the output buffer */
+    size_t pos = 0;
+    while (pos < size) {
+        const size_t chunk = NGLI_MIN(size - pos, WRITER_BUFSIZE / 2);
+        char *dst = writer_reserve(w, chunk * 2);
+        if (!dst)
+            return;
+        for (size_t i = 0; i < chunk; i++) {
+            const uint8_t v = data[pos + i];
+            dst[i * 2]     = hex_lower[v >> 4];
+            dst[i * 2 + 1] = hex_lower[v & 0xf];
+        }
+        w->len += chunk * 2;
+        pos += chunk;
+    }
 }
 
-static void serialize_ivec(struct bstr *b, const uint8_t *srcp, const struct node_param *par)
+static void serialize_ivec(struct writer *w, const uint8_t *srcp, const struct node_param *par)
 {
     const int32_t *iv = (const int *)srcp;
     const int n = par->type - NGLI_PARAM_TYPE_IVEC2 + 2;
     if (memcmp(iv, par->def_value.ivec, n * sizeof(*iv))) {
-        ngli_bstr_printf(b, " %s:", par->key);
-        print_i32s(b, n, iv);
+        write_key(w, par->key);
+        print_i32s(w, n, iv);
     }
 }
 
-static void serialize_uvec(struct bstr *b, const uint8_t *srcp, const struct node_param *par)
+static void serialize_uvec(struct writer *w, const uint8_t *srcp, const struct node_param *par)
 {
     const uint32_t *uv = (const uint32_t *)srcp;
     const int n = par->type - NGLI_PARAM_TYPE_UVEC2 + 2;
     if (memcmp(uv, par->def_value.uvec, n * sizeof(*uv))) {
-        ngli_bstr_printf(b, " %s:", par->key);
-        print_u32s(b, n, uv);
+        write_key(w, par->key);
+        print_u32s(w, n, uv);
     }
 }
 
-static void serialize_vec(struct bstr *b, const uint8_t *srcp, const struct node_param *par)
+static void serialize_vec(struct writer *w, const uint8_t *srcp, const struct node_param *par)
 {
     const float *v = (float *)srcp;
     const int n = par->type - NGLI_PARAM_TYPE_VEC2 + 2;
     if (memcmp(v, par->def_value.vec, n * sizeof(*v))) {
-        ngli_bstr_printf(b, " %s:", par->key);
-        print_f32s(b, n, v);
+        write_key(w, par->key);
+        print_f32s(w, n, v);
     }
 }
 
-static void serialize_mat4(struct bstr *b, const uint8_t *srcp, const struct node_param *par)
+static void serialize_mat4(struct writer *w, const uint8_t *srcp, const struct node_param *par)
 {
     const float *m = (float *)srcp;
     if (memcmp(m, par->def_value.mat, 16 * sizeof(*m))) {
-        ngli_bstr_printf(b, " %s:", par->key);
-        print_f32s(b, 16, m);
+        write_key(w, par->key);
+        print_f32s(w, 16, m);
     }
 }
 
-static void serialize_node(struct bstr *b, const uint8_t *srcp,
-                           const struct node_param *par, struct hmap *nlist)
+static void serialize_node(struct writer *w, const uint8_t *srcp,
+                           const struct node_param *par, const struct node_ids *nids)
 {
     const struct ngl_node *node = *(struct ngl_node **)srcp;
     if (!node)
         return;
-    const int node_id = get_rel_node_id(nlist, node);
-    ngli_bstr_printf(b, " %s:%x", par->key, node_id);
+    write_key(w, par->key);
+    write_hex(w, get_rel_node_id(nids, node), hex_lower);
 }
 
-static void serialize_nodelist(struct bstr *b, const uint8_t *srcp,
-                               const struct node_param *par, struct hmap *nlist)
+static void serialize_nodelist(struct writer *w, const uint8_t *srcp,
+                               const struct node_param *par, const struct node_ids *nids)
 {
     struct ngl_node **nodes = *(struct ngl_node ***)srcp;
     const size_t nb_nodes = *(size_t *)(srcp + sizeof(struct ngl_node **));
     if (!nb_nodes)
         return;
-    ngli_bstr_printf(b, " %s:", par->key);
+    write_key(w, par->key);
     for (size_t i = 0; i < nb_nodes; i++) {
-        const int node_id = get_rel_node_id(nlist, nodes[i]);
-        ngli_bstr_printf(b, "%s%x", i ? "," : "", node_id);
+        if (i)
+            write_chr(w, ',');
+        write_hex(w, get_rel_node_id(nids, nodes[i]), hex_lower);
     }
 }
 
-static void serialize_f64list(struct bstr *b, const uint8_t *srcp, const struct node_param *par)
+static void serialize_f64list(struct writer *w, const uint8_t *srcp, const struct node_param *par)
 {
     const uint8_t *elems_p = srcp;
     const uint8_t *nb_elems_p = srcp + sizeof(double *);
@@ -285,18 +486,18 @@ static void serialize_f64list(struct bstr *b, const uint8_t *srcp, const struct
     const size_t nb_elems = *(size_t *)nb_elems_p;
     if (!nb_elems)
         return;
-    ngli_bstr_printf(b, " %s:", par->key);
-    print_f64s(b, nb_elems, elems);
+    write_key(w, par->key);
+    print_f64s(w, nb_elems, elems);
 }
 
-static int serialize_nodedict(struct bstr *b, const uint8_t *srcp,
-                              const struct node_param *par, struct hmap *nlist)
+static int serialize_nodedict(struct writer *w, const uint8_t *srcp,
+                              const struct node_param *par, const struct node_ids *nids)
 {
     struct hmap *hmap = *(struct hmap **)srcp;
     const size_t nb_nodes = hmap ? ngli_hmap_count(hmap) : 0;
     if (!nb_nodes)
         return 0;
-    ngli_bstr_printf(b, " %s:", par->key);
+    write_key(w, par->key);
 
     struct darray items_array;
     ngli_darray_init(&items_array, sizeof(struct item), 0);
@@ -308,15 +509,18 @@ static int serialize_nodedict(struct bstr *b, const uint8_t *srcp,
     const struct item *items = ngli_darray_data(&items_array);
     for (size_t i = 0; i < ngli_darray_count(&items_array); i++) {
         const struct item *item = &items[i];
-        const int node_id = get_rel_node_id(nlist, item->data);
-        ngli_bstr_printf(b, "%s%s=%x", i ? "," : "", item->key, node_id);
+        if (i)
+            write_chr(w, ',');
+        write_str(w, item->key);
+        write_chr(w, '=');
+        write_hex(w, get_rel_node_id(nids, item->data), hex_lower);
     }
     ngli_darray_reset(&items_array);
     return 0;
 }
 
-static int serialize_options(struct hmap *nlist,
-                             struct bstr *b,
+static int serialize_options(const struct node_ids *nids,
+                             struct writer *w,
                              const struct ngl_node *node,
                              uint8_t *priv,
                              const struct node_param *p)
@@ -331,8 +535,9 @@ static int serialize_options(struct hmap *nlist,
         if (p->flags & NGLI_PARAM_FLAG_ALLOW_NODE) {
             struct ngl_node *src_node = *(struct ngl_node **)srcp;
             if (src_node) {
-                const int node_id = get_rel_node_id(nlist, src_node);
-                ngli_bstr_printf(b, " %s:!%x", p->key, node_id);
+                write_key(w, p->key);
+                write_chr(w, '!');
+                write_hex(w, get_rel_node_id(nids, src_node), hex_lower);
                 p++;
                 continue;
             }
@@ -341,30 +546,30 @@ static int serialize_options(struct hmap *nlist,
 
         int ret = 0;
         switch (p->type) {
-        case NGLI_PARAM_TYPE_SELECT:    serialize_select(b, srcp, p);                   break;
-        case NGLI_PARAM_TYPE_FLAGS:     ret = serialize_flags(b, srcp, p);              break;
+        case NGLI_PARAM_TYPE_SELECT:    serialize_select(w, srcp, p);                   break;
+        case NGLI_PARAM_TYPE_FLAGS:     ret = serialize_flags(w, srcp, p);              break;
         case NGLI_PARAM_TYPE_BOOL:
-        case NGLI_PARAM_TYPE_I32:       serialize_i32(b, srcp, p);                      break;
-        case NGLI_PARAM_TYPE_U32:       serialize_u32(b, srcp, p);                      break;
-        case NGLI_PARAM_TYPE_F32:       serialize_f32(b, srcp, p);                      break;
-        case NGLI_PARAM_TYPE_F64:       serialize_f64(b, srcp, p);                      break;
-        case NGLI_PARAM_TYPE_RATIONAL:  serialize_rational(b, srcp, p);                 break;
-        case NGLI_PARAM_TYPE_STR:       serialize_str(b, srcp, p, label);               break;
-        case NGLI_PARAM_TYPE_DATA:      serialize_data(b, srcp, p);                     break;
+        case NGLI_PARAM_TYPE_I32:       serialize_i32(w, srcp, p);                      break;
+        case NGLI_PARAM_TYPE_U32:       serialize_u32(w, srcp, p);                      break;
+        case NGLI_PARAM_TYPE_F32:       serialize_f32(w, srcp, p);                      break;
+        case NGLI_PARAM_TYPE_F64:       serialize_f64(w, srcp, p);                      break;
+        case NGLI_PARAM_TYPE_RATIONAL:  serialize_rational(w, srcp, p);                 break;
+        case NGLI_PARAM_TYPE_STR:       serialize_str(w, srcp, p, label);               break;
+        case NGLI_PARAM_TYPE_DATA:      serialize_data(w, srcp, p);                     break;
         case NGLI_PARAM_TYPE_IVEC2:
         case NGLI_PARAM_TYPE_IVEC3:
-        case NGLI_PARAM_TYPE_IVEC4:     serialize_ivec(b, srcp, p);                     break;
+        case NGLI_PARAM_TYPE_IVEC4:     serialize_ivec(w, srcp, p);                     break;
         case NGLI_PARAM_TYPE_UVEC2:
         case NGLI_PARAM_TYPE_UVEC3:
-        case NGLI_PARAM_TYPE_UVEC4:     serialize_uvec(b, srcp, p);                     break;
+        case NGLI_PARAM_TYPE_UVEC4:     serialize_uvec(w, srcp, p);                     break;
         case NGLI_PARAM_TYPE_VEC2:
         case NGLI_PARAM_TYPE_VEC3:
-        case NGLI_PARAM_TYPE_VEC4:      serialize_vec(b, srcp, p);                      break;
-        case NGLI_PARAM_TYPE_MAT4:      serialize_mat4(b, srcp, p);                     break;
-        case NGLI_PARAM_TYPE_NODE:      serialize_node(b, srcp, p, nlist);              break;
-        case NGLI_PARAM_TYPE_NODELIST:  serialize_nodelist(b, srcp, p, nlist);          break;
-        case NGLI_PARAM_TYPE_F64LIST:   serialize_f64list(b, srcp, p);                  break;
-        case NGLI_PARAM_TYPE_NODEDICT:  ret = serialize_nodedict(b, srcp, p, nlist);    break;
+        case NGLI_PARAM_TYPE_VEC4:      serialize_vec(w, srcp, p);                      break;
+        case NGLI_PARAM_TYPE_MAT4:      serialize_mat4(w, srcp, p);                     break;
+        case NGLI_PARAM_TYPE_NODE:      serialize_node(w, srcp, p, nids);               break;
+        case NGLI_PARAM_TYPE_NODELIST:  serialize_nodelist(w, srcp, p, nids);           break;
+        case NGLI_PARAM_TYPE_F64LIST:   serialize_f64list(w, srcp, p);                  break;
+        case NGLI_PARAM_TYPE_NODEDICT:  ret = serialize_nodedict(w, srcp, p, nids);     break;
         default:
             LOG(ERROR, "cannot serialize %s: unsupported parameter type", p->key);
             return NGL_ERROR_BUG;
@@ -373,15 +578,15 @@ static int serialize_options(struct hmap *nlist,
             return ret;
         p++;
     }
-    return 0;
+    return w->ret;
 }
 
-static int serialize(struct hmap *nlist,
-                     struct bstr *b,
-                     const struct ngl_node *node);
+static int serialize(struct node_ids *nids,
+                     struct writer *w,
+                     struct ngl_node *node);
 
-static int serialize_children(struct hmap *nlist,
-                               struct bstr *b,
+static int serialize_children(struct node_ids *nids,
+                               struct writer *w,
                                const struct ngl_node *node,
                                uint8_t *priv,
                                const struct node_param *p)
@@ -394,9 +599,9 @@ static int serialize_children(struct hmap *nlist,
 
         switch (p->type) {
             case NGLI_PARAM_TYPE_NODE: {
-                const struct ngl_node *child = *(struct ngl_node **)srcp;
+                struct ngl_node *child = *(struct ngl_node **)srcp;
                 if (child) {
-                    int ret = serialize(nlist, b, child);
+                    int ret = serialize(nids, w, child);
                     if (ret < 0)
                         return ret;
                 }
@@ -407,7 +612,7 @@ static int serialize_children(struct hmap *nlist,
                 const size_t nb_children = *(size_t *)(srcp + sizeof(struct ngl_node **));
 
                 for (size_t i = 0; i < nb_children; i++) {
-                    int ret = serialize(nlist, b, children[i]);
+                    int ret = serialize(nids, w, children[i]);
                     if (ret < 0)
                         return ret;
                 }
@@ -428,7 +633,7 @@ static int serialize_children(struct hmap *nlist,
                 const struct item *items = ngli_darray_data(&items_array);
                 for (size_t i = 0; i < ngli_darray_count(&items_array); i++) {
                     const struct item *item = &items[i];
-                    int ret = serialize(nlist, b, item->data);
+                    int ret = serialize(nids, w, item->data);
                     if (ret < 0) {
                         ngli_darray_reset(&items_array);
                         return ret;
@@ -442,7 +647,7 @@ static int serialize_children(struct hmap *nlist,
                     break;
                 struct ngl_node *child = *(struct ngl_node **)srcp;
                 if (child) {
-                    int ret = serialize(nlist, b, child);
+                    int ret = serialize(nids, w, child);
                     if (ret < 0)
                         return ret;
                 }
@@ -454,61 +659,119 @@ static int serialize_children(struct hmap *nlist,
     return 0;
 }
 
-static int serialize(struct hmap *nlist,
-                     struct bstr *b,
-                     const struct ngl_node *node)
+static int serialize(struct node_ids *nids,
+                     struct writer *w,
+                     struct ngl_node *node)
 {
-    if (get_node_id(nlist, node) >= 0)
+    if (is_node_registered(nids, node))
         return 0;
 
     int ret;
 
-    if ((ret = serialize_children(nlist, b, node, (uint8_t *)node, ngli_base_node_params)) < 0 ||
-        (ret = serialize_children(nlist, b, node, node->opts, node->cls->params)) < 0)
+    if ((ret = serialize_children(nids, w, node, (uint8_t *)node, ngli_base_node_params)) < 0 ||
+        (ret = serialize_children(nids, w, node, node->opts, node->cls->params)) < 0)
         return ret;
 
     const uint32_t tag = node->cls->id;
-    ngli_bstr_printf(b, "%c%c%c%c",
-                    tag >> 24 & 0xff,
-                    tag >> 16 & 0xff,
-                    tag >>  8 & 0xff,
-                    tag       & 0xff);
-    if ((ret = serialize_options(nlist, b, node, node->opts, node->cls->params)) < 0 ||
-        (ret = serialize_options(nlist, b, node, (uint8_t *)node, ngli_base_node_params)) < 0)
+    const char tag_str[] = {
+        (char)(tag >> 24 & 0xff),
+        (char)(tag >> 16 & 0xff),
+        (char)(tag >>  8 & 0xff),
+        (char)(tag       & 0xff),
+    };
+    write_buf(w, tag_str, sizeof(tag_str));
+    if ((ret = serialize_options(nids, w, node, node->opts, node->cls->params)) < 0 ||
+        (ret = serialize_options(nids, w, node, (uint8_t *)node, ngli_base_node_params)) < 0)
         return ret;
 
-    ngli_bstr_print(b, "\n");
+    write_chr(w, '\n');
+    if (w->ret < 0)
+        return w->ret;
 
-    return register_node(nlist, node);
+    register_node(nids, node);
+    return 0;
 }
 
-char *ngli_scene_serialize(const struct ngl_scene *s)
+static int serialize_scene(const struct ngl_scene *s, struct writer *w)
 {
-    char *str = NULL;
-    struct hmap *nlist = ngli_hmap_create(NGLI_HMAP_TYPE_U64);
-    struct bstr *b = ngli_bstr_create();
-    if (!nlist || !b)
+    struct node_ids nids = {0};
+    int ret = node_ids_init(&nids, s);
+    if (ret < 0)
         goto end;
 
     /* Write header */
-    ngli_hmap_set_free_func(nlist, free_func, NULL);
-    ngli_bstr_printf(b, "# Nope.GL v%d.%d.%d\n",
-                    NGL_VERSION_MAJOR, NGL_VERSION_MINOR, NGL_VERSION_MICRO);
+    write_str(w, "# Nope.GL v");
+    write_u64(w, NGL_VERSION_MAJOR);
+    write_chr(w, '.');
+    write_u64(w, NGL_VERSION_MINOR);
+    write_chr(w, '.');
+    write_u64(w, NGL_VERSION_MICRO);
+    write_chr(w, '\n');
 
     /* Write metadata */
-    ngli_bstr_printf(b, "# duration=");
-    print_f64(b, s->params.duration);
-    ngli_bstr_print(b, "\n");
-    ngli_bstr_printf(b, "# aspect_ratio=%d/%d\n", s->params.aspect_ratio[0], s->params.aspect_ratio[1]);
-    ngli_bstr_printf(b, "# framerate=%d/%d\n", s->params.framerate[0], s->params.framerate[1]);
+    write_str(w, "# duration=");
+    print_f64(w, s->params.duration);
+    write_str(w, "\n# aspect_ratio=");
+    print_i32(w, s->params.aspect_ratio[0]);
+    write_chr(w, '/');
+    print_i32(w, s->params.aspect_ratio[1]);
+    write_str(w, "\n# framerate=");
+    print_i32(w, s->params.framerate[0]);
+    write_chr(w, '/');
+    print_i32(w, s->params.framerate[1]);
+    write_chr(w, '\n');
 
     /* Write nodes (1 line = 1 node) */
-    if (serialize(nlist, b, s->params.root) < 0)
-        goto end;
-    str = ngli_bstr_strdup(b);
+    ret = serialize(&nids, w, s->params.root);
+    if (ret >= 0)
+        ret = w->ret;
 
 end:
-    ngli_hmap_freep(&nlist);
-    ngli_bstr_freep(&b);
-    return str;
+    node_ids_reset(&nids);
+    return ret;
+}
+
+static int writer_init(struct writer *w, int fd)
+{
+    *w = (struct writer){.size = WRITER_BUFSIZE, .fd = fd};
+    w->buf = ngli_malloc(w->size);
+    if (!w->buf)
+        return NGL_ERROR_MEMORY;
+    return 0;
+}
+
+char *ngli_scene_serialize(const struct ngl_scene *s)
+{
+    struct writer w;
+    if (writer_init(&w, -1) < 0)
+        return NULL;
+
+    if (serialize_scene(s, &w) < 0)
+        goto fail;
+
+    /* Return the buffer as is to avoid a copy */
+    char *str = writer_reserve(&w, 1);
+    if (!str)
+        goto fail;
+    *str = 0;
+    return w.buf;
+
+fail:
+    ngli_free(w.buf);
+    return NULL;
+}
+
+int ngli_scene_serialize_fd(const struct ngl_scene *s, int fd)
+{
+    struct writer w;
+    int ret = writer_init(&w, fd);
+    if (ret < 0)
+        return ret;
+
+    ret = serialize_scene(s, &w);
+    if (ret >= 0)
+        ret = writer_flush(&w);
+
+    ngli_free(w.buf);
+    return ret;
 }
@@ -73,3 +73,105 @@ void ngli_mat4_mul_vec4_sse(float *dst, const float *m, const float *v)
 
     _mm_store_ps(dst, r);
 }
+
+void ngli_mat4_mul_vec4_array_sse(float *dst, const float *m, const float *v, size_t count)
+{
+    __m128 m0 = _mm_load_ps(m);
+    __m128 m1 = _mm_load_ps(m + 4);
+    __m128 m2 = _mm_load_ps(m + 8);
+    __m128 m3 = _mm_load_ps(m + 12);
+
+    for (size_t i = 0; i < count; i++) {
+        const float *vi = v + i * 4;
+
+        __m128 r0 = _mm_mul_ps(m0, _mm_set1_ps(vi[0]));
+        __m128 r1 = _mm_mul_ps(m1, _mm_set1_ps(vi[1]));
+        __m128 r2 = _mm_mul_ps(m2, _mm_set1_ps(vi[2]));
+        __m128 r3 = _mm_mul_ps(m3, _mm_set1_ps(vi[3]));
+
+        __m128 r = _mm_add_ps(_mm_add_ps(_mm_add_ps(r0, r1), r2), r3);
+
+        _mm_store_ps(dst + i * 4, r);
+    }
+}
+
+/*
+ * The following functions are compiled for AVX2 regardless of the compiler
+ * flags and must only be called after checking the CPU features. They do not
+ * use fused multiply-add, which rounds differently: their results must stay
+ * bit-identical to the SSE versions whatever the host CPU.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+# define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+# define TARGET_AVX2
+#endif
+
+TARGET_AVX2
+void ngli_mat4_mul_avx2(float *dst, const float *m1, const float *m2)
+{
+    /* Each 128-bit lane computes one column of the result */
+    __m256 m1_0 = _mm256_broadcast_ps((const __m128 *)m1);
+    __m256 m1_1 = _mm256_broadcast_ps((const __m128 *)(m1 + 4));
+    __m256 m1_2 = _mm256_broadcast_ps((const __m128 *)(m1 + 8));
+    __m256 m1_3 = _mm256_broadcast_ps((const __m128 *)(m1 + 12));
+
+    __m256 m2_01 = _mm256_loadu_ps(m2);
+    __m256 m2_23 = _mm256_loadu_ps(m2 + 8);
+
+    __m256 r01 = _mm256_mul_ps(m1_0, _mm256_permute_ps(m2_01, 0x00));
+    __m256 r23 = _mm256_mul_ps(m1_0, _mm256_permute_ps(m2_23, 0x00));
+
+    r01 = _mm256_add_ps(r01, _mm256_mul_ps(m1_1, _mm256_permute_ps(m2_01, 0x55)));
+    r23 = _mm256_add_ps(r23, _mm256_mul_ps(m1_1, _mm256_permute_ps(m2_23, 0x55)));
+
+    r01 = _mm256_add_ps(r01, _mm256_mul_ps(m1_2, _mm256_permute_ps(m2_01, 0xaa)));
+    r23 = _mm256_add_ps(r23, _mm256_mul_ps(m1_2, _mm256_permute_ps(m2_23, 0xaa)));
+
+    r01 = _mm256_add_ps(r01, _mm256_mul_ps(m1_3, _mm256_permute_ps(m2_01, 0xff)));
+    r23 = _mm256_add_ps(r23, _mm256_mul_ps(m1_3, _mm256_permute_ps(m2_23, 0xff)));
+
+    _mm256_storeu_ps(dst,     r01);
+    _mm256_storeu_ps(dst + 8, r23);
+}
+
+TARGET_AVX2
+void ngli_mat4_mul_vec4_avx2(float *dst, const float *m, const float *v)
+{
+    __m128 m0 = _mm_load_ps(m);
+    __m128 m1 = _mm_load_ps(m + 4);
+    __m128 m2 = _mm_load_ps(m + 8);
+    __m128 m3 = _mm_load_ps(m + 12);
+
+    __m128 r = _mm_mul_ps(m0, _mm_set1_ps(v[0]));
+    r = _mm_add_ps(r, _mm_mul_ps(m1, _mm_set1_ps(v[1])));
+    r = _mm_add_ps(r, _mm_mul_ps(m2, _mm_set1_ps(v[2])));
+    r = _mm_add_ps(r, _mm_mul_ps(m3, _mm_set1_ps(v[3])));
+
+    _mm_store_ps(dst, r);
+}
+
+TARGET_AVX2
+void ngli_mat4_mul_vec4_array_avx2(float *dst, const float *m, const float *v, size_t count)
+{
+    /* Two vectors are transformed at once, one per 128-bit lane */
+    __m256 m0 = _mm256_broadcast_ps((const __m128 *)m);
+    __m256 m1 = _mm256_broadcast_ps((const __m128 *)(m + 4));
+    __m256 m2 = _mm256_broadcast_ps((const __m128 *)(m + 8));
+    __m256 m3 = _mm256_broadcast_ps((const __m128 *)(m + 12));
+
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        __m256 vi = _mm256_loadu_ps(v + i * 4);
+
+        __m256 r = _mm256_mul_ps(m0, _mm256_permute_ps(vi, 0x00));
+        r = _mm256_add_ps(r, _mm256_mul_ps(m1, _mm256_permute_ps(vi, 0x55)));
+        r = _mm256_add_ps(r, _mm256_mul_ps(m2, _mm256_permute_ps(vi, 0xaa)));
+        r = _mm256_add_ps(r, _mm256_mul_ps(m3, _mm256_permute_ps(vi, 0xff)));
+
+        _mm256_storeu_ps(dst + i * 4, r);
+    }
+
+    if (i < count)
+        ngli_mat4_mul_vec4_avx2(dst + i * 4, m, v + i * 4);
+}
@@ -21,7 +21,9 @@
 
 #include <stdlib.h>
 #include <math.h>
+#include <string.h>
 
+#include "cpu.h"
 #include "utils.h"
 #include "math_utils.h"
 
@@ -42,33 +44,17 @@ static void flt_check(const float *f, size_t size)
     printf("=> OK\n");
 }
 
-int main(void)
+static void test_funcs(const char *name, const struct math_funcs *funcs,
+                       const float *m1, const float *m2)
 {
-    static const NGLI_ALIGNED_MAT(m1) = {
-        0.73016f,  0.51184f, 0.20930f, -7.42311f,
-       -9.42693f,  1.47287f, 0.34995f,  0.42049f,
-        0.42603f, -1.50442f, 1.34210f,  3.04868f,
-        0.53013f,  0.68963f, 0.25207f,  1.96254f,
-    };
-
-    static const NGLI_ALIGNED_MAT(m2) = {
-        0.08222f, 0.62387f, 0.79754f,  0.64541f,
-        1.70126f, 2.24977f, 0.05395f, -3.00599f,
-        0.30858f, 0.90973f, 0.84432f, -4.01016f,
-        6.19681f, 5.45165f, 0.77647f,  0.59262f,
-    };
-
-    printf("m1:\n" NGLI_FMT_MAT4 "\n", NGLI_ARG_MAT4(m1));
-    printf("m2:\n" NGLI_FMT_MAT4 "\n", NGLI_ARG_MAT4(m2));
-
-    printf(":: Testing mat4 mul\n");
+    printf(":: Testing %s mat4 mul\n", name);
 
     NGLI_ALIGNED_MAT(m_ref);
     NGLI_ALIGNED_MAT(m_out) = {0};
     NGLI_ALIGNED_MAT(m_diff);
 
     ngli_mat4_mul_c(m_ref, m1, m2);
-    ngli_mat4_mul(m_out, m1, m2);
+    funcs->mat4_mul(m_out, m1, m2);
     flt_diff(m_diff, m_ref, m_out, 4*4);
 
     printf("ref:\n"  NGLI_FMT_MAT4 "\n", NGLI_ARG_MAT4(m_ref));
@@ -76,8 +62,15 @@ int main(void)
     printf("diff:\n" NGLI_FMT_MAT4 "\n", NGLI_ARG_MAT4(m_diff));
     flt_check(m_diff, 4*4);
 
+    printf(":: Testing %s mat4 mul in place\n", name);
+
+    memcpy(m_out, m1, sizeof(m_out));
+    funcs->mat4_mul(m_out, m_out, m2);
+    flt_diff(m_diff, m_ref, m_out, 4*4);
+    flt_check(m_diff, 4*4);
+
     for (size_t i = 0; i < 4; i++) {
-        printf(":: Testing mat4 mul vec4 %zu/4\n", i + 1);
+        printf(":: Testing %s mat4 mul vec4 %zu/4\n", name, i + 1);
 
         const float *v = &m2[i * 4];
 
@@ -86,7 +79,7 @@ int main(void)
         NGLI_ALIGNED_VEC(v_diff);
 
         ngli_mat4_mul_vec4_c(v_ref, m1, v);
-        ngli_mat4_mul_vec4(v_out, m1, v);
+        funcs->mat4_mul_vec4(v_out, m1, v);
         flt_diff(v_diff, v_ref, v_out, 4);
 
         printf("ref:  " NGLI_FMT_VEC4 "\n", NGLI_ARG_VEC4(v_ref));
@@ -95,5 +88,109 @@ int main(void)
         flt_check(v_diff, 4);
     }
 
+    /* Odd counts make sure the remaining elements of wide paths are handled */
+    for (size_t count = 1; count <= 4; count++) {
+        printf(":: Testing %s mat4 mul vec4 array of %zu\n", name, count);
+
+        NGLI_ALIGNED_MAT(a_ref);
+        NGLI_ALIGNED_MAT(a_out);
+        NGLI_ALIGNED_MAT(a_diff);
+
+        ngli_mat4_mul_vec4_array_c(a_ref, m1, m2, count);
+        memcpy(a_out, m2, sizeof(a_out));
+        funcs->mat4_mul_vec4_array(a_out, m1, a_out, count);
+        flt_diff(a_diff, a_ref, a_out, 4 * count);
+        flt_check(a_diff, 4 * count);
+    }
+}
+
+/*
+ * The wider x86 paths must give exactly the same results as the SSE ones so
+ * that the rendering does not depend on the host CPU
+ */
+static void test_identical(const char *name, const struct math_funcs *funcs,
+                           const struct math_funcs *ref_funcs,
+                           const float *m1, const float *m2)
+{
+    printf(":: Testing %s bit-exactness against sse\n", name);
+
+    NGLI_ALIGNED_MAT(m_ref);
+    NGLI_ALIGNED_MAT(m_out);
+
+    ref_funcs->mat4_mul(m_ref, m1, m2);
+    funcs->mat4_mul(m_out, m1, m2);
+    if (memcmp(m_ref, m_out, sizeof(m_out))) {
+        fprintf(stderr, "mat4 mul differs from sse\n");
+        exit(1);
+    }
+
+    for (size_t i = 0; i < 4; i++) {
+        NGLI_ALIGNED_VEC(v_ref);
+        NGLI_ALIGNED_VEC(v_out);
+
+        ref_funcs->mat4_mul_vec4(v_ref, m1, &m2[i * 4]);
+        funcs->mat4_mul_vec4(v_out, m1, &m2[i * 4]);
+        if (memcmp(v_ref, v_out, sizeof(v_out))) {
+            fprintf(stderr, "mat4 mul vec4 %zu/4 differs from sse\n", i + 1);
+            exit(1);
+        }
+    }
+
+    ref_funcs->mat4_mul_vec4_array(m_ref, m1, m2, 4);
+    funcs->mat4_mul_vec4_array(m_out, m1, m2, 4);
+    if (memcmp(m_ref, m_out, sizeof(m_out))) {
+        fprintf(stderr, "mat4 mul vec4 array differs from sse\n");
+        exit(1);
+    }
+    printf("=> OK\n");
+}
+
+int main(void)
+{
+    static const NGLI_ALIGNED_MAT(m1) = {
+        0.73016f,  0.51184f, 0.20930f, -7.42311f,
+       -9.42693f,  1.47287f, 0.34995f,  0.42049f,
+        0.42603f, -1.50442f, 1.34210f,  3.04868f,
+        0.53013f,  0.68963f, 0.25207f,  1.96254f,
+    };
+
+    static const NGLI_ALIGNED_MAT(m2) = {
+        0.08222f, 0.62387f, 0.79754f,  0.64541f,
+        1.70126f, 2.24977f, 0.05395f, -3.00599f,
+        0.30858f, 0.90973f, 0.84432f, -4.01016f,
+        6.19681f, 5.45165f, 0.77647f,  0.59262f,
+    };
+
+    printf("m1:\n" NGLI_FMT_MAT4 "\n", NGLI_ARG_MAT4(m1));
+    printf("m2:\n" NGLI_FMT_MAT4 "\n", NGLI_ARG_MAT4(m2));
+
+    static const struct {
+        const char *name;
+        uint32_t flags;
+    } variants[] = {
+        {"sse",  NGLI_CPU_FLAG_SSE},
+        {"avx2", NGLI_CPU_FLAG_SSE | NGLI_CPU_FLAG_AVX2},
+        {"neon", NGLI_CPU_FLAG_NEON},
+    };
+
+    const uint32_t cpu_flags = ngli_cpu_get_flags();
+
+    for (size_t n = 0; n < NGLI_ARRAY_NB(variants); n++) {
+        if ((cpu_flags & variants[n].flags) != variants[n].flags) {
+            printf(":: Skipping %s variant (not supported by the CPU)\n", variants[n].name);
+            continue;
+        }
+
+        struct math_funcs funcs;
+        ngli_math_funcs_init(&funcs, variants[n].flags);
+        test_funcs(variants[n].name, &funcs, m1, m2);
+
+        if ((variants[n].flags & NGLI_CPU_FLAG_SSE) && variants[n].flags != NGLI_CPU_FLAG_SSE) {
+            struct math_funcs sse_funcs;
+            ngli_math_funcs_init(&sse_funcs, NGLI_CPU_FLAG_SSE);
+            test_identical(variants[n].name, &funcs, &sse_funcs, m1, m2);
+        }
+    }
+
     return 0;
 }
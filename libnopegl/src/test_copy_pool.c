@@ -0,0 +1,125 @@
+/*
+ * Copyright 2024 Nope Forge
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "copy_pool.h"
+#include "math_utils.h"
+#include "memory.h"
+#include "utils.h"
+
+#define GUARD_SIZE 16
+#define GUARD_BYTE 0xa5
+
+struct frame_layout {
+    int width;
+    int height;
+    size_t nb_planes;
+    int log2_chroma_width;
+    int log2_chroma_height;
+    int bytes_per_pixel[4];
+};
+
+static const struct frame_layout layouts[] = {
+    /* yuv420p */
+    {1921, 1081, 3, 1, 1, {1, 1, 1}},
+    /* nv12 */
+    {1283, 721, 2, 1, 1, {1, 2}},
+    /* yuv444p10 */
+    {641, 479, 3, 0, 0, {2, 2, 2}},
+    /* small yuv420p, below the threading threshold */
+    {33, 17, 3, 1, 1, {1, 1, 1}},
+    /* rgba */
+    {1025, 767, 1, 0, 0, {4}},
+};
+
+static size_t get_plane_size(const struct frame_layout *layout, size_t plane)
+{
+    const int width  = plane ? NGLI_CEIL_RSHIFT(layout->width,  layout->log2_chroma_width)  : layout->width;
+    const int height = plane ? NGLI_CEIL_RSHIFT(layout->height, layout->log2_chroma_height) : layout->height;
+    return (size_t)width * height * layout->bytes_per_pixel[plane];
+}
+
+static void test_layout(struct copy_pool *pool, const struct frame_layout *layout, uint32_t seed)
+{
+    struct plane_copy copies[4] = {0};
+    uint8_t *src[4] = {0};
+    uint8_t *dst[4] = {0};
+
+    for (size_t i = 0; i < layout->nb_planes; i++) {
+        const size_t size = get_plane_size(layout, i);
+        src[i] = ngli_malloc(size);
+        dst[i] = ngli_malloc(size + 2 * GUARD_SIZE);
+        ngli_assert(src[i] && dst[i]);
+
+        for (size_t j = 0; j < size; j++) {
+            seed = seed * 1664525 + 1013904223;
+            src[i][j] = (uint8_t)(seed >> 24);
+        }
+        memset(dst[i], GUARD_BYTE, size + 2 * GUARD_SIZE);
+
+        copies[i] = (struct plane_copy){
+            .dst  = dst[i] + GUARD_SIZE,
+            .src  = src[i],
+            .size = size,
+        };
+    }
+
+    ngli_copy_pool_run(pool, copies, layout->nb_planes);
+
+    for (size_t i = 0; i < layout->nb_planes; i++) {
+        const size_t size = copies[i].size;
+        ngli_assert(!memcmp(dst[i] + GUARD_SIZE, src[i], size));
+        for (size_t j = 0; j < GUARD_SIZE; j++) {
+            ngli_assert(dst[i][j] == GUARD_BYTE);
+            ngli_assert(dst[i][GUARD_SIZE + size + j] == GUARD_BYTE);
+        }
+        ngli_freep(&src[i]);
+        ngli_freep(&dst[i]);
+    }
+}
+
+int main(void)
+{
+    struct copy_pool *pool = ngli_copy_pool_create();
+    ngli_assert(pool);
+
+    /* Map several frames in a row to check the workers are reused */
+    for (uint32_t n = 0; n < 3; n++) {
+        for (size_t i = 0; i < NGLI_ARRAY_NB(layouts); i++) {
+            const struct frame_layout *layout = &layouts[i];
+            printf("frame %u: %dx%d with %zu plane(s)\n", n, layout->width, layout->height, layout->nb_planes);
+            test_layout(pool, layout, n * 1000 + (uint32_t)i);
+        }
+    }
+
+    ngli_copy_pool_freep(&pool);
+
+    /* A pool that never reached the threading threshold */
+    pool = ngli_copy_pool_create();
+    ngli_assert(pool);
+    test_layout(pool, &layouts[3], 0);
+    ngli_copy_pool_freep(&pool);
+
+    return 0;
+}
@@ -0,0 +1,158 @@
+/*
+ * Copyright 2024 Nope Forge
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "log.h"
+#include "memory.h"
+#include "pthread_compat.h"
+#include "utils.h"
+
+#define LONG_MSG_SIZE 1000
+#define NB_THREADS 4
+#define NB_MSGS_PER_THREAD 20000
+#define NB_CYCLES 100
+
+static struct {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    int blocked;
+    uint64_t nb_msgs;
+    uint64_t nb_warnings;
+    size_t last_len;
+} state = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .cond = PTHREAD_COND_INITIALIZER,
+};
+
+static void reset_state(void)
+{
+    pthread_mutex_lock(&state.lock);
+    state.nb_msgs = 0;
+    state.nb_warnings = 0;
+    state.last_len = 0;
+    pthread_mutex_unlock(&state.lock);
+}
+
+ngli_printf_format(6, 0)
+static void log_callback(void *arg, int level, const char *filename, int ln,
+                         const char *fn, const char *fmt, va_list vl)
+{
+    const int len = vsnprintf(NULL, 0, fmt, vl);
+
+    pthread_mutex_lock(&state.lock);
+    while (state.blocked)
+        pthread_cond_wait(&state.cond, &state.lock);
+    /* The drop reports are the only warnings */
+    if (level == NGL_LOG_WARNING) {
+        state.nb_warnings++;
+    } else {
+        state.nb_msgs++;
+        state.last_len = (size_t)len;
+    }
+    pthread_mutex_unlock(&state.lock);
+}
+
+static void set_blocked(int blocked)
+{
+    pthread_mutex_lock(&state.lock);
+    state.blocked = blocked;
+    pthread_cond_broadcast(&state.cond);
+    pthread_mutex_unlock(&state.lock);
+}
+
+static void test_long_message(void)
+{
+    char msg[LONG_MSG_SIZE + 1];
+    memset(msg, 'a', LONG_MSG_SIZE);
+    msg[LONG_MSG_SIZE] = 0;
+
+    reset_state();
+    ngli_assert(ngli_log_set_async(1) == 0);
+    LOG(INFO, "%s", msg);
+    ngli_assert(ngli_log_set_async(0) == 0);
+
+    ngli_assert(state.nb_msgs == 1);
+    ngli_assert(state.last_len == LONG_MSG_SIZE);
+}
+
+static void test_overflow(void)
+{
+    const uint64_t nb_msgs = 3000;
+    const uint64_t nb_dropped_start = ngli_log_get_nb_dropped();
+
+    reset_state();
+    set_blocked(1);
+    ngli_assert(ngli_log_set_async(1) == 0);
+    for (uint64_t i = 0; i < nb_msgs; i++)
+        LOG(INFO, "message %" PRIu64, i);
+    const uint64_t nb_dropped = ngli_log_get_nb_dropped() - nb_dropped_start;
+    set_blocked(0);
+    ngli_assert(ngli_log_set_async(0) == 0);
+
+    printf("overflow: %" PRIu64 " messages received, %" PRIu64 " dropped\n", state.nb_msgs, nb_dropped);
+    ngli_assert(nb_dropped > 0);
+    ngli_assert(state.nb_warnings > 0);
+    ngli_assert(state.nb_msgs + nb_dropped == nb_msgs);
+}
+
+static void *log_thread(void *arg)
+{
+    for (int i = 0; i < NB_MSGS_PER_THREAD; i++)
+        LOG(INFO, "message %d", i);
+    return NULL;
+}
+
+static void test_enable_disable_cycle(void)
+{
+    const uint64_t nb_dropped_start = ngli_log_get_nb_dropped();
+
+    reset_state();
+    pthread_t tids[NB_THREADS];
+    for (size_t i = 0; i < NB_THREADS; i++)
+        ngli_assert(!pthread_create(&tids[i], NULL, log_thread, NULL));
+    for (int i = 0; i < NB_CYCLES; i++)
+        ngli_assert(ngli_log_set_async(i & 1 ? 0 : 1) == 0);
+    for (size_t i = 0; i < NB_THREADS; i++)
+        pthread_join(tids[i], NULL);
+    ngli_assert(ngli_log_set_async(0) == 0);
+
+    /* Every message is either received or accounted as dropped */
+    const uint64_t nb_dropped = ngli_log_get_nb_dropped() - nb_dropped_start;
+    printf("cycle: %" PRIu64 " messages received, %" PRIu64 " dropped\n", state.nb_msgs, nb_dropped);
+    ngli_assert(state.nb_msgs + nb_dropped == NB_THREADS * NB_MSGS_PER_THREAD);
+}
+
+int main(void)
+{
+    ngli_log_set_callback(NULL, log_callback);
+    ngli_log_set_min_level(NGL_LOG_INFO);
+
+    test_long_message();
+    test_overflow();
+    test_enable_disable_cycle();
+
+    return 0;
+}
@@ -112,6 +112,59 @@ static int run_test(void)
     return ret;
 }
 
+/*
+ * The multi-components generator must match independent scalar generators
+ * with the seed of each component, and its batch evaluation must match the
+ * individual evaluations
+ */
+static int run_test_vec(void)
+{
+    int ret = 0;
+
+    for (size_t k = 0; k < NGLI_ARRAY_NB(noise_tests); k++) {
+        const struct noise_params *np = &noise_tests[k].p;
+
+        for (size_t n = 1; n <= NGLI_NOISEVEC_MAX_COMPONENTS; n++) {
+            printf("testing %zu components with seed:0x%08x fn:%d\n", n, np->seed, np->function);
+
+            struct noisevec noisevec;
+            if (ngli_noisevec_init(&noisevec, np, n) < 0)
+                return EXIT_FAILURE;
+
+            struct noise noises[NGLI_NOISEVEC_MAX_COMPONENTS];
+            const uint32_t seed_offset = UINT32_MAX / (uint32_t)n;
+            for (size_t c = 0; c < n; c++) {
+                struct noise_params component_params = *np;
+                component_params.seed = np->seed + (uint32_t)c * seed_offset;
+                if (ngli_noise_init(&noises[c], &component_params) < 0)
+                    return EXIT_FAILURE;
+            }
+
+            float times[37];
+            float batch[NGLI_ARRAY_NB(times) * NGLI_NOISEVEC_MAX_COMPONENTS];
+            for (size_t i = 0; i < NGLI_ARRAY_NB(times); i++)
+                times[i] = (float)i * .173f;
+            ngli_noisevec_get_batch(&noisevec, times, NGLI_ARRAY_NB(times), batch);
+
+            for (size_t i = 0; i < NGLI_ARRAY_NB(times); i++) {
+                float values[NGLI_NOISEVEC_MAX_COMPONENTS];
+                ngli_noisevec_get(&noisevec, times[i], values);
+                for (size_t c = 0; c < n; c++) {
+                    const float ev = ngli_noise_get(&noises[c], times[i]);
+                    const float bv = batch[i * n + c];
+                    if (fabs(values[c] - ev) > 0.0001 || fabs(bv - ev) > 0.0001) {
+                        fprintf(stderr, "noisevec(%f)[%zu]=%g (batch:%g) but expected %g\n",
+                                times[i], c, values[c], bv, ev);
+                        ret = EXIT_FAILURE;
+                    }
+                }
+            }
+        }
+    }
+
+    return ret;
+}
+
 static const struct noise_params default_params = {
     .amplitude  = 1.0,
     .octaves    = 8,
@@ -123,8 +176,10 @@ static const struct noise_params default_params = {
 
 int main(int ac, char **av)
 {
-    if (ac == 1)
-        return run_test();
+    if (ac == 1) {
+        const int ret = run_test();
+        return ret == EXIT_SUCCESS ? run_test_vec() : ret;
+    }
 
     const float duration = ac > 1 ? (float)atof(av[1]) : 3.f;
     const float frequency = ac > 2 ? (float)atof(av[2]) : 10.f;
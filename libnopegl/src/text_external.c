@@ -41,51 +41,138 @@
 #include "utils.h"
 
 #if HAVE_TEXT_LIBRARIES
-struct text_external {
-    struct darray ft_faces; // FT_Face (hidden pointer)
-    struct darray hb_fonts; // hb_font_t*
-    struct distmap *distmap;
+/*
+ * Font files and sized faces are shared at the context level between all the
+ * Text nodes: a font file is memory mapped once, and a FreeType face (along
+ * with its HarfBuzz font) is created once per file, face index and size. The
+ * Text nodes are only initialized and updated from the rendering thread so
+ * no locking is required.
+ */
+struct text_font_file {
+    size_t count;
+    void *data;
+    size_t size;
 };
 
-static int load_font(struct text *text, const char *font_file, int32_t face_index)
+struct text_font_face {
+    size_t count;
+    struct ngl_ctx *ctx;
+    char *key;
+    char *path;
+    FT_Face ft_face;
+    hb_font_t *hb_font;
+};
+
+static void free_font_file(void *user_arg, void *data)
 {
-    struct text_external *s = text->priv_data;
+    struct text_font_file *file = data;
+    ngli_unmap_file(file->data, file->size);
+    ngli_freep(&file);
+}
 
-    /* This limitation simplifies the UID computation in GLYPH_UID_STRING() */
-    if (ngli_darray_count(&s->ft_faces) == 0xff) {
-        LOG(ERROR, "maximum number of fonts reached (256)");
-        return NGL_ERROR_LIMIT_EXCEEDED;
+static void unref_font_file(struct ngl_ctx *ctx, const char *path)
+{
+    struct text_font_file *file = ngli_hmap_get_str(ctx->text_font_files, path);
+    if (file && --file->count == 0)
+        ngli_hmap_set_str(ctx->text_font_files, path, NULL);
+}
+
+static struct text_font_file *ref_font_file(struct ngl_ctx *ctx, const char *path)
+{
+    if (!ctx->text_font_files) {
+        ctx->text_font_files = ngli_hmap_create(NGLI_HMAP_TYPE_STR);
+        if (!ctx->text_font_files)
+            return NULL;
+        ngli_hmap_set_free_func(ctx->text_font_files, free_font_file, NULL);
+    }
+
+    struct text_font_file *file = ngli_hmap_get_str(ctx->text_font_files, path);
+    if (file) {
+        file->count++;
+        return file;
     }
 
-    FT_Face ft_face = NULL;
-    hb_font_t *hb_font = NULL;
+    file = ngli_calloc(1, sizeof(*file));
+    if (!file)
+        return NULL;
+
+    int ret = ngli_map_file(path, &file->data, &file->size);
+    if (ret < 0) {
+        ngli_freep(&file);
+        return NULL;
+    }
+
+    ret = ngli_hmap_set_str(ctx->text_font_files, path, file);
+    if (ret < 0) {
+        free_font_file(NULL, file);
+        return NULL;
+    }
+
+    file->count = 1;
+    return file;
+}
+
+static void free_font_face(void *user_arg, void *data)
+{
+    struct text_font_face *face = data;
+    if (face->hb_font)
+        hb_font_destroy(face->hb_font);
+    if (face->ft_face)
+        FT_Done_Face(face->ft_face);
+    unref_font_file(face->ctx, face->path);
+    ngli_freep(&face->path);
+    ngli_freep(&face->key);
+    ngli_freep(&face);
+}
+
+static void release_font_face(struct text_font_face *face)
+{
+    if (--face->count == 0)
+        ngli_hmap_set_str(face->ctx->text_font_faces, face->key, NULL);
+}
+
+static char *get_font_face_key(const char *path, int32_t index, int32_t pt_size, int32_t dpi)
+{
+    return ngli_asprintf("%d:%d:%d:%s", index, pt_size, dpi, path);
+}
+
+static int create_font_face(struct text_font_face *face, const char *path, int32_t index,
+                            int32_t pt_size, int32_t dpi)
+{
+    struct ngl_ctx *ctx = face->ctx;
+
+    face->path = ngli_strdup(path);
+    if (!face->path)
+        return NGL_ERROR_MEMORY;
+
+    const struct text_font_file *file = ref_font_file(ctx, path);
+    if (!file) {
+        ngli_freep(&face->path);
+        return NGL_ERROR_IO;
+    }
 
-    FT_Error ft_error = FT_New_Face(text->ctx->ft_library, font_file, face_index, &ft_face);
+    FT_Error ft_error = FT_New_Memory_Face(ctx->ft_library, (const FT_Byte *)file->data, (FT_Long)file->size, index, &face->ft_face);
     if (ft_error) {
-        LOG(ERROR, "unable to initialize FreeType with font %s face %d", font_file, face_index);
+        face->ft_face = NULL;
+        LOG(ERROR, "unable to initialize FreeType with font %s face %d", path, index);
         return NGL_ERROR_EXTERNAL;
     }
 
-    if (!FT_IS_SCALABLE(ft_face)) {
+    if (!FT_IS_SCALABLE(face->ft_face)) {
         LOG(ERROR, "only scalable faces are supported");
         return NGL_ERROR_UNSUPPORTED;
     }
 
-    if (!ngli_darray_push(&s->ft_faces, &ft_face)) {
-        FT_Done_Face(ft_face);
-        return NGL_ERROR_MEMORY;
-    }
-
-    const int32_t pt_size = text->config.pt_size;
     const FT_F26Dot6 chr_w = NGLI_I32_TO_I26D6(pt_size); // nominal width in 26.6
     const FT_F26Dot6 chr_h = NGLI_I32_TO_I26D6(pt_size); // nominal height in 26.6
-    const FT_UInt res = text->config.dpi; // resolution in dpi
-    ft_error = FT_Set_Char_Size(ft_face, chr_w, chr_h, res, res);
+    const FT_UInt res = dpi; // resolution in dpi
+    ft_error = FT_Set_Char_Size(face->ft_face, chr_w, chr_h, res, res);
     if (ft_error) {
         LOG(ERROR, "unable to set char size to %d points in %u DPI", pt_size, res);
         return NGL_ERROR_EXTERNAL;
     }
 
+    const FT_Face ft_face = face->ft_face;
     LOG(DEBUG, "loaded font family %s", ft_face->family_name);
     if (ft_face->style_name)
         LOG(DEBUG, "* style: %s", ft_face->style_name);
@@ -102,39 +189,113 @@ static int load_font(struct text *text, const char *font_file, int32_t face_inde
     LOG(DEBUG, "* underline_[position:%d thickness:%d]",
         ft_face->underline_position, ft_face->underline_thickness);
 
-    hb_font = hb_ft_font_create(ft_face, NULL);
-    if (!hb_font)
+    face->hb_font = hb_ft_font_create(ft_face, NULL);
+    if (!face->hb_font)
         return NGL_ERROR_MEMORY;
 
-    if (!ngli_darray_push(&s->hb_fonts, &hb_font)) {
-        hb_font_destroy(hb_font);
+    return 0;
+}
+
+static int ref_font_face(struct ngl_ctx *ctx, const char *path, int32_t index,
+                         int32_t pt_size, int32_t dpi, struct text_font_face **facep)
+{
+    if (!ctx->text_font_faces) {
+        ctx->text_font_faces = ngli_hmap_create(NGLI_HMAP_TYPE_STR);
+        if (!ctx->text_font_faces)
+            return NGL_ERROR_MEMORY;
+        ngli_hmap_set_free_func(ctx->text_font_faces, free_font_face, NULL);
+    }
+
+    char *key = get_font_face_key(path, index, pt_size, dpi);
+    if (!key)
         return NGL_ERROR_MEMORY;
+
+    struct text_font_face *face = ngli_hmap_get_str(ctx->text_font_faces, key);
+    if (face) {
+        ngli_freep(&key);
+        face->count++;
+        *facep = face;
+        return 0;
     }
 
+    face = ngli_calloc(1, sizeof(*face));
+    if (!face) {
+        ngli_freep(&key);
+        return NGL_ERROR_MEMORY;
+    }
+    face->ctx = ctx;
+
+    int ret = create_font_face(face, path, index, pt_size, dpi);
+    if (ret < 0)
+        goto fail;
+
+    ret = ngli_hmap_set_str(ctx->text_font_faces, key, face);
+    if (ret < 0)
+        goto fail;
+
+    face->key = key;
+    face->count = 1;
+    *facep = face;
     return 0;
+
+fail:
+    if (face->path)
+        free_font_face(NULL, face);
+    else
+        ngli_freep(&face);
+    ngli_freep(&key);
+    return ret;
 }
 
-static void free_ft_face(void *user_arg, void *data)
+struct text_external {
+    struct darray faces;    // struct text_font_face *
+    struct darray ft_faces; // FT_Face (hidden pointer)
+    struct darray hb_fonts; // hb_font_t*
+    struct distmap *distmap;
+};
+
+static int load_font(struct text *text, const char *font_file, int32_t face_index)
 {
-    FT_Face *face = data;
-    FT_Done_Face(*face);
+    struct text_external *s = text->priv_data;
+
+    /* This limitation simplifies the UID computation in GLYPH_UID_STRING() */
+    if (ngli_darray_count(&s->ft_faces) == 0xff) {
+        LOG(ERROR, "maximum number of fonts reached (256)");
+        return NGL_ERROR_LIMIT_EXCEEDED;
+    }
+
+    struct text_font_face *face;
+    int ret = ref_font_face(text->ctx, font_file, face_index, text->config.pt_size, text->config.dpi, &face);
+    if (ret < 0)
+        return ret;
+
+    if (!ngli_darray_push(&s->faces, &face)) {
+        release_font_face(face);
+        return NGL_ERROR_MEMORY;
+    }
+
+    if (!ngli_darray_push(&s->ft_faces, &face->ft_face) ||
+        !ngli_darray_push(&s->hb_fonts, &face->hb_font))
+        return NGL_ERROR_MEMORY;
+
+    return 0;
 }
 
-static void free_hb_font(void *user_arg, void *data)
+static void free_face_ref(void *user_arg, void *data)
 {
-    struct hb_font_t **fontp = data;
-    hb_font_destroy(*fontp);
+    struct text_font_face **facep = data;
+    release_font_face(*facep);
 }
 
 static int text_external_init(struct text *text)
 {
     struct text_external *s = text->priv_data;
 
+    ngli_darray_init(&s->faces, sizeof(struct text_font_face *), 0);
     ngli_darray_init(&s->ft_faces, sizeof(FT_Face), 0);
     ngli_darray_init(&s->hb_fonts, sizeof(hb_font_t *), 0);
 
-    ngli_darray_set_free_func(&s->ft_faces, free_ft_face, NULL);
-    ngli_darray_set_free_func(&s->hb_fonts, free_hb_font, NULL);
+    ngli_darray_set_free_func(&s->faces, free_face_ref, NULL);
 
     for (size_t i = 0; i < text->config.nb_font_faces; i++) {
         const struct ngl_node *face_node = text->config.font_faces[i];
@@ -805,6 +966,7 @@ static void text_external_reset(struct text *text)
 
     ngli_darray_reset(&s->hb_fonts);
     ngli_darray_reset(&s->ft_faces);
+    ngli_darray_reset(&s->faces);
     ngli_distmap_freep(&s->distmap);
 }
 
@@ -19,15 +19,39 @@
  * under the License.
  */
 
+#include "format.h"
 #include "gpu_ctx.h"
 #include "texture.h"
+#include "utils.h"
 
 static void texture_freep(struct texture **sp)
 {
     if (!*sp)
         return;
 
-    (*sp)->gpu_ctx->cls->texture_freep(sp);
+    struct gpu_ctx *gpu_ctx = (*sp)->gpu_ctx;
+    gpu_ctx->memory_usage -= (*sp)->memory_size;
+    gpu_ctx->texture_memory -= (*sp)->memory_size;
+    gpu_ctx->cls->texture_freep(sp);
+}
+
+static uint64_t get_level_size(const struct texture_params *params)
+{
+    uint64_t size = (uint64_t)params->width
+                  * params->height
+                  * NGLI_MAX(params->depth, 1)
+                  * ngli_format_get_bytes_per_pixel(params->format);
+    if (params->type == NGLI_TEXTURE_TYPE_CUBE)
+        size *= 6;
+    return size;
+}
+
+static uint64_t get_memory_size(const struct texture_params *params)
+{
+    uint64_t size = get_level_size(params) * NGLI_MAX(params->samples, 1);
+    if (params->mipmap_filter != NGLI_MIPMAP_FILTER_NONE)
+        size += size / 3;
+    return size;
 }
 
 struct texture *ngli_texture_create(struct gpu_ctx *gpu_ctx)
@@ -39,14 +63,35 @@ struct texture *ngli_texture_create(struct gpu_ctx *gpu_ctx)
 
 int ngli_texture_init(struct texture *s, const struct texture_params *params)
 {
-    return s->gpu_ctx->cls->texture_init(s, params);
+    int ret = s->gpu_ctx->cls->texture_init(s, params);
+    if (ret < 0)
+        return ret;
+
+    s->memory_size = get_memory_size(params);
+    s->gpu_ctx->memory_usage += s->memory_size;
+    s->gpu_ctx->texture_memory += s->memory_size;
+    return 0;
 }
 
 int ngli_texture_upload(struct texture *s, const uint8_t *data, int linesize)
 {
+    s->gpu_ctx->upload_size += get_level_size(&s->params);
     return s->gpu_ctx->cls->texture_upload(s, data, linesize);
 }
 
+int ngli_texture_map_staging(struct texture *s, int linesize, uint8_t **datap, size_t *sizep)
+{
+    if (!s->gpu_ctx->cls->texture_map_staging)
+        return NGL_ERROR_UNSUPPORTED;
+    return s->gpu_ctx->cls->texture_map_staging(s, linesize, datap, sizep);
+}
+
+int ngli_texture_upload_staging(struct texture *s)
+{
+    s->gpu_ctx->upload_size += get_level_size(&s->params);
+    return s->gpu_ctx->cls->texture_upload_staging(s);
+}
+
 int ngli_texture_generate_mipmap(struct texture *s)
 {
     return s->gpu_ctx->cls->texture_generate_mipmap(s);
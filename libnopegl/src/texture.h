@@ -89,6 +89,7 @@ struct texture {
     struct ngli_rc rc;
     struct gpu_ctx *gpu_ctx;
     struct texture_params params;
+    uint64_t memory_size; /* accounted in gpu_ctx.memory_usage */
 };
 
 NGLI_RC_CHECK_STRUCT(texture);
@@ -99,6 +100,15 @@ int ngli_texture_init(struct texture *s,
                       const struct texture_params *params);
 
 int ngli_texture_upload(struct texture *s, const uint8_t *data, int linesize);
+
+/*
+ * Split upload: the staging memory returned by ngli_texture_map_staging() can
+ * be filled from any thread, then ngli_texture_upload_staging() records the
+ * transfer to the texture. Return NGL_ERROR_UNSUPPORTED if the backend does
+ * not implement it, in which case ngli_texture_upload() must be used.
+ */
+int ngli_texture_map_staging(struct texture *s, int linesize, uint8_t **datap, size_t *sizep);
+int ngli_texture_upload_staging(struct texture *s);
 int ngli_texture_generate_mipmap(struct texture *s);
 
 void ngli_texture_freep(struct texture **sp);
@@ -58,17 +58,62 @@ void ngli_transform_chain_compute(const struct ngl_node *node, float *matrix)
     NGLI_ALIGNED_MAT(tmp) = NGLI_MAT4_IDENTITY;
     while (node && node->cls->category == NGLI_NODE_CATEGORY_TRANSFORM) {
         const struct transform *transform = node->priv_data;
-        ngli_mat4_mul(tmp, tmp, transform->matrix);
-        node = transform->child;
+        ngli_mat4_mul(tmp, tmp, transform->folded_matrix);
+        node = transform->folded_child;
     }
     memcpy(matrix, tmp, sizeof(tmp));
 }
 
+void ngli_transform_fold(struct transform *s)
+{
+    const struct ngl_node *child = s->child;
+
+    s->folded_dirty = 0;
+
+    if (child && child->cls->category == NGLI_NODE_CATEGORY_TRANSFORM) {
+        const struct transform *child_trf = child->priv_data;
+        if (child_trf->is_static) {
+            /* The child already collapsed the static chain following it */
+            ngli_mat4_mul(s->folded_matrix, s->matrix, child_trf->folded_matrix);
+            s->folded_child = child_trf->folded_child;
+            return;
+        }
+    }
+
+    memcpy(s->folded_matrix, s->matrix, sizeof(s->matrix));
+    s->folded_child = s->child;
+}
+
+int ngli_transform_update_child(struct ngl_node *node, double t)
+{
+    struct transform *s = node->priv_data;
+
+    int ret = ngli_node_update(s->child, t);
+    if (ret < 0)
+        return ret;
+
+    if (!s->is_static || s->folded_dirty)
+        ngli_transform_fold(s);
+
+    return 0;
+}
+
+int ngli_transform_invalidate(struct ngl_node *node)
+{
+    /*
+     * Called on the live-changed node and all its ancestors, so every
+     * collapsed matrix including it gets rebuilt during the next update.
+     */
+    struct transform *s = node->priv_data;
+    s->folded_dirty = 1;
+    return 0;
+}
+
 void ngli_transform_draw(struct ngl_node *node)
 {
     struct ngl_ctx *ctx = node->ctx;
     struct transform *s = node->priv_data;
-    struct ngl_node *child = s->child;
+    struct ngl_node *child = s->folded_child;
 
     float *next_matrix = ngli_darray_push(&ctx->modelview_matrix_stack, NULL);
     if (!next_matrix)
@@ -79,7 +124,7 @@ void ngli_transform_draw(struct ngl_node *node)
      * underlying matrix stack buffer */
     const float *prev_matrix = next_matrix - 4 * 4;
 
-    ngli_mat4_mul(next_matrix, prev_matrix, s->matrix);
+    ngli_mat4_mul(next_matrix, prev_matrix, s->folded_matrix);
     ngli_node_draw(child);
     ngli_darray_pop(&ctx->modelview_matrix_stack);
 }
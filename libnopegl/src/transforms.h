@@ -36,6 +36,9 @@
 const struct ngl_node *ngli_transform_get_leaf_node(const struct ngl_node *node);
 int ngli_transform_chain_check(const struct ngl_node *node);
 void ngli_transform_chain_compute(const struct ngl_node *node, float *matrix);
+void ngli_transform_fold(struct transform *s);
+int ngli_transform_update_child(struct ngl_node *node, double t);
+int ngli_transform_invalidate(struct ngl_node *node);
 void ngli_transform_draw(struct ngl_node *node);
 
 #endif
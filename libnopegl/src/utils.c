@@ -25,9 +25,11 @@
 #define POW10_9 1000000000
 #include <Windows.h>
 #else
+#include <sys/mman.h>
 #include <sys/time.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <fcntl.h>
 #include <unistd.h>
 #include <errno.h>
 #endif
@@ -221,6 +223,81 @@ int ngli_get_filesize(const char *filename, int64_t *size)
     return 0;
 }
 
+int ngli_map_file(const char *filename, void **datap, size_t *sizep)
+{
+    *datap = NULL;
+    *sizep = 0;
+
+#ifdef _WIN32
+    HANDLE file_handle = CreateFile(TEXT(filename), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file_handle == INVALID_HANDLE_VALUE) {
+        LOG(ERROR, "could not open '%s'", filename);
+        return NGL_ERROR_IO;
+    }
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file_handle, &file_size) || !file_size.QuadPart || (uint64_t)file_size.QuadPart > SIZE_MAX) {
+        LOG(ERROR, "could not get a valid size for '%s'", filename);
+        CloseHandle(file_handle);
+        return NGL_ERROR_IO;
+    }
+
+    /* The view keeps a reference on the mapping and the file */
+    HANDLE mapping_handle = CreateFileMapping(file_handle, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file_handle);
+    if (!mapping_handle) {
+        LOG(ERROR, "could not map '%s'", filename);
+        return NGL_ERROR_IO;
+    }
+
+    void *data = MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping_handle);
+    if (!data) {
+        LOG(ERROR, "could not map '%s'", filename);
+        return NGL_ERROR_IO;
+    }
+
+    *datap = data;
+    *sizep = (size_t)file_size.QuadPart;
+#else
+    int fd = open(filename, O_RDONLY);
+    if (fd == -1) {
+        LOG(ERROR, "could not open '%s': %s", filename, strerror(errno));
+        return NGL_ERROR_IO;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) == -1 || st.st_size <= 0 || (uint64_t)st.st_size > SIZE_MAX) {
+        LOG(ERROR, "could not get a valid size for '%s'", filename);
+        close(fd);
+        return NGL_ERROR_IO;
+    }
+
+    /* The mapping remains valid after the file descriptor is closed */
+    void *data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        LOG(ERROR, "could not map '%s': %s", filename, strerror(errno));
+        return NGL_ERROR_IO;
+    }
+
+    *datap = data;
+    *sizep = (size_t)st.st_size;
+#endif
+    return 0;
+}
+
+void ngli_unmap_file(void *data, size_t size)
+{
+    if (!data)
+        return;
+#ifdef _WIN32
+    UnmapViewOfFile(data);
+#else
+    munmap(data, size);
+#endif
+}
+
 static int count_lines(const char *s)
 {
     int count = 0;
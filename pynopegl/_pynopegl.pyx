@@ -21,7 +21,7 @@
 #
 
 from cpython cimport array
-from libc.stdint cimport int32_t, uint8_t, uint32_t, uintptr_t
+from libc.stdint cimport int32_t, uint8_t, uint32_t, uint64_t, uintptr_t
 from libc.stdlib cimport calloc, free
 from libc.string cimport memset
 
@@ -35,6 +35,7 @@ cdef extern from "nopegl.h":
     cdef int NGL_LOG_QUIET
 
     void ngl_log_set_min_level(int level)
+    int ngl_log_set_async(int async)
 
     cdef struct ngl_node
 
@@ -66,6 +67,7 @@ cdef extern from "nopegl.h":
     int ngl_node_param_set_vec3(ngl_node *node, const char *key, const float *value)
     int ngl_node_param_set_vec4(ngl_node *node, const char *key, const float *value)
     int ngl_anim_evaluate(ngl_node *anim, void *dst, double t)
+    int ngl_anim_evaluate_batch(ngl_node *anim, void *dst, const double *times, size_t nb_times)
 
     cdef int NGL_PLATFORM_AUTO
     cdef int NGL_PLATFORM_XLIB
@@ -119,6 +121,7 @@ cdef extern from "nopegl.h":
         double duration
         int32_t framerate[2]
         int32_t aspect_ratio[2]
+        int dedup
 
     ngl_scene_params ngl_scene_default_params(ngl_node *root)
     ngl_scene *ngl_scene_create()
@@ -126,8 +129,11 @@ cdef extern from "nopegl.h":
     const ngl_scene_params *ngl_scene_get_params(const ngl_scene *s)
     int ngl_scene_get_filepaths(ngl_scene *s, char ***filepathsp, size_t *nb_filepathsp)
     int ngl_scene_update_filepath(ngl_scene *s, size_t index, const char *filepath)
+    int ngl_scene_begin_changes(ngl_scene *s)
+    int ngl_scene_commit_changes(ngl_scene *s)
     int ngl_scene_init_from_str(ngl_scene *s, const char *str)
     char *ngl_scene_serialize(const ngl_scene *scene)
+    int ngl_scene_serialize_fd(const ngl_scene *scene, int fd)
     char *ngl_scene_dot(const ngl_scene *scene)
     void ngl_scene_unrefp(ngl_scene **sp)
 
@@ -157,6 +163,34 @@ cdef extern from "nopegl.h":
         int hud_refresh_rate[2]
         const char *hud_export_filename
         int hud_scale
+        uint64_t gpu_memory_budget
+        int anim_bake_rate[2]
+        int stats
+        int lazy_init
+        int specialize_uniforms
+
+    cdef struct ngl_memory_usage:
+        uint64_t gpu_memory
+        uint64_t gpu_memory_resident
+        uint64_t gpu_memory_budget
+
+    cdef struct ngl_stats:
+        int64_t cpu_update_time
+        int64_t cpu_draw_time
+        int64_t gpu_draw_time
+        uint64_t nb_draws
+        uint64_t nb_dispatches
+        uint64_t nb_pipeline_binds
+        uint64_t nb_render_passes
+        uint64_t upload_size
+        uint64_t nb_prefetches
+        uint64_t nb_nodes
+        uint64_t nb_nodes_initialized
+        uint64_t nb_nodes_ready
+        uint64_t nb_nodes_active
+        uint64_t nb_nodes_resident
+        uint64_t texture_memory
+        uint64_t buffer_memory
 
     cdef union ngl_livectl_data:
         float f[4]
@@ -182,6 +216,9 @@ cdef extern from "nopegl.h":
     void ngl_reset_backend(ngl_backend *backend)
     int ngl_resize(ngl_ctx *s, int32_t width, int32_t height)
     int ngl_get_viewport(ngl_ctx *s, int32_t *viewport)
+    int ngl_get_memory_usage(ngl_ctx *s, ngl_memory_usage *usage)
+    int ngl_get_node_memory_usage(ngl_ctx *s, const ngl_node *node, uint64_t *gpu_memory)
+    int ngl_get_stats(ngl_ctx *s, ngl_stats *stats)
     int ngl_set_capture_buffer(ngl_ctx *s, void *capture_buffer)
     int ngl_set_scene(ngl_ctx *s, ngl_scene *scene)
     int ngl_draw(ngl_ctx *s, double t) nogil
@@ -248,6 +285,7 @@ cdef _ret_pystr(char *s):
 include "nodes_def.pyx"
 
 log_set_min_level = ngl_log_set_min_level
+log_set_async = ngl_log_set_async
 
 
 cdef class _Node:
@@ -379,6 +417,22 @@ cdef class _Node:
         ngl_anim_evaluate(self.ctx, vec, t)
         return (vec[0], vec[1], vec[2], vec[3])
 
+    def _eval_batch(self, times, size_t nb_comps):
+        cdef array.array times_c
+        if isinstance(times, array.array) and times.typecode == 'd':
+            times_c = times
+        else:
+            times_c = array.array('d', times)
+        cdef size_t nb_times = len(times_c)
+        cdef array.array values = array.clone(array.array('f'), nb_times * nb_comps, zero=False)
+        # The GIL is kept: the evaluation state (key frame cursor and lazy key
+        # frames initialization) is stored in the node and can not be shared
+        # between concurrent evaluations
+        ret = ngl_anim_evaluate_batch(self.ctx, values.data.as_floats, times_c.data.as_doubles, nb_times)
+        if ret < 0:
+            raise Exception('Error evaluating animation')
+        return values
+
     def _param_add_f64s(self, const char *key, size_t nb_f64s, f64s):
         f64s_c = <double *>calloc(nb_f64s, sizeof(double))
         if f64s_c is NULL:
@@ -531,7 +585,7 @@ cdef class Scene:
             raise MemoryError()
 
     @classmethod
-    def from_params(cls, _Node root, duration, framerate, aspect_ratio):
+    def from_params(cls, _Node root, duration, framerate, aspect_ratio, dedup):
         scene = cls()
         cdef uintptr_t sptr = scene.cptr
         cdef ngl_scene *scenep = <ngl_scene *>sptr
@@ -545,6 +599,7 @@ cdef class Scene:
         if framerate is not None:
             params.framerate[0] = framerate[0]
             params.framerate[1] = framerate[1]
+        params.dedup = dedup
         cdef int ret = ngl_scene_init(scenep, &params)
         if ret < 0:
             raise Exception("unable to initialize scene")
@@ -567,6 +622,9 @@ cdef class Scene:
     def serialize(self):
         return _ret_pystr(ngl_scene_serialize(self.ctx))
 
+    def serialize_fd(self, int fd):
+        return ngl_scene_serialize_fd(self.ctx, fd)
+
     def dot(self):
         return _ret_pystr(ngl_scene_dot(self.ctx))
 
@@ -575,6 +633,12 @@ cdef class Scene:
         if ret < 0:
             raise Exception(f'unable to update filepath at index {index} with "{filepath}"')
 
+    def begin_changes(self):
+        return ngl_scene_begin_changes(self.ctx)
+
+    def commit_changes(self):
+        return ngl_scene_commit_changes(self.ctx)
+
     @property
     def duration(self):
         assert self.ctx != NULL, "Scene not initialized"
@@ -652,6 +716,11 @@ cdef class Config:
         hud_refresh_rate,
         hud_export_filename,
         hud_scale,
+        gpu_memory_budget,
+        anim_bake_rate,
+        stats,
+        lazy_init,
+        specialize_uniforms,
     ):
         self.config.platform = platform.value
         self.config.backend = backend.value
@@ -679,6 +748,12 @@ cdef class Config:
         if hud_export_filename is not None:
             self.config.hud_export_filename = hud_export_filename
         self.config.hud_scale = hud_scale
+        self.config.gpu_memory_budget = gpu_memory_budget
+        self.config.anim_bake_rate[0] = anim_bake_rate[0]
+        self.config.anim_bake_rate[1] = anim_bake_rate[1]
+        self.config.stats = stats
+        self.config.lazy_init = lazy_init
+        self.config.specialize_uniforms = specialize_uniforms
 
     @property
     def cptr(self):
@@ -729,6 +804,31 @@ cdef class Context:
             raise Exception("Error getting the viewport")
         return tuple(v for v in vp)
 
+    def get_memory_usage(self):
+        cdef ngl_memory_usage usage
+        cdef int ret = ngl_get_memory_usage(self.ctx, &usage)
+        if ret < 0:
+            raise Exception("Error getting the memory usage")
+        return dict(
+            gpu_memory=usage.gpu_memory,
+            gpu_memory_resident=usage.gpu_memory_resident,
+            gpu_memory_budget=usage.gpu_memory_budget,
+        )
+
+    def get_node_memory_usage(self, _Node node):
+        cdef uint64_t gpu_memory = 0
+        cdef int ret = ngl_get_node_memory_usage(self.ctx, node.ctx, &gpu_memory)
+        if ret < 0:
+            raise Exception("Error getting the node memory usage")
+        return gpu_memory
+
+    def get_stats(self):
+        cdef ngl_stats stats
+        cdef int ret = ngl_get_stats(self.ctx, &stats)
+        if ret < 0:
+            raise Exception("Error getting the stats")
+        return stats
+
     def set_capture_buffer(self, capture_buffer):
         self.capture_buffer = capture_buffer
         cdef uint8_t *ptr = NULL
@@ -100,6 +100,10 @@ def log_set_min_level(level: Log):
     return _ngl.log_set_min_level(level.value)
 
 
+def log_set_async(enabled: bool) -> int:
+    return _ngl.log_set_async(enabled)
+
+
 class ConfigGL(_ngl.ConfigGL):
     def __init__(self, external: bool = False, external_framebuffer: int = 0):
         super().__init__(external, external_framebuffer)
@@ -127,6 +131,11 @@ class Config(_ngl.Config):
         hud_refresh_rate: Tuple[int, int] = (0, 0),
         hud_export_filename: Optional[str] = None,
         hud_scale: int = 0,
+        gpu_memory_budget: int = 0,
+        anim_bake_rate: Tuple[int, int] = (0, 0),
+        stats: bool = False,
+        lazy_init: bool = False,
+        specialize_uniforms: bool = False,
     ):
         self.capture_buffer = capture_buffer
         super().__init__(
@@ -149,6 +158,11 @@ class Config(_ngl.Config):
             hud_refresh_rate,
             hud_export_filename,
             hud_scale,
+            gpu_memory_budget,
+            anim_bake_rate,
+            stats,
+            lazy_init,
+            specialize_uniforms,
         )
 
 
@@ -233,8 +247,9 @@ class Scene(_ngl.Scene):
         duration: Optional[float] = None,
         framerate: Optional[Tuple[int, int]] = None,
         aspect_ratio: Optional[Tuple[int, int]] = None,
+        dedup: bool = False,
     ) -> "Scene":
-        return super().from_params(root, duration, framerate, aspect_ratio)
+        return super().from_params(root, duration, framerate, aspect_ratio, dedup)
 
     @classmethod
     def from_string(cls, s: Union[str, bytes]) -> "Scene":
@@ -243,12 +258,21 @@ class Scene(_ngl.Scene):
     def serialize(self) -> bytes:
         return super().serialize()
 
+    def serialize_fd(self, fd: int) -> int:
+        return super().serialize_fd(fd)
+
     def dot(self) -> bytes:
         return super().dot()
 
     def update_filepath(self, index: int, filepath: str):
         super().update_filepath(index, filepath)
 
+    def begin_changes(self) -> int:
+        return super().begin_changes()
+
+    def commit_changes(self) -> int:
+        return super().commit_changes()
+
     @property
     def duration(self) -> float:
         return super().duration
@@ -281,6 +305,15 @@ class Context(_ngl.Context):
     def viewport(self) -> Tuple[int, int, int, int]:
         return super().get_viewport()
 
+    def get_memory_usage(self) -> Dict[str, int]:
+        return super().get_memory_usage()
+
+    def get_node_memory_usage(self, node: Node) -> int:
+        return super().get_node_memory_usage(node)
+
+    def get_stats(self) -> Dict[str, int]:
+        return super().get_stats()
+
     def set_capture_buffer(self, capture_buffer: Optional[bytearray]) -> int:
         return super().set_capture_buffer(capture_buffer)
 
@@ -324,6 +357,11 @@ def easing_solve(
     return _ngl.animate(name, v, args, offsets, _ngl.ANIM_SOLVE)
 
 
+def anims_evaluate(anims: Sequence[Node], times: Sequence[float]) -> List[array.array]:
+    times = array.array("d", times)
+    return [anim.evaluate_batch(times) for anim in anims]
+
+
 def get_livectls(scene: Node) -> Mapping[str, Mapping[str, Any]]:
     return _ngl.get_livectls(scene)
 
@@ -221,16 +221,24 @@ class _WrapperGenerator:
             VelocityVec2="vec2",
             VelocityVec3="vec3",
             VelocityVec4="vec4",
+            NoiseFloat="f32",
+            NoiseVec2="vec2",
+            NoiseVec3="vec3",
+            NoiseVec4="vec4",
         )
 
         eval_type = animated_nodes.get(class_name)
         if not eval_type:
             return ""
         ret_type = cls._TYPING_MAP[eval_type]
+        nb_comps = dict(f32=1, vec2=2, vec3=3, vec4=4)[eval_type]
         return textwrap.dedent(
             f"""
             def evaluate(self, t: float) -> {ret_type}:
                 return self._eval_{eval_type}(t)
+
+            def evaluate_batch(self, times: Sequence[float]) -> array.array:
+                return self._eval_batch(times, {nb_comps})
             """
         )
 
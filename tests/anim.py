@@ -215,6 +215,11 @@ def _get_anim_func(size, animated_type, kf_func, velocity_type=None):
 
             if hasattr(values[0], "__iter__"):
                 values = list(itertools.chain(*values))
+
+            # The batch evaluation must match the individual queries
+            times = [(t_id + 1) * scale for t_id in range(nb_queries)] + [0, 1, 5]
+            assert list(anim.evaluate_batch(times)) == values
+
             ret.append(("off%d" % i, values))
 
         return ret
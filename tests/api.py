@@ -19,6 +19,7 @@
 # under the License.
 #
 
+import array
 import atexit
 import csv
 import locale
@@ -277,6 +278,178 @@ def api_scene_files():
     assert any(filepath == new_ref for filepath in scene.files)
 
 
+def api_scene_dedup(width=16, height=16):
+    def _get_root():
+        return ngl.Group(
+            children=[
+                ngl.DrawColor(geometry=ngl.Quad()),
+                ngl.DrawColor(geometry=ngl.Quad(), color=(1, 0, 0)),
+                ngl.DrawColor(geometry=ngl.Quad(corner=(-1, -1, 0))),
+            ]
+        )
+
+    def _count_quads(scene):
+        return sum(line.startswith(b"Quad") for line in scene.serialize().splitlines())
+
+    assert _count_quads(ngl.Scene.from_params(_get_root())) == 3
+
+    # The first 2 quads are identical and must be merged
+    scene = ngl.Scene.from_params(_get_root(), dedup=True)
+    assert _count_quads(scene) == 2
+
+    ctx = ngl.Context()
+    ret = ctx.configure(ngl.Config(offscreen=True, width=width, height=height, backend=_backend))
+    assert ret == 0
+    assert ctx.set_scene(scene) == 0
+    assert ctx.draw(0) == 0
+
+
+def api_scene_serialize_fd():
+    vertices = ngl.BufferVec3(data=array.array("f", [-1, -1, 0, 1, -1, 0, 0, 0.5, 0]))
+    shared = ngl.DrawColor(color=(1, 0.5, 0.25), geometry=ngl.Geometry(vertices=vertices))
+    animkf = [
+        ngl.AnimKeyFrameVec3(0, (0, 0, 0)),
+        ngl.AnimKeyFrameVec3(1, (0.5, -0.25, 1.0), "exp_in"),
+    ]
+    moving = ngl.Translate(shared, vector=ngl.AnimatedVec3(animkf))
+    root = ngl.Group(children=[shared, moving], label="root")
+    scene = ngl.Scene.from_params(ngl.Group(children=[root, ngl.Group(children=[root, moving])]))
+    ref = scene.serialize()
+
+    with tempfile.TemporaryFile() as f:
+        assert scene.serialize_fd(f.fileno()) == 0
+        f.seek(0)
+        out = f.read()
+    assert out == ref
+
+    # The streamed output must be deserializable into the exact same scene
+    scene2 = ngl.Scene.from_string(out)
+    assert scene2.serialize() == ref
+
+    # Serializing twice must not be affected by the ids assigned previously
+    assert scene.serialize() == ref
+
+    assert scene.serialize_fd(-1) < 0
+
+
+def _deserialize_fails(data):
+    try:
+        ngl.Scene.from_string(data)
+    except Exception:
+        return True
+    return False
+
+
+def _corrupt_serialized_scene(data, node_index, old, new):
+    lines = data.split(b"\n")
+    node_lines = [i for i, line in enumerate(lines) if line and not line.startswith(b"#")]
+    i = node_lines[node_index]
+    assert old in lines[i]
+    lines[i] = lines[i].replace(old, new, 1)
+    return b"\n".join(lines)
+
+
+def _get_deserialize_scene(nb_draws, nb_vertices):
+    draws = []
+    for i in range(nb_draws):
+        vertices = array.array("f", [random.uniform(-1, 1) for _ in range(nb_vertices * 3)])
+        geometry = ngl.Geometry(vertices=ngl.BufferVec3(data=vertices))
+        draws.append(ngl.DrawColor(color=(1, i / nb_draws, 0.5), geometry=geometry))
+    return ngl.Scene.from_params(ngl.Group(children=draws))
+
+
+def api_scene_deserialize_single_chunk():
+    data = _get_deserialize_scene(nb_draws=4, nb_vertices=3).serialize()
+    assert ngl.Scene.from_string(data).serialize() == data
+
+    # Unknown parameter and unknown node type in the last nodes
+    assert _deserialize_fails(_corrupt_serialized_scene(data, -2, b"color:", b"colour:"))
+    assert _deserialize_fails(_corrupt_serialized_scene(data, -2, b"Dclr", b"XXXX"))
+
+
+def api_scene_deserialize_threaded():
+    # Large enough for the parameters to be parsed on several threads
+    random.seed(0)
+    data = _get_deserialize_scene(nb_draws=32, nb_vertices=2048).serialize()
+    assert len(data) > 1 << 20
+    assert ngl.Scene.from_string(data).serialize() == data
+
+    # Malformed parameters far from the first chunk of nodes
+    assert _deserialize_fails(_corrupt_serialized_scene(data, -2, b"color:", b"colour:"))
+    assert _deserialize_fails(_corrupt_serialized_scene(data, -4, b"data:", b"dada:"))
+    assert _deserialize_fails(_corrupt_serialized_scene(data, -2, b"Dclr", b"XXXX"))
+
+
+def api_scene_changes(width=16, height=16):
+    capture_buffer = bytearray(width * height * 4)
+
+    # The left draw color is a uniform scoped parameter, while the right color
+    # is a uniform node invalidating its branch
+    draw = ngl.DrawColor(color=(1, 0, 0), geometry=ngl.Quad((-1, -1, 0), (1, 0, 0), (0, 2, 0)))
+    vert = "void main() { ngl_out_pos = ngl_projection_matrix * ngl_modelview_matrix * vec4(ngl_position, 1.0); }"
+    frag = "void main() { ngl_out_color = color; }"
+    color = ngl.UniformVec4(value=(1, 0, 0, 1))
+    right = ngl.Draw(ngl.Quad((0, -1, 0), (1, 0, 0), (0, 2, 0)), ngl.Program(vertex=vert, fragment=frag))
+    right.update_frag_resources(color=color)
+    scene = ngl.Scene.from_params(ngl.Group(children=(draw, right)))
+
+    # Batching is not possible without an explicit begin, and can not be nested
+    assert scene.commit_changes() != 0
+    assert scene.begin_changes() == 0
+    assert scene.begin_changes() != 0
+    assert scene.commit_changes() == 0
+
+    ctx = ngl.Context()
+    ret = ctx.configure(
+        ngl.Config(offscreen=True, width=width, height=height, backend=_backend, capture_buffer=capture_buffer)
+    )
+    assert ret == 0
+    assert ctx.set_scene(scene) == 0
+
+    def _get_pixels():
+        left_pos = (height // 2 * width + width // 4) * 4
+        right_pos = (height // 2 * width + width * 3 // 4) * 4
+        return tuple(capture_buffer[left_pos : left_pos + 4]), tuple(capture_buffer[right_pos : right_pos + 4])
+
+    red = (0xFF, 0x00, 0x00, 0xFF)
+    green = (0x00, 0xFF, 0x00, 0xFF)
+    blue = (0x00, 0x00, 0xFF, 0xFF)
+
+    assert ctx.draw(0) == 0
+    assert _get_pixels() == (red, red)
+
+    # Several changes on the same node (and the same parameter) are applied
+    # together, and none of them is visible before the commit
+    assert scene.begin_changes() == 0
+    assert draw.set_color((0, 0, 1)) == 0
+    assert draw.set_opacity(0.0) == 0
+    assert draw.set_color((0, 1, 0)) == 0
+    assert draw.set_opacity(1.0) == 0
+    assert draw.set_opacity(ngl.UniformFloat()) != 0  # structural changes are still refused
+    assert color.set_value((0, 0, 1, 1)) == 0
+    assert ctx.draw(1) == 0
+    assert _get_pixels() == (red, red)
+    assert scene.commit_changes() == 0
+    assert ctx.draw(1) == 0
+    assert _get_pixels() == (green, blue)
+
+    # A uniform scoped change alone behaves the same
+    assert scene.begin_changes() == 0
+    assert draw.set_color((0, 0, 1)) == 0
+    assert ctx.draw(2) == 0
+    assert _get_pixels() == (green, blue)
+    assert scene.commit_changes() == 0
+    assert ctx.draw(2) == 0
+    assert _get_pixels() == (blue, blue)
+
+    # Changes queued while the scene is released must not leak
+    assert scene.begin_changes() == 0
+    assert draw.set_color((1, 1, 1)) == 0
+    assert ctx.set_scene(None) == 0
+    del scene
+    del ctx
+
+
 def api_capture_buffer_lifetime(width=1024, height=1024):
     capture_buffer = bytearray(width * height * 4)
     ctx = ngl.Context()
@@ -588,6 +761,596 @@ def api_trf_seek_keep_alive(width=320, height=240):
     assert ctx.draw(end) == 0
 
 
+def api_trf_seek_lazy_init(width=320, height=240):
+    """
+    Same as api_trf_seek_keep_alive() but with the time filtered branches
+    being initialized on their first activation.
+    """
+    ctx = ngl.Context()
+    ret = ctx.configure(ngl.Config(offscreen=True, width=width, height=height, backend=_backend, lazy_init=True))
+    assert ret == 0
+
+    start = 0.0
+    end = 10.0
+    scene = _create_trf_scene(start, end, True)
+    ret = ctx.set_scene(scene)
+    assert ret == 0
+
+    assert ctx.draw(end) == 0
+    assert ctx.draw(start) == 0
+    assert ctx.draw(end) == 0
+
+
+def api_lazy_init_fail(width=320, height=240):
+    ctx = ngl.Context()
+    ret = ctx.configure(ngl.Config(offscreen=True, width=width, height=height, backend=_backend, lazy_init=True))
+    assert ret == 0
+
+    draw = ngl.Draw(ngl.Quad(), ngl.Program(vertex="<bug>", fragment="<bug>"))
+    trf = ngl.TimeRangeFilter(draw, start=5, end=6, prefetch_time=1)
+    scene = ngl.Scene.from_params(ngl.Group(children=[ngl.DrawColor(), trf]))
+
+    # The broken branch is only initialized when it enters its prefetch window
+    assert ctx.set_scene(scene) == 0
+    assert ctx.draw(0) == 0
+    assert ctx.draw(4.5) != 0
+    assert ctx.draw(4.5) != 0  # another try to make sure the state stays consistent
+    assert ctx.draw(0) == 0
+    assert ctx.set_scene(None) == 0
+
+
+def api_lazy_init_siblings(width=16, height=16):
+    capture_buffer = bytearray(width * height * 4)
+    ctx = ngl.Context()
+    ret = ctx.configure(
+        ngl.Config(
+            offscreen=True,
+            width=width,
+            height=height,
+            backend=_backend,
+            capture_buffer=capture_buffer,
+            lazy_init=True,
+        )
+    )
+    assert ret == 0
+
+    left = ngl.Quad((-1, -1, 0), (1, 0, 0), (0, 2, 0))
+    right = ngl.Quad((0, -1, 0), (1, 0, 0), (0, 2, 0))
+    draw = ngl.DrawColor(color=(1, 1, 1), geometry=left)
+    broken = ngl.Draw(left, ngl.Program(vertex="<bug>", fragment="<bug>"))
+    trf = ngl.TimeRangeFilter(ngl.Group(children=[draw]), start=2, end=3, prefetch_time=0)
+    trf_broken = ngl.TimeRangeFilter(broken, start=4, end=5, prefetch_time=0)
+
+    # The deferred branches are prepared with the graphic state recorded when
+    # their parent was prepared, and must not alter the sibling render paths
+    gc = ngl.GraphicConfig(ngl.Group(children=[trf, trf_broken]), color_write_mask="r")
+    sibling = ngl.DrawColor(color=(1, 1, 1), geometry=right)
+    assert ctx.set_scene(ngl.Scene.from_params(ngl.Group(children=[gc, sibling]))) == 0
+
+    def _get_pixels():
+        pos = height // 2 * width * 4
+        left_pos = pos + width // 4 * 4
+        right_pos = pos + width * 3 // 4 * 4
+        return tuple(capture_buffer[left_pos : left_pos + 4]), tuple(capture_buffer[right_pos : right_pos + 4])
+
+    black = (0x00, 0x00, 0x00, 0xFF)
+    red = (0xFF, 0x00, 0x00, 0xFF)
+    white = (0xFF, 0xFF, 0xFF, 0xFF)
+
+    assert ctx.draw(0) == 0
+    assert _get_pixels() == (black, white)
+    assert ctx.draw(2.5) == 0
+    assert _get_pixels() == (red, white)
+
+    # A failed attach must only roll back its own render paths
+    assert ctx.draw(4.5) != 0
+    assert ctx.draw(4.5) != 0
+    assert ctx.draw(2.5) == 0
+    assert _get_pixels() == (red, white)
+    assert ctx.draw(0) == 0
+    assert _get_pixels() == (black, white)
+    assert ctx.set_scene(None) == 0
+
+
+def api_lazy_init_child_fail(width=16, height=16):
+    capture_buffer = bytearray(width * height * 4)
+    ctx = ngl.Context()
+    ret = ctx.configure(
+        ngl.Config(
+            offscreen=True,
+            width=width,
+            height=height,
+            backend=_backend,
+            capture_buffer=capture_buffer,
+            lazy_init=True,
+        )
+    )
+    assert ret == 0
+
+    # The second child fails during its initialization, before any of the
+    # deferred children gets prepared
+    left = ngl.Quad((-1, -1, 0), (1, 0, 0), (0, 2, 0))
+    right = ngl.Quad((0, -1, 0), (1, 0, 0), (0, 2, 0))
+    draw = ngl.DrawColor(color=(1, 1, 1), geometry=left)
+    broken = ngl.DrawColor(color=ngl.EvalVec3("1 +"), geometry=left)
+    trf = ngl.TimeRangeFilter(ngl.Group(children=[draw, broken]), start=2, end=3, prefetch_time=0)
+    sibling = ngl.DrawColor(color=(1, 1, 1), geometry=right)
+    assert ctx.set_scene(ngl.Scene.from_params(ngl.Group(children=[trf, sibling]))) == 0
+
+    def _get_pixels():
+        pos = height // 2 * width * 4
+        left_pos = pos + width // 4 * 4
+        right_pos = pos + width * 3 // 4 * 4
+        return tuple(capture_buffer[left_pos : left_pos + 4]), tuple(capture_buffer[right_pos : right_pos + 4])
+
+    black = (0x00, 0x00, 0x00, 0xFF)
+    white = (0xFF, 0xFF, 0xFF, 0xFF)
+
+    assert ctx.draw(0) == 0
+    assert _get_pixels() == (black, white)
+    assert ctx.draw(2.5) != 0
+    assert ctx.draw(2.5) != 0  # another try to make sure the state stays consistent
+    assert ctx.draw(0) == 0
+    assert _get_pixels() == (black, white)
+    assert ctx.set_scene(None) == 0
+
+
+def api_specialize_uniforms(width=16, height=16):
+    capture_buffer = bytearray(width * height * 4)
+    ctx = ngl.Context()
+    ret = ctx.configure(
+        ngl.Config(
+            offscreen=True,
+            width=width,
+            height=height,
+            backend=_backend,
+            capture_buffer=capture_buffer,
+            specialize_uniforms=True,
+        )
+    )
+    assert ret == 0
+
+    vert = "void main() { ngl_out_pos = ngl_projection_matrix * ngl_modelview_matrix * vec4(ngl_position, 1.0); }"
+    frag = "void main() { ngl_out_color = color * scale; }"
+    color = ngl.UniformVec4(value=(1, 0, 0, 1))
+    scale = ngl.UniformFloat(value=1, live_id="scale")  # live controls are not specialized
+    draw = ngl.Draw(ngl.Quad((-1, -1, 0), (2, 0, 0), (0, 2, 0)), ngl.Program(vertex=vert, fragment=frag))
+    draw.update_frag_resources(color=color, scale=scale)
+    assert ctx.set_scene(ngl.Scene.from_params(draw)) == 0
+
+    def _get_center_pixel():
+        pos = (height // 2 * width + width // 2) * 4
+        return tuple(capture_buffer[pos : pos + 4])
+
+    assert ctx.draw(0) == 0
+    assert _get_center_pixel() == (0xFF, 0x00, 0x00, 0xFF)
+
+    # Changing a specialized value must craft the pipeline again
+    assert color.set_value((0, 0, 1, 1)) == 0
+    assert ctx.draw(1) == 0
+    assert _get_center_pixel() == (0x00, 0x00, 0xFF, 0xFF)
+
+    assert scale.set_value(0) == 0
+    assert ctx.draw(2) == 0
+    assert _get_center_pixel() == (0x00, 0x00, 0x00, 0x00)
+
+    # Non-integer values must be inlined exactly, whatever the locale
+    prev_locale = locale.setlocale(locale.LC_ALL)
+    try:
+        locale.setlocale(locale.LC_ALL, "fr_FR.UTF-8")
+    except locale.Error:
+        print("unable to set french locale")
+    try:
+        assert scale.set_value(1) == 0
+        assert color.set_value((0.25, 0.5, 0.75, 1)) == 0
+        assert ctx.draw(3) == 0
+    finally:
+        locale.setlocale(locale.LC_ALL, prev_locale)
+    expected = (0x40, 0x80, 0xBF, 0xFF)
+    assert all(abs(a - b) <= 1 for a, b in zip(_get_center_pixel(), expected)), _get_center_pixel()
+
+
+def api_uniform_updates(width=16, height=16):
+    capture_buffer = bytearray(width * height * 4)
+    ctx = ngl.Context()
+    ret = ctx.configure(
+        ngl.Config(offscreen=True, width=width, height=height, backend=_backend, capture_buffer=capture_buffer)
+    )
+    assert ret == 0
+
+    vert = """
+void main()
+{
+    ngl_out_pos = ngl_projection_matrix * ngl_modelview_matrix * vec4(ngl_position, 1.0);
+    var_normal = ngl_normal_matrix * vec3(1.0, 0.0, 0.0);
+}
+"""
+    frag = "void main() { ngl_out_color = vec4(abs(var_normal) * color, 1.0); }"
+    program = ngl.Program(vertex=vert, fragment=frag)
+    program.update_vert_out_vars(var_normal=ngl.IOVec3())
+    color = ngl.UniformVec3(value=(1, 1, 1), live_id="color")
+    draw = ngl.Draw(ngl.Quad((-1, -1, 0), (2, 0, 0), (0, 2, 0)), program)
+    draw.update_frag_resources(color=color)
+    rotate = ngl.Rotate(draw, axis=(0, 0, 1))
+    assert ctx.set_scene(ngl.Scene.from_params(rotate)) == 0
+
+    def _get_center_pixel():
+        pos = (height // 2 * width + width // 2) * 4
+        return tuple(capture_buffer[pos : pos + 4])
+
+    red = (0xFF, 0x00, 0x00, 0xFF)
+    green = (0x00, 0xFF, 0x00, 0xFF)
+    black = (0x00, 0x00, 0x00, 0xFF)
+
+    assert ctx.draw(0) == 0
+    assert _get_center_pixel() == red
+
+    # A uniform changed back to a previous value must still be uploaded
+    assert color.set_value((0, 0, 0)) == 0
+    assert ctx.draw(1) == 0
+    assert _get_center_pixel() == black
+    assert ctx.draw(2) == 0
+    assert _get_center_pixel() == black
+    assert color.set_value((1, 1, 1)) == 0
+    assert ctx.draw(3) == 0
+    assert _get_center_pixel() == red
+
+    # The normal matrix must follow the modelview matrix, back and forth
+    assert rotate.set_angle(90) == 0
+    assert ctx.draw(4) == 0
+    assert _get_center_pixel() == green
+    assert rotate.set_angle(0) == 0
+    assert ctx.draw(5) == 0
+    assert _get_center_pixel() == red
+
+
+def _check_push_constants_transform(width, height):
+    capture_buffer = bytearray(width * height * 4)
+    ctx = ngl.Context()
+    ret = ctx.configure(
+        ngl.Config(offscreen=True, width=width, height=height, backend=_backend, capture_buffer=capture_buffer)
+    )
+    assert ret == 0
+
+    vert = """
+void main()
+{
+    ngl_out_pos = ngl_projection_matrix * ngl_modelview_matrix * vec4(ngl_position, 1.0);
+    var_normal = ngl_normal_matrix * vec3(0.0, 0.0, 1.0);
+}
+"""
+    frag = "void main() { ngl_out_color = vec4(clamp(var_normal, 0.0, 1.0), 1.0); }"
+    program = ngl.Program(vertex=vert, fragment=frag)
+    program.update_vert_out_vars(var_normal=ngl.IOVec3())
+    draw = ngl.Draw(ngl.Quad((-1, -1, 0), (2, 0, 0), (0, 2, 0)), program)
+    # Only covers the right half of the viewport
+    scene = ngl.Translate(ngl.Scale(draw, factors=(0.5, 1, 1)), vector=(0.5, 0, 0))
+    assert ctx.set_scene(ngl.Scene.from_params(scene)) == 0
+    assert ctx.draw(0) == 0
+
+    pos = height // 2 * width * 4
+    left_pos = pos + width // 4 * 4
+    right_pos = pos + width * 3 // 4 * 4
+    assert tuple(capture_buffer[left_pos : left_pos + 4]) == (0x00, 0x00, 0x00, 0xFF)
+    assert tuple(capture_buffer[right_pos : right_pos + 4]) == (0x00, 0x00, 0xFF, 0xFF)
+    assert ctx.set_scene(None) == 0
+
+
+def api_push_constants(width=16, height=16):
+    # Device limit, then only the modelview matrix fitting, then no push constant at all
+    for max_size in (None, "64", "0"):
+        if max_size is not None:
+            os.environ["NGL_MAX_PUSH_CONSTANTS_SIZE"] = max_size
+        try:
+            _check_push_constants_transform(width, height)
+        finally:
+            os.environ.pop("NGL_MAX_PUSH_CONSTANTS_SIZE", None)
+
+
+def api_dynamic_buffers(width=16, height=16):
+    capture_buffer = bytearray(width * height * 4)
+    ctx = ngl.Context()
+    ret = ctx.configure(
+        ngl.Config(offscreen=True, width=width, height=height, backend=_backend, capture_buffer=capture_buffer)
+    )
+    assert ret == 0
+
+    # The vertices and the block are updated on every frame, over more frames
+    # than the number of regions the OpenGL dynamic buffers rotate through
+    nb_frames = 8
+    halves = [
+        array.array("f", [-1, -1, 0, 0, -1, 0, -1, 1, 0, 0, 1, 0]),
+        array.array("f", [0, -1, 0, 1, -1, 0, 0, 1, 0, 1, 1, 0]),
+    ]
+    colors = [(1, 0, 0), (0, 1, 0), (0, 0, 1)]
+    vertices_kfs = [ngl.AnimKeyFrameBuffer(t, halves[t % 2]) for t in range(nb_frames)]
+    color_kfs = [ngl.AnimKeyFrameColor(t, colors[t % 3]) for t in range(nb_frames)]
+    vertices = ngl.AnimatedBufferVec3(vertices_kfs)
+    block = ngl.Block(fields=[ngl.AnimatedColor(color_kfs, label="color")], layout="std140")
+    geometry = ngl.Geometry(vertices=vertices, topology="triangle_strip")
+    program = ngl.Program(
+        vertex="void main() { ngl_out_pos = ngl_projection_matrix * ngl_modelview_matrix * vec4(ngl_position, 1.0); }",
+        fragment="void main() { ngl_out_color = vec4(data.color, 1.0); }",
+    )
+    draw = ngl.Draw(geometry, program)
+    draw.update_frag_resources(data=block)
+    assert ctx.set_scene(ngl.Scene.from_params(draw)) == 0
+
+    black = (0x00, 0x00, 0x00, 0xFF)
+    pos = height // 2 * width * 4
+    left_pos = pos + width // 4 * 4
+    right_pos = pos + width * 3 // 4 * 4
+    for t in range(nb_frames):
+        assert ctx.draw(t) == 0
+        color = tuple(c * 0xFF for c in colors[t % 3]) + (0xFF,)
+        expected = (color, black) if t % 2 == 0 else (black, color)
+        pixels = tuple(capture_buffer[left_pos : left_pos + 4]), tuple(capture_buffer[right_pos : right_pos + 4])
+        assert pixels == expected, f"{t=}"
+
+
+def _get_memory_budget_scene(nb_branches):
+    textures = [ngl.Texture2D(width=64, height=64) for i in range(nb_branches)]
+    trfs = [_create_trf(ngl.DrawTexture(texture=t), i, i + 1, prefetch_time=0) for i, t in enumerate(textures)]
+    return ngl.Scene.from_params(ngl.Group(children=trfs)), textures
+
+
+def _get_memory_budget_ctx(width, height, budget):
+    ctx = ngl.Context()
+    ret = ctx.configure(
+        ngl.Config(offscreen=True, width=width, height=height, backend=_backend, gpu_memory_budget=budget)
+    )
+    assert ret == 0
+    return ctx
+
+
+def api_memory_usage(width=16, height=16):
+    texture_size = 64 * 64 * 4
+    ctx = _get_memory_budget_ctx(width, height, 0)
+    scene, textures = _get_memory_budget_scene(2)
+    assert ctx.set_scene(scene) == 0
+
+    assert ctx.draw(0.5) == 0
+    usage = ctx.get_memory_usage()
+    assert usage["gpu_memory"] >= texture_size
+    assert usage["gpu_memory_resident"] == 0
+    assert usage["gpu_memory_budget"] == 0
+    assert ctx.get_node_memory_usage(textures[0]) >= texture_size
+    assert ctx.get_node_memory_usage(textures[1]) == 0
+
+    # Without a budget, the inactive branch is released immediately
+    assert ctx.draw(1.5) == 0
+    assert ctx.get_memory_usage()["gpu_memory_resident"] == 0
+    assert ctx.get_node_memory_usage(textures[0]) == 0
+    assert ctx.get_node_memory_usage(textures[1]) >= texture_size
+
+    # A node which is not part of the scene is not associated with the context
+    try:
+        ctx.get_node_memory_usage(ngl.Texture2D())
+    except Exception:
+        pass
+    else:
+        assert False
+
+
+def api_memory_budget_eviction(width=16, height=16):
+    texture_size = 64 * 64 * 4
+    nb_branches = 4
+    times = [i + 0.5 for i in range(nb_branches)]
+
+    # Measure the memory of the branches, all kept resident with a large budget
+    ctx = _get_memory_budget_ctx(width, height, 1 << 40)
+    scene, textures = _get_memory_budget_scene(nb_branches)
+    assert ctx.set_scene(scene) == 0
+    for t in times:
+        assert ctx.draw(t) == 0
+    usage = ctx.get_memory_usage()
+    total_memory = usage["gpu_memory"]
+    branch_memory = usage["gpu_memory_resident"] // (nb_branches - 1)
+    assert branch_memory >= texture_size
+    for texture in textures:
+        assert ctx.get_node_memory_usage(texture) >= texture_size
+    del ctx
+
+    # Leave room for only one resident branch: the two oldest must be evicted
+    budget = total_memory - branch_memory - branch_memory // 2
+    ctx = _get_memory_budget_ctx(width, height, budget)
+    scene, textures = _get_memory_budget_scene(nb_branches)
+    assert ctx.set_scene(scene) == 0
+    for t in times:
+        assert ctx.draw(t) == 0
+    usage = ctx.get_memory_usage()
+    assert usage["gpu_memory"] <= budget
+    assert usage["gpu_memory_resident"] > 0
+    assert [ctx.get_node_memory_usage(texture) > 0 for texture in textures] == [False, False, True, True]
+
+    # Coming back to the first branch makes the last one resident, so the
+    # least recently used one is evicted
+    assert ctx.draw(times[0]) == 0
+    assert ctx.get_memory_usage()["gpu_memory"] <= budget
+    assert [ctx.get_node_memory_usage(texture) > 0 for texture in textures] == [True, False, False, True]
+
+
+def api_stats(width=16, height=16):
+    ctx = ngl.Context()
+    ret = ctx.configure(ngl.Config(offscreen=True, width=width, height=height, backend=_backend, stats=True))
+    assert ret == 0
+
+    draws = [ngl.DrawColor(color=(1, 0, 0)), ngl.DrawColor(color=(0, 1, 0))]
+    root = ngl.Group(children=draws)
+    assert ctx.set_scene(ngl.Scene.from_params(root)) == 0
+
+    # The counters are reset for every frame
+    for t in range(2):
+        assert ctx.draw(t) == 0
+        stats = ctx.get_stats()
+        assert stats["nb_draws"] == 2
+        assert stats["nb_dispatches"] == 0
+        assert stats["nb_pipeline_binds"] >= 2
+        assert stats["nb_render_passes"] >= 1
+        assert stats["cpu_update_time"] >= 0
+        assert stats["cpu_draw_time"] >= 0
+        assert stats["nb_nodes"] >= 3
+        assert stats["nb_nodes_ready"] == stats["nb_nodes"]
+        assert stats["nb_nodes_active"] == stats["nb_nodes"]
+        assert stats["nb_nodes_resident"] == 0
+
+
+def _get_anim_bake_captures(width, height, bake_rate, times):
+    capture_buffer = bytearray(width * height * 4)
+    ctx = ngl.Context()
+    ret = ctx.configure(
+        ngl.Config(
+            offscreen=True,
+            width=width,
+            height=height,
+            backend=_backend,
+            capture_buffer=capture_buffer,
+            anim_bake_rate=bake_rate,
+        )
+    )
+    assert ret == 0
+
+    color_kfs = [
+        ngl.AnimKeyFrameColor(0.5, (1, 0, 0)),
+        ngl.AnimKeyFrameColor(1.5, (0, 1, 0), "exp_in"),
+        ngl.AnimKeyFrameColor(2.5, (0, 0.5, 1), "bounce_out"),
+    ]
+    quat_kfs = [
+        ngl.AnimKeyFrameQuat(0.5, (0, 0, 0, 1)),
+        ngl.AnimKeyFrameQuat(1.5, (0, 0, math.sin(math.pi / 6), math.cos(math.pi / 6)), "circular_in_out"),
+        ngl.AnimKeyFrameQuat(2.5, (0, 0, math.sin(math.pi / 3), math.cos(math.pi / 3)), "back_in"),
+    ]
+    quad = ngl.Quad((-0.5, -0.5, 0), (1, 0, 0), (0, 1, 0))
+    draw = ngl.DrawColor(color=ngl.AnimatedColor(color_kfs), geometry=quad)
+    trf = ngl.Transform(draw, matrix=ngl.AnimatedQuat(quat_kfs, as_mat4=True))
+    assert ctx.set_scene(ngl.Scene.from_params(trf)) == 0
+
+    captures = []
+    for t in times:
+        assert ctx.draw(t) == 0
+        captures.append(bytes(capture_buffer))
+    return captures
+
+
+def api_anim_bake_rate(width=64, height=64):
+    # On-rate times (looked up in the tables), off-rate times and times outside
+    # of the key frames range (both evaluated live)
+    on_rate = [0.5, 0.75, 1.0, 1.5, 2.25, 2.5]
+    off_rate = [0.6, 1.1, 1.9, 2.45]
+    outside = [0, 0.25, 2.75, 4]
+    times = on_rate + off_rate + outside
+
+    live = _get_anim_bake_captures(width, height, (0, 0), times)
+    baked = _get_anim_bake_captures(width, height, (4, 1), times)
+    for t, live_capture, baked_capture in zip(times, live, baked):
+        assert live_capture == baked_capture, f"{t=}"
+
+
+def api_noise_evaluate_batch():
+    # Enough times to span several chunks of the batch evaluation
+    times = [i * 0.173 for i in range(150)]
+    for noise_cls in (ngl.NoiseFloat, ngl.NoiseVec2, ngl.NoiseVec3, ngl.NoiseVec4):
+        noise = noise_cls(frequency=1.7, octaves=5, seed=0x1234)
+        values = [noise.evaluate(t) for t in times]
+        if hasattr(values[0], "__iter__"):
+            values = [v for value in values for v in value]
+        assert list(noise.evaluate_batch(times)) == values
+
+
+def _get_keep_warm_prefetches(width, height, budget, branches_seq):
+    capture_buffer = bytearray(width * height * 4)
+    ctx = ngl.Context()
+    ret = ctx.configure(
+        ngl.Config(
+            offscreen=True,
+            width=width,
+            height=height,
+            backend=_backend,
+            capture_buffer=capture_buffer,
+            gpu_memory_budget=budget,
+        )
+    )
+    assert ret == 0
+
+    colors = [(1, 0, 0), (0, 1, 0), (0, 0, 1)]
+    branches = [ngl.DrawColor(color=color) for color in colors]
+    branches.append(ngl.DrawTexture(texture=ngl.Texture2D(width=64, height=64)))
+    select = ngl.UserSelect(branches=branches, keep_warm=True)
+    assert ctx.set_scene(ngl.Scene.from_params(select)) == 0
+
+    prefetches = []
+    for t, branch in enumerate(branches_seq):
+        assert select.set_branch(branch) == 0
+        assert ctx.draw(t) == 0
+        prefetches.append(ctx.get_stats()["nb_prefetches"])
+        if branch < len(colors):
+            pixel = tuple(capture_buffer[:3])
+            assert pixel == tuple(c * 0xFF for c in colors[branch])
+    return prefetches
+
+
+def _get_stripes_scene(colors):
+    children = []
+    for i, color in enumerate(colors):
+        x0, x1 = -1 + i * 0.5, -0.5 + i * 0.5
+        if color is None:
+            # Texture uploaded from a buffer
+            data = array.array("B", [0xFF, 0x00, 0xFF, 0xFF])
+            texture = ngl.Texture2D(width=1, height=1, data_src=ngl.BufferUBVec4(data=data))
+            quad = ngl.Quad((x0, -1, 0), (0.5, 0, 0), (0, 2, 0))
+            children.append(ngl.DrawTexture(texture=texture, geometry=quad))
+            continue
+        vertices = array.array("f", [x0, -1, 0, x1, -1, 0, x0, 1, 0, x1, 1, 0])
+        geometry = ngl.Geometry(vertices=ngl.BufferVec3(data=vertices), topology="triangle_strip")
+        children.append(ngl.DrawColor(color=color, geometry=geometry))
+    return ngl.Scene.from_params(ngl.Group(children=children))
+
+
+def api_transfers(width=16, height=16):
+    capture_buffer = bytearray(width * height * 4)
+    ctx = ngl.Context()
+    ret = ctx.configure(
+        ngl.Config(offscreen=True, width=width, height=height, backend=_backend, capture_buffer=capture_buffer)
+    )
+    assert ret == 0
+
+    def _get_stripes():
+        pos = height // 2 * width * 4
+        offsets = [pos + (width * (2 * i + 1) // 8) * 4 for i in range(4)]
+        return [tuple(capture_buffer[off : off + 4]) for off in offsets]
+
+    red = (0xFF, 0x00, 0x00, 0xFF)
+    green = (0x00, 0xFF, 0x00, 0xFF)
+    blue = (0x00, 0x00, 0xFF, 0xFF)
+    magenta = (0xFF, 0x00, 0xFF, 0xFF)
+
+    # The vertex buffers are uploaded when the scene is set, outside of any
+    # frame, and must be visible to the draw reading them right after
+    assert ctx.set_scene(_get_stripes_scene([(1, 0, 0), (0, 1, 0), (0, 0, 1), None])) == 0
+    assert ctx.draw(0) == 0
+    assert _get_stripes() == [red, green, blue, magenta]
+
+    # Same while the previous frame may still be in flight
+    assert ctx.set_scene(_get_stripes_scene([None, (0, 0, 1), (0, 1, 0), (1, 0, 0)])) == 0
+    assert ctx.draw(1) == 0
+    assert _get_stripes() == [magenta, blue, green, red]
+    assert ctx.set_scene(None) == 0
+
+
+def api_userselect_keep_warm(width=16, height=16):
+    branches_seq = [0, 0, 1, 3, 2, 0, 3, 1]
+
+    # All the branches are prefetched on the first frame and never again
+    for budget in (0, 1 << 40):
+        prefetches = _get_keep_warm_prefetches(width, height, budget, branches_seq)
+        assert prefetches[0] > 0
+        assert prefetches[1:] == [0] * (len(branches_seq) - 1)
+
+    # Past the budget, the branches not taken are not kept warm anymore
+    prefetches = _get_keep_warm_prefetches(width, height, 1, branches_seq)
+    assert any(prefetches[1:])
+
+
 def api_dot(width=320, height=240):
     """
     Exercise the ngl.dot() API.
@@ -668,6 +1431,43 @@ def api_viewport():
     assert ctx.viewport == (0, 0, 640, 480)
 
 
+def api_transform_live_in_static_chain(width=16, height=16):
+    capture_buffer = bytearray(width * height * 4)
+    ctx = ngl.Context()
+    ret = ctx.configure(
+        ngl.Config(offscreen=True, width=width, height=height, backend=_backend, capture_buffer=capture_buffer)
+    )
+    assert ret == 0
+
+    # Left half of the viewport, wrapped in a live transform between static ones
+    geometry = ngl.Quad(corner=(-1, -1, 0), width=(1, 0, 0), height=(0, 2, 0))
+    draw = ngl.DrawColor(color=(1, 1, 1), geometry=geometry)
+    live_vector = ngl.UniformVec3(value=(0, 0, 0), live_id="vector")
+    static_inner = ngl.Translate(draw, vector=(0, 0, 0))
+    live = ngl.Translate(static_inner, vector=live_vector)
+    static_outer = ngl.Scale(ngl.Translate(live, vector=(0, 0, 0)), factors=(1, 1, 1))
+    assert ctx.set_scene(ngl.Scene.from_params(static_outer)) == 0
+
+    def _get_halves():
+        row = height // 2 * width * 4
+        left = row + width // 4 * 4
+        right = row + width * 3 // 4 * 4
+        return capture_buffer[left], capture_buffer[right]
+
+    assert ctx.draw(0) == 0
+    assert _get_halves() == (0xFF, 0x00)
+
+    # The live transform must not be folded with its static neighbours
+    assert live_vector.set_value((1, 0, 0)) == 0
+    assert ctx.draw(1) == 0
+    assert _get_halves() == (0x00, 0xFF)
+
+    # A live change on a static member must refresh the collapsed matrix
+    assert static_inner.set_vector((-1, 0, 0)) == 0
+    assert ctx.draw(2) == 0
+    assert _get_halves() == (0xFF, 0x00)
+
+
 def api_transform_chain_check():
     invalid_chain = ngl.Translate(ngl.Rotate(ngl.Skew()))
     root = ngl.Camera(eye_transform=invalid_chain)